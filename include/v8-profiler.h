@@ -504,7 +504,8 @@ class V8_EXPORT OutputStream {  // NOLINT
 class V8_EXPORT HeapSnapshot {
  public:
   enum SerializationFormat {
-    kJSON = 0  // See format description near 'Serialize' method.
+    kJSON = 0,   // See format description near 'Serialize' method.
+    kBinary = 1  // See format description near 'Serialize' method.
   };
 
   /** Returns the root node of the heap graph. */
@@ -554,6 +555,16 @@ class V8_EXPORT HeapSnapshot {
    *
    * Nodes reference strings, other nodes, and edges by their indexes
    * in corresponding arrays.
+   *
+   * The binary format carries the same data in a more compact form and is
+   * written through WriteAsciiChunk as raw bytes, so the stream must not
+   * interpret the chunks as text. It starts with the magic bytes "V8HS"
+   * followed by the format version. Except for the string contents, all
+   * numbers are unsigned LEB128 varints and strings are deduplicated in a
+   * single table at the end. Node and edge fields follow the order of the
+   * JSON meta-info, but edges and locations refer to nodes by their ordinal
+   * instead of their offset in the nodes array. tools/heap-snapshot-to-json.py
+   * converts a binary snapshot back into the JSON format.
    */
   void Serialize(OutputStream* stream,
                  SerializationFormat format = kJSON) const;
@@ -6993,6 +6993,46 @@ class V8_EXPORT ResourceConstraints {
     initial_young_generation_size_ = initial_size;
   }
 
+  /**
+   * The combined old generation size of all isolates in the process that
+   * should not be exceeded. Isolates that set this cap share the memory that
+   * is still available under it: the old generation limit of each isolate
+   * only grows by its share of the remaining memory, which triggers garbage
+   * collections earlier as the process approaches the cap. If isolates set
+   * different caps, the smallest one is used. Zero disables the cap.
+   */
+  size_t process_heap_size_cap_in_bytes() const {
+    return process_heap_size_cap_;
+  }
+  void set_process_heap_size_cap_in_bytes(size_t cap) {
+    process_heap_size_cap_ = cap;
+  }
+
+  /**
+   * The target duration of a single garbage collection pause. When set, V8
+   * only grows the young generation and the old generation limit as far as
+   * the pauses of the next garbage collections are expected to stay within
+   * the target, based on the measured collection speeds. Zero disables the
+   * target.
+   */
+  double target_gc_pause_in_ms() const { return target_gc_pause_in_ms_; }
+  void set_target_gc_pause_in_ms(double target) {
+    target_gc_pause_in_ms_ = target;
+  }
+
+  /**
+   * The time budget for evacuating old generation pages in the atomic pause
+   * of a full garbage collection. Pages that are selected for compaction but
+   * are not expected to be evacuated within the budget stay in place and are
+   * swept instead. Zero disables the budget.
+   */
+  double evacuation_pause_budget_in_ms() const {
+    return evacuation_pause_budget_in_ms_;
+  }
+  void set_evacuation_pause_budget_in_ms(double budget) {
+    evacuation_pause_budget_in_ms_ = budget;
+  }
+
   /**
    * Deprecated functions. Do not use in new code.
    */
@@ -7025,9 +7065,55 @@ class V8_EXPORT ResourceConstraints {
   size_t max_zone_pool_size_ = 0;
   size_t initial_old_generation_size_ = 0;
   size_t initial_young_generation_size_ = 0;
+  size_t process_heap_size_cap_ = 0;
+  double target_gc_pause_in_ms_ = 0;
+  double evacuation_pause_budget_in_ms_ = 0;
   uint32_t* stack_limit_ = nullptr;
 };
 
+/**
+ * A memory budget that is shared by a group of isolates in the same process.
+ * Isolates join the budget through Isolate::CreateParams::heap_budget. The
+ * old generation limit of each isolate only grows by its share of the memory
+ * that is left in the budget. When the isolates together approach the
+ * budget, V8 starts a garbage collection in the isolate that is expected to
+ * free the most memory.
+ *
+ * The budget must outlive all isolates that use it. All methods may be
+ * called from any thread.
+ */
+class V8_EXPORT HeapBudget {
+ public:
+  /**
+   * Creates a budget for the combined old generation size of its isolates.
+   */
+  static std::unique_ptr<HeapBudget> New(size_t budget_in_bytes);
+
+  virtual ~HeapBudget() = default;
+
+  /**
+   * The budget in bytes.
+   */
+  virtual size_t budget_in_bytes() const = 0;
+
+  /**
+   * The combined old generation size of all isolates that use the budget.
+   * Isolates report their size whenever their old generation grows and after
+   * every garbage collection, so this is cheap to query but may lag behind
+   * the actual size slightly.
+   */
+  virtual size_t used_bytes() const = 0;
+
+  /**
+   * The last reported old generation size of |isolate|, which must use this
+   * budget.
+   */
+  virtual size_t used_bytes(Isolate* isolate) const = 0;
+
+ protected:
+  HeapBudget() = default;
+};
+
 
 // --- Exceptions ---
 
@@ -7988,6 +8074,7 @@ class V8_EXPORT Isolate {
           add_histogram_sample_callback(nullptr),
           array_buffer_allocator(nullptr),
           array_buffer_allocator_shared(),
+          heap_budget(nullptr),
           external_references(nullptr),
           allow_atomics_wait(true),
           only_terminate_in_safe_scope(false) {}
@@ -8036,6 +8123,13 @@ class V8_EXPORT Isolate {
     ArrayBuffer::Allocator* array_buffer_allocator;
     std::shared_ptr<ArrayBuffer::Allocator> array_buffer_allocator_shared;
 
+    /**
+     * An optional memory budget that the isolate shares with other isolates
+     * of the process. The budget must outlive the isolate. If set, it takes
+     * precedence over ResourceConstraints::process_heap_size_cap_in_bytes.
+     */
+    HeapBudget* heap_budget;
+
     /**
      * Specifies an optional nullptr-terminated array of raw addresses in the
      * embedder that V8 can match against during serialization and use for
@@ -8987,6 +9081,13 @@ class V8_EXPORT Isolate {
    */
   void SetRAILMode(RAILMode rail_mode);
 
+  /**
+   * Sets the time budget for evacuating old generation pages in the atomic
+   * pause of a full garbage collection, overriding the budget passed in the
+   * ResourceConstraints. Zero disables the budget.
+   */
+  void SetEvacuationPauseBudget(double budget_in_ms);
+
   /**
    * Optional notification to tell V8 the current isolate is used for debugging
    * and requires higher heap limit.
@@ -39,6 +39,7 @@
 #include "src/deoptimizer/deoptimizer.h"
 #include "src/diagnostics/gdb-jit.h"
 #include "src/execution/execution.h"
+#include "src/execution/feedback-profile.h"
 #include "src/execution/frames-inl.h"
 #include "src/execution/isolate-inl.h"
 #include "src/execution/messages.h"
@@ -49,6 +50,7 @@
 #include "src/execution/vm-state-inl.h"
 #include "src/handles/global-handles.h"
 #include "src/heap/embedder-tracing.h"
+#include "src/heap/heap-budget.h"
 #include "src/heap/heap-inl.h"
 #include "src/init/bootstrapper.h"
 #include "src/init/icu_util.h"
@@ -7312,6 +7314,10 @@ v8::ArrayBuffer::Allocator* v8::ArrayBuffer::Allocator::NewDefaultAllocator() {
   return new ArrayBufferAllocator();
 }
 
+std::unique_ptr<v8::HeapBudget> v8::HeapBudget::New(size_t budget_in_bytes) {
+  return std::make_unique<i::HeapBudget>(budget_in_bytes);
+}
+
 bool v8::ArrayBuffer::IsExternal() const {
   return Utils::OpenHandle(this)->is_external();
 }
@@ -8288,6 +8294,10 @@ void Isolate::Initialize(Isolate* isolate,
   i_isolate->set_api_external_references(params.external_references);
   i_isolate->set_allow_atomics_wait(params.allow_atomics_wait);
 
+  if (params.heap_budget != nullptr) {
+    i_isolate->heap()->set_heap_budget(
+        i::HeapBudget::From(params.heap_budget));
+  }
   i_isolate->heap()->ConfigureHeap(params.constraints);
   if (params.constraints.stack_limit() != nullptr) {
     uintptr_t limit =
@@ -8845,6 +8855,11 @@ void Isolate::SetRAILMode(RAILMode rail_mode) {
   return isolate->SetRAILMode(rail_mode);
 }
 
+void Isolate::SetEvacuationPauseBudget(double budget_in_ms) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->set_evacuation_pause_budget_ms(budget_in_ms);
+}
+
 void Isolate::IncreaseHeapLimitForDebugging() {
   // No-op.
 }
@@ -10083,6 +10098,22 @@ void debug::TypeProfile::SelectMode(Isolate* isolate,
 
 size_t debug::TypeProfile::ScriptCount() const { return type_profile_->size(); }
 
+std::vector<uint8_t> debug::CollectFeedbackProfile(Isolate* v8_isolate) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  ENTER_V8_NO_SCRIPT_NO_EXCEPTION(isolate);
+  return i::FeedbackProfile::Collect(isolate);
+}
+
+bool debug::SetFeedbackProfile(Isolate* v8_isolate, const uint8_t* data,
+                               size_t size) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  std::unique_ptr<i::FeedbackProfile> profile =
+      i::FeedbackProfile::Parse(data, size);
+  if (!profile) return false;
+  isolate->set_feedback_profile(std::move(profile));
+  return true;
+}
+
 debug::TypeProfile::ScriptData debug::TypeProfile::GetScriptData(
     size_t i) const {
   return ScriptData(i, type_profile_);
@@ -10521,10 +10552,16 @@ SnapshotObjectId HeapSnapshot::GetMaxSnapshotJSObjectId() const {
 
 void HeapSnapshot::Serialize(OutputStream* stream,
                              HeapSnapshot::SerializationFormat format) const {
-  Utils::ApiCheck(format == kJSON, "v8::HeapSnapshot::Serialize",
+  Utils::ApiCheck(format == kJSON || format == kBinary,
+                  "v8::HeapSnapshot::Serialize",
                   "Unknown serialization format");
   Utils::ApiCheck(stream->GetChunkSize() > 0, "v8::HeapSnapshot::Serialize",
                   "Invalid stream chunk size");
+  if (format == kBinary) {
+    i::HeapSnapshotBinarySerializer serializer(ToInternal(this));
+    serializer.Serialize(stream);
+    return;
+  }
   i::HeapSnapshotJSONSerializer serializer(ToInternal(this));
   serializer.Serialize(stream);
 }
@@ -31,12 +31,20 @@ void* BoundedPageAllocator::AllocatePages(void* hint, size_t size,
   MutexGuard guard(&mutex_);
   CHECK(IsAligned(alignment, region_allocator_.page_size()));
 
-  // Region allocator does not support alignments bigger than it's own
-  // allocation alignment.
-  CHECK_LE(alignment, allocate_page_size_);
-
-  // TODO(ishell): Consider using randomized version here.
-  Address address = region_allocator_.AllocateRegion(size);
+  Address address =
+      honor_address_hints_ ? reinterpret_cast<Address>(hint) : 0;
+  // Honor the hint if the requested pages are still free, so that callers
+  // can place related allocations next to each other.
+  if (address == 0 || !IsAligned(address, alignment) ||
+      !region_allocator_.contains(address, size) ||
+      !region_allocator_.AllocateRegionAt(address, size)) {
+    if (alignment <= allocate_page_size_) {
+      // TODO(ishell): Consider using randomized version here.
+      address = region_allocator_.AllocateRegion(size);
+    } else {
+      address = region_allocator_.AllocateAlignedRegion(size, alignment);
+    }
+  }
   if (address == RegionAllocator::kAllocationFailure) {
     return nullptr;
   }
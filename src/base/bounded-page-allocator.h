@@ -53,9 +53,14 @@ class V8_BASE_EXPORT BoundedPageAllocator : public v8::PageAllocator {
     return page_allocator_->GetRandomMmapAddr();
   }
 
+  // Address hints are ignored unless set_honor_address_hints(true) was
+  // called, in which case a hint is used if the requested pages are free.
   void* AllocatePages(void* hint, size_t size, size_t alignment,
                       Permission access) override;
 
+  // Must be called before the first allocation.
+  void set_honor_address_hints(bool value) { honor_address_hints_ = value; }
+
   // Allocates pages at given address, returns true on success.
   bool AllocatePagesAt(Address address, size_t size, Permission access);
 
@@ -73,6 +78,7 @@ class V8_BASE_EXPORT BoundedPageAllocator : public v8::PageAllocator {
   const size_t commit_page_size_;
   v8::PageAllocator* const page_allocator_;
   v8::base::RegionAllocator region_allocator_;
+  bool honor_address_hints_ = false;
 
   DISALLOW_COPY_AND_ASSIGN(BoundedPageAllocator);
 };
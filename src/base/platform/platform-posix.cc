@@ -569,6 +569,46 @@ int OS::GetCurrentThreadId() {
 #endif
 }
 
+int OS::GetCurrentNumaNode() {
+#if V8_OS_LINUX && defined(__NR_getcpu)
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (syscall(__NR_getcpu, &cpu, &node, nullptr) == 0) {
+    return static_cast<int>(node);
+  }
+#endif
+  return kNoNumaNode;
+}
+
+bool OS::SetNumaPreferredNode(void* address, size_t size, int node) {
+#if V8_OS_LINUX && defined(__NR_mbind)
+  // Invoke the system call directly to avoid a dependency on libnuma.
+  using NodeMask = unsigned long;  // NOLINT(runtime/int)
+  const int kMpolPreferred = 1;
+  // The kernel only considers the first |max_node - 1| bits of the mask.
+  const int kMaxNode = static_cast<int>(sizeof(NodeMask) * CHAR_BIT);
+  if (node < 0 || node >= kMaxNode - 1) return false;
+  NodeMask node_mask = NodeMask{1} << node;
+  return syscall(__NR_mbind, address, size, kMpolPreferred, &node_mask,
+                 kMaxNode, 0) == 0;
+#else
+  USE(address);
+  USE(size);
+  USE(node);
+  return false;
+#endif
+}
+
+bool OS::AdviseHugePages(void* address, size_t size) {
+#if V8_OS_LINUX && defined(MADV_HUGEPAGE)
+  return madvise(address, size, MADV_HUGEPAGE) == 0;
+#else
+  USE(address);
+  USE(size);
+  return false;
+#endif
+}
+
 void OS::ExitProcess(int exit_code) {
   // Use _exit instead of exit to avoid races between isolate
   // threads and static destructors.
@@ -501,6 +501,27 @@ int OS::GetCurrentThreadId() {
   return static_cast<int>(::GetCurrentThreadId());
 }
 
+int OS::GetCurrentNumaNode() {
+  UCHAR node = 0;
+  if (!::GetNumaProcessorNode(static_cast<UCHAR>(::GetCurrentProcessorNumber()),
+                              &node)) {
+    return kNoNumaNode;
+  }
+  return static_cast<int>(node);
+}
+
+bool OS::SetNumaPreferredNode(void* address, size_t size, int node) {
+  // Windows only supports choosing the node when reserving memory through
+  // VirtualAllocExNuma.
+  return false;
+}
+
+bool OS::AdviseHugePages(void* address, size_t size) {
+  // Large pages on Windows have to be requested when committing memory and
+  // need the SeLockMemoryPrivilege.
+  return false;
+}
+
 void OS::ExitProcess(int exit_code) {
   // Use TerminateProcess avoid races between isolate threads and
   // static destructors.
@@ -248,6 +248,30 @@ class V8_BASE_EXPORT OS {
 
   static int GetCurrentThreadId();
 
+  // Returned by GetCurrentNumaNode() if the node cannot be determined.
+  static const int kNoNumaNode = -1;
+
+  // Returns the NUMA node of the CPU the calling thread currently runs on.
+  static int GetCurrentNumaNode();
+
+  // Sets the preferred NUMA node for the pages in the given region. Pages
+  // that are not backed by physical memory yet are placed on |node| when they
+  // are first touched. Returns false if the platform does not support memory
+  // policies.
+  V8_WARN_UNUSED_RESULT static bool SetNumaPreferredNode(void* address,
+                                                         size_t size,
+                                                         int node);
+
+  // Size of a transparent huge page on the platforms that support them.
+  static const size_t kHugePageSize = 2 * 1024 * 1024;
+
+  // Advises the kernel to back the given region with transparent huge pages.
+  // Only memory within kHugePageSize-aligned blocks that are fully covered by
+  // such regions can be collapsed into huge pages. Returns false if the
+  // platform does not support transparent huge pages.
+  V8_WARN_UNUSED_RESULT static bool AdviseHugePages(void* address,
+                                                    size_t size);
+
   static void AdjustSchedulingParams();
 
   static void ExitProcess(int exit_code);
@@ -155,6 +155,28 @@ RegionAllocator::Address RegionAllocator::AllocateRegion(
   return AllocateRegion(size);
 }
 
+RegionAllocator::Address RegionAllocator::AllocateAlignedRegion(
+    size_t size, size_t alignment) {
+  DCHECK_NE(size, 0);
+  DCHECK(IsAligned(size, page_size_));
+  DCHECK(bits::IsPowerOfTwo(alignment));
+  DCHECK(IsAligned(alignment, page_size_));
+
+  // Free regions are ordered by size, so the first region that can hold an
+  // aligned block of |size| is also the smallest one.
+  Region key(0, size, false);
+  for (auto iter = free_regions_.lower_bound(&key);
+       iter != free_regions_.end(); ++iter) {
+    Region* region = *iter;
+    Address address = RoundUp(region->begin(), alignment);
+    if (address < region->begin() || address + size > region->end()) continue;
+    // AllocateRegionAt() invalidates the iterator, so return right away.
+    CHECK(AllocateRegionAt(address, size));
+    return address;
+  }
+  return kAllocationFailure;
+}
+
 bool RegionAllocator::AllocateRegionAt(Address requested_address, size_t size) {
   DCHECK(IsAligned(requested_address, page_size_));
   DCHECK_NE(size, 0);
@@ -38,6 +38,11 @@ class V8_BASE_EXPORT RegionAllocator final {
   // Same as above but tries to randomize the region displacement.
   Address AllocateRegion(RandomNumberGenerator* rng, size_t size);
 
+  // Allocates region of |size| whose address is aligned to |alignment|, which
+  // must be a power of two and a multiple of |page_size|. Returns the address
+  // of the region on success or kAllocationFailure.
+  Address AllocateAlignedRegion(size_t size, size_t alignment);
+
   // Allocates region of |size| at |requested_address| if it's free. Both the
   // address and the size must be |page_size|-aligned. On success returns
   // true.
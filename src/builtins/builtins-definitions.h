@@ -903,6 +903,7 @@ namespace internal {
   TFC(WasmTableSet, WasmTableSet)                                              \
   TFC(WasmStackGuard, NoContext)                                               \
   TFC(WasmStackOverflow, NoContext)                                            \
+  TFC(WasmTriggerTierUp, NoContext)                                            \
   TFC(WasmThrow, WasmThrow)                                                    \
   TFC(WasmRethrow, WasmThrow)                                                  \
   TFS(WasmTraceMemory, kMemoryTracingInfo)                                     \
@@ -1226,6 +1227,7 @@ namespace internal {
   V(WasmTableSet)                        \
   V(WasmStackGuard)                      \
   V(WasmStackOverflow)                   \
+  V(WasmTriggerTierUp)                   \
   V(WasmThrow)                           \
   V(WasmRethrow)                         \
   V(WasmTraceMemory)                     \
@@ -47,6 +47,12 @@ TF_BUILTIN(WasmStackOverflow, WasmBuiltinsAssembler) {
   TailCallRuntime(Runtime::kThrowWasmStackOverflow, context);
 }
 
+TF_BUILTIN(WasmTriggerTierUp, WasmBuiltinsAssembler) {
+  TNode<Object> instance = LoadInstanceFromFrame();
+  TNode<Object> context = LoadContextFromInstance(instance);
+  TailCallRuntime(Runtime::kWasmTriggerTierUp, context);
+}
+
 TF_BUILTIN(WasmThrow, WasmBuiltinsAssembler) {
   TNode<Object> exception = UncheckedParameter(Descriptor::kException);
   TNode<Object> instance = LoadInstanceFromFrame();
@@ -226,12 +226,13 @@ CompilationJob::Status OptimizedCompilationJob::PrepareJob(Isolate* isolate) {
 }
 
 CompilationJob::Status OptimizedCompilationJob::ExecuteJob(
-    RuntimeCallStats* stats) {
+    RuntimeCallStats* stats, LocalHeap* local_heap) {
   DisallowHeapAccess no_heap_access;
   // Delegate to the underlying implementation.
   DCHECK_EQ(state(), State::kReadyToExecute);
   ScopedTimer t(&time_taken_to_execute_);
-  return UpdateState(ExecuteJobImpl(stats), State::kReadyToFinalize);
+  return UpdateState(ExecuteJobImpl(stats, local_heap),
+                     State::kReadyToFinalize);
 }
 
 CompilationJob::Status OptimizedCompilationJob::FinalizeJob(Isolate* isolate) {
@@ -710,6 +711,16 @@ void InsertCodeIntoOptimizedCodeCache(
   Handle<Code> code = compilation_info->code();
   if (code->kind() != Code::OPTIMIZED_FUNCTION) return;  // Nothing to do.
 
+  // Remember which tier the function reached, independent of whether the code
+  // itself ends up in the cache below.
+  compilation_info->closure()->feedback_vector().set_optimization_tier(
+      compilation_info->is_turboprop() ? OptimizationTier::kMidTier
+                                       : OptimizationTier::kTopTier);
+  if (!compilation_info->is_turboprop()) {
+    compilation_info->shared_info()->GetBytecodeArray().set_was_optimized(
+        true);
+  }
+
   // Function context specialization folds-in the function context,
   // so no sharing can occur.
   if (compilation_info->is_function_context_specializing()) {
@@ -865,6 +876,16 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
 
   compilation_info->SetOptimizingForOsr(osr_offset, osr_frame);
 
+  // With the mid tier enabled, a function's first optimized compile goes
+  // through Turboprop and it only tiers up to TurboFan once the mid-tier code
+  // gets hot. OSR always targets TurboFan, since the mid tier is meant to be
+  // cheap to produce for many functions rather than to speed up a single loop.
+  if (FLAG_turboprop_mid_tier && osr_offset.IsNone() &&
+      function->feedback_vector().optimization_tier() ==
+          OptimizationTier::kNone) {
+    compilation_info->MarkAsTurboprop();
+  }
+
   // Do not use TurboFan if we need to be able to set break points.
   if (compilation_info->shared_info()->HasBreakInfo()) {
     compilation_info->AbortOptimization(BailoutReason::kFunctionBeingDebugged);
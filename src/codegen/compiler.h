@@ -24,6 +24,7 @@ class AstRawString;
 class BackgroundCompileTask;
 class IsCompiledScope;
 class JavaScriptFrame;
+class LocalHeap;
 class OptimizedCompilationInfo;
 class OptimizedCompilationJob;
 class ParseInfo;
@@ -305,8 +306,10 @@ class OptimizedCompilationJob : public CompilationJob {
   V8_WARN_UNUSED_RESULT Status PrepareJob(Isolate* isolate);
 
   // Executes the compile job. Can be called on a background thread if
-  // can_execute_on_background_thread() returns true.
-  V8_WARN_UNUSED_RESULT Status ExecuteJob(RuntimeCallStats* stats);
+  // can_execute_on_background_thread() returns true. A background thread
+  // passes its {local_heap}, which the job uses to access the heap directly.
+  V8_WARN_UNUSED_RESULT Status ExecuteJob(RuntimeCallStats* stats,
+                                          LocalHeap* local_heap = nullptr);
 
   // Finalizes the compile job. Must be called on the main thread.
   V8_WARN_UNUSED_RESULT Status FinalizeJob(Isolate* isolate);
@@ -331,7 +334,8 @@ class OptimizedCompilationJob : public CompilationJob {
  protected:
   // Overridden by the actual implementation.
   virtual Status PrepareJobImpl(Isolate* isolate) = 0;
-  virtual Status ExecuteJobImpl(RuntimeCallStats* stats) = 0;
+  virtual Status ExecuteJobImpl(RuntimeCallStats* stats,
+                                LocalHeap* local_heap) = 0;
   virtual Status FinalizeJobImpl(Isolate* isolate) = 0;
 
  private:
@@ -73,6 +73,9 @@ void OptimizedCompilationInfo::ConfigureFlags() {
         // TODO(yangguo): Disable this in case of debugging for crbug.com/826613
         MarkAsAnalyzeEnvironmentLiveness();
       }
+      if (FLAG_turboprop) {
+        MarkAsTurboprop();
+      }
       break;
     case Code::BYTECODE_HANDLER:
       SetFlag(kCalledWithCodeStartRegister);
@@ -64,7 +64,8 @@ class V8_EXPORT_PRIVATE OptimizedCompilationInfo final {
     kTraceHeapBroker = 1 << 17,
     kWasmRuntimeExceptionSupport = 1 << 18,
     kTurboControlFlowAwareAllocation = 1 << 19,
-    kTurboPreprocessRanges = 1 << 20
+    kTurboPreprocessRanges = 1 << 20,
+    kTurboprop = 1 << 21
   };
 
   // Construct a compilation info for optimized compilation.
@@ -105,6 +106,10 @@ class V8_EXPORT_PRIVATE OptimizedCompilationInfo final {
     return GetFlag(kTurboPreprocessRanges);
   }
 
+  // Code compiled with the Turboprop mid-tier pipeline.
+  void MarkAsTurboprop() { SetFlag(kTurboprop); }
+  bool is_turboprop() const { return GetFlag(kTurboprop); }
+
   void MarkAsFunctionContextSpecializing() {
     SetFlag(kFunctionContextSpecializing);
   }
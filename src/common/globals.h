@@ -1503,6 +1503,24 @@ inline std::ostream& operator<<(std::ostream& os,
   return os;
 }
 
+// The tiers an optimized compile can target. kMidTier code is produced by the
+// Turboprop pipeline and tiers up to kTopTier (TurboFan) once it gets hot.
+enum class OptimizationTier { kNone, kMidTier, kTopTier };
+
+inline std::ostream& operator<<(std::ostream& os,
+                                const OptimizationTier& tier) {
+  switch (tier) {
+    case OptimizationTier::kNone:
+      return os << "OptimizationTier::kNone";
+    case OptimizationTier::kMidTier:
+      return os << "OptimizationTier::kMidTier";
+    case OptimizationTier::kTopTier:
+      return os << "OptimizationTier::kTopTier";
+  }
+  UNREACHABLE();
+  return os;
+}
+
 enum class SpeculationMode { kAllowSpeculation, kDisallowSpeculation };
 
 inline std::ostream& operator<<(std::ostream& os,
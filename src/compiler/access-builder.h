@@ -83,6 +83,9 @@ class V8_EXPORT_PRIVATE AccessBuilder final
   // Provides access to JSFunction::feedback_cell() field.
   static FieldAccess ForJSFunctionFeedbackCell();
 
+  // Provides access to FeedbackCell::interrupt_budget() field.
+  static FieldAccess ForFeedbackCellInterruptBudget();
+
   // Provides access to JSFunction::code() field.
   static FieldAccess ForJSFunctionCode();
 
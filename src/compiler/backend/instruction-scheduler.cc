@@ -58,11 +58,12 @@ InstructionScheduler::StressSchedulerQueue::PopBestCandidate(int cycle) {
 }
 
 InstructionScheduler::ScheduleGraphNode::ScheduleGraphNode(Zone* zone,
-                                                           Instruction* instr)
+                                                           Instruction* instr,
+                                                           int latency)
     : instr_(instr),
       successors_(zone),
       unscheduled_predecessors_count_(0),
-      latency_(GetInstructionLatency(instr)),
+      latency_(latency),
       total_latency_(-1),
       start_cycle_(-1) {}
 
@@ -73,9 +74,11 @@ void InstructionScheduler::ScheduleGraphNode::AddSuccessor(
 }
 
 InstructionScheduler::InstructionScheduler(Zone* zone,
-                                           InstructionSequence* sequence)
+                                           InstructionSequence* sequence,
+                                           LatencyModel latency_model)
     : zone_(zone),
       sequence_(sequence),
+      latency_model_(latency_model),
       graph_(zone),
       last_side_effect_instr_(nullptr),
       pending_loads_(zone),
@@ -108,7 +111,8 @@ void InstructionScheduler::EndBlock(RpoNumber rpo) {
 }
 
 void InstructionScheduler::AddTerminator(Instruction* instr) {
-  ScheduleGraphNode* new_node = new (zone()) ScheduleGraphNode(zone(), instr);
+  ScheduleGraphNode* new_node = new (zone())
+      ScheduleGraphNode(zone(), instr, GetInstructionLatency(instr));
   // Make sure that basic block terminators are not moved by adding them
   // as successor of every instruction.
   for (ScheduleGraphNode* node : graph_) {
@@ -128,7 +132,8 @@ void InstructionScheduler::AddInstruction(Instruction* instr) {
     return;
   }
 
-  ScheduleGraphNode* new_node = new (zone()) ScheduleGraphNode(zone(), instr);
+  ScheduleGraphNode* new_node = new (zone())
+      ScheduleGraphNode(zone(), instr, GetInstructionLatency(instr));
 
   // We should not have branches in the middle of a block.
   DCHECK_NE(instr->flags_mode(), kFlags_branch);
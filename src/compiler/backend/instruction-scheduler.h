@@ -37,8 +37,14 @@ enum ArchOpcodeFlags {
 
 class InstructionScheduler final : public ZoneObject {
  public:
-  V8_EXPORT_PRIVATE InstructionScheduler(Zone* zone,
-                                         InstructionSequence* sequence);
+  // Which latency table to schedule against. Code that ends up in the
+  // snapshot (builtins, stubs) must not depend on the machine it was built
+  // on, so only code compiled at runtime uses the host's tuned latencies.
+  enum class LatencyModel { kGeneric, kHost };
+
+  V8_EXPORT_PRIVATE InstructionScheduler(
+      Zone* zone, InstructionSequence* sequence,
+      LatencyModel latency_model = LatencyModel::kGeneric);
 
   V8_EXPORT_PRIVATE void StartBlock(RpoNumber rpo);
   V8_EXPORT_PRIVATE void EndBlock(RpoNumber rpo);
@@ -53,7 +59,7 @@ class InstructionScheduler final : public ZoneObject {
   // Represent an instruction and their dependencies.
   class ScheduleGraphNode : public ZoneObject {
    public:
-    ScheduleGraphNode(Zone* zone, Instruction* instr);
+    ScheduleGraphNode(Zone* zone, Instruction* instr, int latency);
 
     // Mark the instruction represented by 'node' as a dependency of this one.
     // The current instruction will be registered as an unscheduled predecessor
@@ -204,16 +210,18 @@ class InstructionScheduler final : public ZoneObject {
 
   void ComputeTotalLatencies();
 
-  static int GetInstructionLatency(const Instruction* instr);
+  int GetInstructionLatency(const Instruction* instr) const;
 
   Zone* zone() { return zone_; }
   InstructionSequence* sequence() { return sequence_; }
+  LatencyModel latency_model() const { return latency_model_; }
   base::RandomNumberGenerator* random_number_generator() {
     return &random_number_generator_.value();
   }
 
   Zone* zone_;
   InstructionSequence* sequence_;
+  const LatencyModel latency_model_;
   ZoneVector<ScheduleGraphNode*> graph_;
 
   friend class InstructionSchedulerTester;
@@ -30,7 +30,8 @@ InstructionSelector::InstructionSelector(
     SourcePositionMode source_position_mode, Features features,
     EnableScheduling enable_scheduling,
     EnableRootsRelativeAddressing enable_roots_relative_addressing,
-    PoisoningMitigationLevel poisoning_level, EnableTraceTurboJson trace_turbo)
+    PoisoningMitigationLevel poisoning_level, EnableTraceTurboJson trace_turbo,
+    InstructionScheduler::LatencyModel latency_model)
     : zone_(zone),
       linkage_(linkage),
       sequence_(sequence),
@@ -58,6 +59,7 @@ InstructionSelector::InstructionSelector(
       instruction_selection_failed_(false),
       instr_origins_(sequence->zone()),
       trace_turbo_(trace_turbo),
+      latency_model_(latency_model),
       tick_counter_(tick_counter),
       max_unoptimized_frame_height_(max_unoptimized_frame_height) {
   DCHECK_EQ(*max_unoptimized_frame_height, 0);  // Caller-initialized.
@@ -95,7 +97,8 @@ bool InstructionSelector::SelectInstructions() {
 
   // Schedule the selected instructions.
   if (UseInstructionScheduling()) {
-    scheduler_ = new (zone()) InstructionScheduler(zone(), sequence());
+    scheduler_ = new (zone())
+        InstructionScheduler(zone(), sequence(), latency_model_);
   }
 
   for (auto const block : *blocks) {
@@ -281,7 +281,9 @@ class V8_EXPORT_PRIVATE InstructionSelector final {
           kDisableRootsRelativeAddressing,
       PoisoningMitigationLevel poisoning_level =
           PoisoningMitigationLevel::kDontPoison,
-      EnableTraceTurboJson trace_turbo = kDisableTraceTurboJson);
+      EnableTraceTurboJson trace_turbo = kDisableTraceTurboJson,
+      InstructionScheduler::LatencyModel latency_model =
+          InstructionScheduler::LatencyModel::kGeneric);
 
   // Visit code for the entire graph with the included schedule.
   bool SelectInstructions();
@@ -786,6 +788,7 @@ class V8_EXPORT_PRIVATE InstructionSelector final {
   bool instruction_selection_failed_;
   ZoneVector<std::pair<int, int>> instr_origins_;
   EnableTraceTurboJson trace_turbo_;
+  InstructionScheduler::LatencyModel latency_model_;
   TickCounter* const tick_counter_;
 
   // Store the maximal unoptimized frame height. Later used to apply an offset
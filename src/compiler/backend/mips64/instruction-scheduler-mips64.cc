@@ -1240,7 +1240,8 @@ int Word32AtomicCompareExchangeLatency(bool sign_extend, int size) {
          ScLatency(0) + BranchShortLatency() + 1;
 }
 
-int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
+int InstructionScheduler::GetInstructionLatency(
+    const Instruction* instr) const {
   // Basic latency modeling for MIPS64 instructions. They have been determined
   // in empirical way.
   switch (instr->arch_opcode()) {
@@ -1337,8 +1337,7 @@ void LinearScanAllocator::PrintRangeOverview(std::ostream& os) {
     PrintRangeRow(os, toplevel);
   }
   int rowcount = 0;
-  for (auto toplevel : data()->live_ranges()) {
-    if (!CanProcessRange(toplevel)) continue;
+  for (auto toplevel : data()->live_ranges_of_kind(mode())) {
     if (rowcount++ % 10 == 0) PrintBlockRow(os, code()->instruction_blocks());
     PrintRangeRow(os, toplevel);
   }
@@ -1481,6 +1480,8 @@ RegisterAllocationData::RegisterAllocationData(
       live_out_sets_(code->InstructionBlockCount(), nullptr, allocation_zone()),
       live_ranges_(code->VirtualRegisterCount() * 2, nullptr,
                    allocation_zone()),
+      general_live_ranges_(allocation_zone()),
+      fp_live_ranges_(allocation_zone()),
       fixed_live_ranges_(kNumberOfFixedRangesPerRegister *
                              this->config()->num_general_registers(),
                          nullptr, allocation_zone()),
@@ -1495,8 +1496,6 @@ RegisterAllocationData::RegisterAllocationData(
       assigned_double_registers_(nullptr),
       virtual_register_count_(code->VirtualRegisterCount()),
       preassigned_slot_ranges_(zone),
-      spill_state_(code->InstructionBlockCount(), ZoneVector<LiveRange*>(zone),
-                   zone),
       flags_(flags),
       tick_counter_(tick_counter) {
   if (!kSimpleFPAliasing) {
@@ -1553,6 +1552,19 @@ TopLevelLiveRange* RegisterAllocationData::NewLiveRange(
   return new (allocation_zone()) TopLevelLiveRange(index, rep);
 }
 
+void RegisterAllocationData::PartitionLiveRangesByKind() {
+  general_live_ranges_.clear();
+  fp_live_ranges_.clear();
+  for (TopLevelLiveRange* range : live_ranges()) {
+    if (range == nullptr || range->IsEmpty()) continue;
+    if (range->kind() == GENERAL_REGISTERS) {
+      general_live_ranges_.push_back(range);
+    } else {
+      fp_live_ranges_.push_back(range);
+    }
+  }
+}
+
 int RegisterAllocationData::GetNextLiveRangeId() {
   int vreg = virtual_register_count_++;
   if (vreg >= static_cast<int>(live_ranges().size())) {
@@ -1645,14 +1657,14 @@ bool RegisterAllocationData::RangesDefinedInDeferredStayInDeferred() {
 }
 
 SpillRange* RegisterAllocationData::AssignSpillRangeToLiveRange(
-    TopLevelLiveRange* range, SpillMode spill_mode) {
+    TopLevelLiveRange* range, SpillMode spill_mode, Zone* zone) {
   using SpillType = TopLevelLiveRange::SpillType;
   DCHECK(!range->HasSpillOperand());
 
   SpillRange* spill_range = range->GetAllocatedSpillRange();
   if (spill_range == nullptr) {
     DCHECK(!range->IsSplinter());
-    spill_range = new (allocation_zone()) SpillRange(range, allocation_zone());
+    spill_range = new (zone) SpillRange(range, zone);
   }
   if (spill_mode == SpillMode::kSpillDeferred &&
       (range->spill_type() != SpillType::kSpillRange)) {
@@ -2620,7 +2632,7 @@ void LiveRangeBuilder::BuildLiveRanges() {
                   TopLevelLiveRange::SlotUseKind::kDeferredSlotUse
               ? SpillMode::kSpillDeferred
               : SpillMode::kSpillAtDefinition;
-      data()->AssignSpillRangeToLiveRange(range, spill_mode);
+      data()->AssignSpillRangeToLiveRange(range, spill_mode, allocation_zone());
     }
     // TODO(bmeurer): This is a horrible hack to make sure that for constant
     // live ranges, every use requires the constant to be in a register.
@@ -2648,7 +2660,8 @@ void LiveRangeBuilder::BuildLiveRanges() {
     SpillRange* spill = range->HasSpillRange()
                             ? range->GetSpillRange()
                             : data()->AssignSpillRangeToLiveRange(
-                                  range, SpillMode::kSpillAtDefinition);
+                                  range, SpillMode::kSpillAtDefinition,
+                                  allocation_zone());
     spill->set_assigned_slot(slot_id);
   }
 #ifdef DEBUG
@@ -2844,7 +2857,8 @@ void LiveRangeBundle::MergeSpillRanges() {
 }
 
 RegisterAllocator::RegisterAllocator(RegisterAllocationData* data,
-                                     RegisterKind kind)
+                                     RegisterKind kind, Zone* allocation_zone,
+                                     TickCounter* tick_counter)
     : data_(data),
       mode_(kind),
       num_registers_(GetRegisterCount(data->config(), kind)),
@@ -2852,7 +2866,11 @@ RegisterAllocator::RegisterAllocator(RegisterAllocationData* data,
           GetAllocatableRegisterCount(data->config(), kind)),
       allocatable_register_codes_(
           GetAllocatableRegisterCodes(data->config(), kind)),
-      check_fp_aliasing_(false) {
+      check_fp_aliasing_(false),
+      allocation_zone_(allocation_zone),
+      tick_counter_(tick_counter),
+      spill_state_(data->code()->InstructionBlockCount(),
+                   ZoneVector<LiveRange*>(allocation_zone), allocation_zone) {
   if (!kSimpleFPAliasing && kind == FP_REGISTERS) {
     check_fp_aliasing_ = (data->code()->representation_mask() &
                           (kFloat32Bit | kSimd128Bit)) != 0;
@@ -2871,12 +2889,8 @@ LifetimePosition RegisterAllocator::GetSplitPositionForInstruction(
 }
 
 void RegisterAllocator::SplitAndSpillRangesDefinedByMemoryOperand() {
-  size_t initial_range_count = data()->live_ranges().size();
-  for (size_t i = 0; i < initial_range_count; ++i) {
-    CHECK_EQ(initial_range_count,
-             data()->live_ranges().size());  // TODO(neis): crbug.com/831822
-    TopLevelLiveRange* range = data()->live_ranges()[i];
-    if (!CanProcessRange(range)) continue;
+  for (TopLevelLiveRange* range : data()->live_ranges_of_kind(mode())) {
+    DCHECK(CanProcessRange(range));
     // Only assume defined by memory operand if we are guaranteed to spill it or
     // it has a spill operand.
     if (range->HasNoSpillType() ||
@@ -3006,8 +3020,7 @@ LifetimePosition RegisterAllocator::FindOptimalSpillingPos(
       // This will reduce number of memory moves on the back edge.
       LifetimePosition loop_start = LifetimePosition::GapFromInstructionIndex(
           loop_header->first_instruction_index());
-      auto& loop_header_state =
-          data()->GetSpillState(loop_header->rpo_number());
+      auto& loop_header_state = GetSpillState(loop_header->rpo_number());
       for (LiveRange* live_at_header : loop_header_state) {
         if (live_at_header->TopLevel() != range->TopLevel() ||
             !live_at_header->Covers(loop_start) || live_at_header->spilled()) {
@@ -3068,7 +3081,7 @@ void RegisterAllocator::Spill(LiveRange* range, SpillMode spill_mode) {
   TRACE("Starting spill type is %d\n", static_cast<int>(first->spill_type()));
   if (first->HasNoSpillType()) {
     TRACE("New spill range needed");
-    data()->AssignSpillRangeToLiveRange(first, spill_mode);
+    data()->AssignSpillRangeToLiveRange(first, spill_mode, allocation_zone());
   }
   // Upgrade the spillmode, in case this was only spilled in deferred code so
   // far.
@@ -3091,7 +3104,14 @@ const char* RegisterAllocator::RegisterName(int register_code) const {
 
 LinearScanAllocator::LinearScanAllocator(RegisterAllocationData* data,
                                          RegisterKind kind, Zone* local_zone)
-    : RegisterAllocator(data, kind),
+    : LinearScanAllocator(data, kind, local_zone, data->allocation_zone(),
+                          data->tick_counter()) {}
+
+LinearScanAllocator::LinearScanAllocator(RegisterAllocationData* data,
+                                         RegisterKind kind, Zone* local_zone,
+                                         Zone* allocation_zone,
+                                         TickCounter* tick_counter)
+    : RegisterAllocator(data, kind, allocation_zone, tick_counter),
       unhandled_live_ranges_(local_zone),
       active_live_ranges_(local_zone),
       inactive_live_ranges_(num_registers(), InactiveLiveRangeQueue(local_zone),
@@ -3345,8 +3365,8 @@ RpoNumber LinearScanAllocator::ChooseOneOfTwoPredecessorStates(
   // Compute vectors of ranges with imminent use for both sides.
   // As GetChildCovers is cached, it is cheaper to repeatedly
   // call is rather than compute a shared set first.
-  auto& left = data()->GetSpillState(current_block->predecessors()[0]);
-  auto& right = data()->GetSpillState(current_block->predecessors()[1]);
+  auto& left = GetSpillState(current_block->predecessors()[0]);
+  auto& right = GetSpillState(current_block->predecessors()[1]);
   SmallRangeVector left_used;
   for (const auto item : left) {
     LiveRange* at_next_block = item->TopLevel()->GetChildCovers(boundary);
@@ -3406,7 +3426,7 @@ void LinearScanAllocator::ComputeStateFromManyPredecessors(
     }
   };
   ZoneMap<TopLevelLiveRange*, Vote, TopLevelLiveRangeComparator> counts(
-      data()->allocation_zone());
+      allocation_zone());
   int deferred_blocks = 0;
   for (RpoNumber pred : current_block->predecessors()) {
     if (!ConsiderBlockForControlFlow(current_block, pred)) {
@@ -3414,7 +3434,7 @@ void LinearScanAllocator::ComputeStateFromManyPredecessors(
       deferred_blocks++;
       continue;
     }
-    const auto& pred_state = data()->GetSpillState(pred);
+    const auto& pred_state = GetSpillState(pred);
     for (LiveRange* range : pred_state) {
       // We might have spilled the register backwards, so the range we
       // stored might have lost its register. Ignore those.
@@ -3531,7 +3551,7 @@ void LinearScanAllocator::UpdateDeferredFixedRanges(SpillMode spill_mode,
               other->TopLevel()->vreg(),
               RegisterName(other->assigned_register()));
         LiveRange* split_off =
-            other->SplitAt(next_start, data()->allocation_zone());
+            other->SplitAt(next_start, allocation_zone());
         // Try to get the same register after the deferred block.
         split_off->set_controlflow_hint(other->assigned_register());
         DCHECK_NE(split_off, other);
@@ -3639,17 +3659,13 @@ void LinearScanAllocator::AllocateRegisters() {
   }
 
   SplitAndSpillRangesDefinedByMemoryOperand();
-  data()->ResetSpillState();
 
   if (data()->is_trace_alloc()) {
     PrintRangeOverview(std::cout);
   }
 
-  const size_t live_ranges_size = data()->live_ranges().size();
-  for (TopLevelLiveRange* range : data()->live_ranges()) {
-    CHECK_EQ(live_ranges_size,
-             data()->live_ranges().size());  // TODO(neis): crbug.com/831822
-    if (!CanProcessRange(range)) continue;
+  for (TopLevelLiveRange* range : data()->live_ranges_of_kind(mode())) {
+    DCHECK(CanProcessRange(range));
     for (LiveRange* to_add = range; to_add != nullptr;
          to_add = to_add->next()) {
       if (!to_add->spilled()) {
@@ -3709,7 +3725,7 @@ void LinearScanAllocator::AllocateRegisters() {
   while (!unhandled_live_ranges().empty() ||
          (data()->is_turbo_control_flow_aware_allocation() &&
           last_block < max_blocks)) {
-    data()->tick_counter()->DoTick();
+    tick_counter()->DoTick();
     LiveRange* current = unhandled_live_ranges().empty()
                              ? nullptr
                              : *unhandled_live_ranges().begin();
@@ -3738,7 +3754,7 @@ void LinearScanAllocator::AllocateRegisters() {
         // Store current spill state (as the state at end of block). For
         // simplicity, we store the active ranges, e.g., the live ranges that
         // are not spilled.
-        data()->RememberSpillState(last_block, active_live_ranges());
+        RememberSpillState(last_block, active_live_ranges());
 
         // Only reset the state if this was not a direct fallthrough. Otherwise
         // control flow resolution will get confused (it does not expect changes
@@ -3782,7 +3798,7 @@ void LinearScanAllocator::AllocateRegisters() {
           // allocation if they were not live at the predecessors.
           ForwardStateTo(next_block_boundary);
 
-          RangeWithRegisterSet to_be_live(data()->allocation_zone());
+          RangeWithRegisterSet to_be_live(allocation_zone());
 
           // If we end up deciding to use the state of the immediate
           // predecessor, it is better not to perform a change. It would lead to
@@ -3800,7 +3816,7 @@ void LinearScanAllocator::AllocateRegisters() {
             // boundary, there is nothing to do.
             bool is_noop = pred.IsNext(current_block->rpo_number());
             if (!is_noop) {
-              auto& spill_state = data()->GetSpillState(pred);
+              auto& spill_state = GetSpillState(pred);
               TRACE("Not a fallthrough. Adding %zu elements...\n",
                     spill_state.size());
               for (const auto range : spill_state) {
@@ -4020,7 +4036,7 @@ void LinearScanAllocator::ForwardStateTo(LifetimePosition position) {
   if (position >= next_inactive_ranges_change_) {
     next_inactive_ranges_change_ = LifetimePosition::MaxPosition();
     for (int reg = 0; reg < num_registers(); ++reg) {
-      ZoneVector<LiveRange*> reorder(data()->allocation_zone());
+      ZoneVector<LiveRange*> reorder(allocation_zone());
       for (auto it = inactive_live_ranges(reg).begin();
            it != inactive_live_ranges(reg).end();) {
         LiveRange* cur_inactive = *it;
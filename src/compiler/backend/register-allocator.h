@@ -253,6 +253,12 @@ class RegisterAllocationData final : public ZoneObject {
     return live_ranges_;
   }
   ZoneVector<TopLevelLiveRange*>& live_ranges() { return live_ranges_; }
+  // The non-empty live ranges of the given register kind, as collected by
+  // PartitionLiveRangesByKind.
+  const ZoneVector<TopLevelLiveRange*>& live_ranges_of_kind(
+      RegisterKind kind) const {
+    return kind == GENERAL_REGISTERS ? general_live_ranges_ : fp_live_ranges_;
+  }
   const ZoneVector<TopLevelLiveRange*>& fixed_live_ranges() const {
     return fixed_live_ranges_;
   }
@@ -299,8 +305,14 @@ class RegisterAllocationData final : public ZoneObject {
   TopLevelLiveRange* NewLiveRange(int index, MachineRepresentation rep);
   TopLevelLiveRange* NextLiveRange(MachineRepresentation rep);
 
+  // Collects the live ranges of each register kind once all of them have been
+  // built. The allocators only walk the ranges of their own kind, so that
+  // allocators for different kinds never read the state of ranges another
+  // thread is writing.
+  void PartitionLiveRangesByKind();
+
   SpillRange* AssignSpillRangeToLiveRange(TopLevelLiveRange* range,
-                                          SpillMode spill_mode);
+                                          SpillMode spill_mode, Zone* zone);
   SpillRange* CreateSpillRangeForLiveRange(TopLevelLiveRange* range);
 
   MoveOperands* AddGapMove(int index, Instruction::GapPosition position,
@@ -325,22 +337,6 @@ class RegisterAllocationData final : public ZoneObject {
     return preassigned_slot_ranges_;
   }
 
-  void RememberSpillState(RpoNumber block,
-                          const ZoneVector<LiveRange*>& state) {
-    spill_state_[block.ToSize()] = state;
-  }
-
-  ZoneVector<LiveRange*>& GetSpillState(RpoNumber block) {
-    auto& result = spill_state_[block.ToSize()];
-    return result;
-  }
-
-  void ResetSpillState() {
-    for (auto& state : spill_state_) {
-      state.clear();
-    }
-  }
-
   TickCounter* tick_counter() { return tick_counter_; }
 
  private:
@@ -355,6 +351,8 @@ class RegisterAllocationData final : public ZoneObject {
   ZoneVector<BitVector*> live_in_sets_;
   ZoneVector<BitVector*> live_out_sets_;
   ZoneVector<TopLevelLiveRange*> live_ranges_;
+  ZoneVector<TopLevelLiveRange*> general_live_ranges_;
+  ZoneVector<TopLevelLiveRange*> fp_live_ranges_;
   ZoneVector<TopLevelLiveRange*> fixed_live_ranges_;
   ZoneVector<TopLevelLiveRange*> fixed_float_live_ranges_;
   ZoneVector<TopLevelLiveRange*> fixed_double_live_ranges_;
@@ -367,7 +365,6 @@ class RegisterAllocationData final : public ZoneObject {
   BitVector* fixed_fp_register_use_;
   int virtual_register_count_;
   RangesWithPreassignedSlots preassigned_slot_ranges_;
-  ZoneVector<ZoneVector<LiveRange*>> spill_state_;
   RegisterAllocationFlags flags_;
   TickCounter* const tick_counter_;
 
@@ -1193,7 +1190,12 @@ class BundleBuilder final : public ZoneObject {
 
 class RegisterAllocator : public ZoneObject {
  public:
-  RegisterAllocator(RegisterAllocationData* data, RegisterKind kind);
+  // Live ranges created by splitting and spill ranges are allocated in
+  // {allocation_zone}. Allocators for different register kinds only share
+  // read-only state otherwise, so they may run on different threads as long
+  // as each of them uses its own zone and tick counter.
+  RegisterAllocator(RegisterAllocationData* data, RegisterKind kind,
+                    Zone* allocation_zone, TickCounter* tick_counter);
 
  protected:
   using SpillMode = RegisterAllocationData::SpillMode;
@@ -1212,7 +1214,18 @@ class RegisterAllocator : public ZoneObject {
   LifetimePosition GetSplitPositionForInstruction(const LiveRange* range,
                                                   int instruction_index);
 
-  Zone* allocation_zone() const { return data()->allocation_zone(); }
+  Zone* allocation_zone() const { return allocation_zone_; }
+  TickCounter* tick_counter() const { return tick_counter_; }
+
+  void RememberSpillState(RpoNumber block,
+                          const ZoneVector<LiveRange*>& state) {
+    spill_state_[block.ToSize()] = state;
+  }
+
+  ZoneVector<LiveRange*>& GetSpillState(RpoNumber block) {
+    auto& result = spill_state_[block.ToSize()];
+    return result;
+  }
 
   // Find the optimal split for ranges defined by a memory operand, e.g.
   // constants or function parameters passed on the stack.
@@ -1259,6 +1272,9 @@ class RegisterAllocator : public ZoneObject {
   int num_allocatable_registers_;
   const int* allocatable_register_codes_;
   bool check_fp_aliasing_;
+  Zone* const allocation_zone_;
+  TickCounter* const tick_counter_;
+  ZoneVector<ZoneVector<LiveRange*>> spill_state_;
 
  private:
   bool no_combining_;
@@ -1270,6 +1286,9 @@ class LinearScanAllocator final : public RegisterAllocator {
  public:
   LinearScanAllocator(RegisterAllocationData* data, RegisterKind kind,
                       Zone* local_zone);
+  LinearScanAllocator(RegisterAllocationData* data, RegisterKind kind,
+                      Zone* local_zone, Zone* allocation_zone,
+                      TickCounter* tick_counter);
 
   // Phase 4: compute register assignments.
   void AllocateRegisters();
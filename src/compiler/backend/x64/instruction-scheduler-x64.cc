@@ -4,6 +4,10 @@
 
 #include "src/compiler/backend/instruction-scheduler.h"
 
+#include <string.h>
+
+#include "src/base/cpu.h"
+
 namespace v8 {
 namespace internal {
 namespace compiler {
@@ -431,16 +435,173 @@ int InstructionScheduler::GetTargetInstructionFlags(
   UNREACHABLE();
 }
 
-int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
-  // Basic latency modeling for x64 instructions. They have been determined
-  // in an empirical way.
+namespace {
+
+// Latencies, in cycles, of the instructions whose cost differs noticeably
+// between x64 cores. Everything not listed here is assumed to complete in a
+// single cycle.
+struct X64LatencyModel {
+  int load;
+  int imul;
+  int fp_add;
+  int fp_mul;
+  int fp_convert;
+  int fp_to_int32;
+  int fp_to_int64;
+  int fp_round;
+  int float32_div;
+  int float64_div;
+  int float32_sqrt;
+  int float64_sqrt;
+  int idiv64;
+  int idiv32;
+  int udiv64;
+  int udiv32;
+};
+
+// Used for cores we do not know about. These are the values that have been
+// determined empirically before core specific models were added.
+const X64LatencyModel kGenericLatencyModel = {
+    1,   // load
+    3,   // imul
+    3,   // fp_add
+    5,   // fp_mul
+    4,   // fp_convert
+    4,   // fp_to_int32
+    10,  // fp_to_int64
+    4,   // fp_round
+    13,  // float32_div
+    13,  // float64_div
+    13,  // float32_sqrt
+    13,  // float64_sqrt
+    49,  // idiv64
+    35,  // idiv32
+    38,  // udiv64
+    26,  // udiv32
+};
+
+// Intel Core, from Skylake onwards. Values taken from Agner Fog's instruction
+// tables; divisions use the latency of typical, not worst case, operands.
+const X64LatencyModel kIntelCoreLatencyModel = {
+    5,   // load
+    3,   // imul
+    4,   // fp_add
+    4,   // fp_mul
+    5,   // fp_convert
+    6,   // fp_to_int32
+    6,   // fp_to_int64
+    8,   // fp_round
+    11,  // float32_div
+    14,  // float64_div
+    12,  // float32_sqrt
+    16,  // float64_sqrt
+    42,  // idiv64
+    26,  // idiv32
+    35,  // udiv64
+    26,  // udiv32
+};
+
+// AMD Zen and Zen 2.
+const X64LatencyModel kAMDZenLatencyModel = {
+    4,   // load
+    3,   // imul
+    3,   // fp_add
+    3,   // fp_mul
+    4,   // fp_convert
+    4,   // fp_to_int32
+    4,   // fp_to_int64
+    3,   // fp_round
+    10,  // float32_div
+    13,  // float64_div
+    14,  // float32_sqrt
+    20,  // float64_sqrt
+    45,  // idiv64
+    30,  // idiv32
+    45,  // udiv64
+    30,  // udiv32
+};
+
+const X64LatencyModel* DetectLatencyModel() {
+  base::CPU cpu;
+  if (strcmp(cpu.vendor(), "GenuineIntel") == 0 && cpu.family() == 0x6) {
+    // Only the Skylake-derived cores the table was tuned on; older and
+    // Atom-class family 6 parts keep the generic model.
+    switch (cpu.model()) {
+      case 0x4E:  // Skylake (mobile)
+      case 0x5E:  // Skylake (desktop)
+      case 0x55:  // Skylake-SP, Cascade Lake
+      case 0x8E:  // Kaby Lake, Coffee Lake, Whiskey Lake (mobile)
+      case 0x9E:  // Kaby Lake, Coffee Lake (desktop)
+      case 0xA5:  // Comet Lake
+      case 0xA6:  // Comet Lake (mobile)
+      case 0x66:  // Cannon Lake
+      case 0x7D:  // Ice Lake
+      case 0x7E:  // Ice Lake (mobile)
+      case 0x6A:  // Ice Lake-SP
+      case 0x6C:  // Ice Lake-D
+      case 0x8C:  // Tiger Lake (mobile)
+      case 0x8D:  // Tiger Lake
+        return &kIntelCoreLatencyModel;
+      default:
+        break;
+    }
+    return &kGenericLatencyModel;
+  }
+  // Zen and Zen 2 (family 17h).
+  if (strcmp(cpu.vendor(), "AuthenticAMD") == 0 && cpu.family() == 0xF &&
+      cpu.ext_family() == 0x8) {
+    return &kAMDZenLatencyModel;
+  }
+  return &kGenericLatencyModel;
+}
+
+const X64LatencyModel& GetLatencyModel() {
+  static const X64LatencyModel* model = DetectLatencyModel();
+  return *model;
+}
+
+bool IsMemoryLoad(const Instruction* instr) {
+  return instr->HasOutput() && instr->addressing_mode() != kMode_None;
+}
+
+}  // namespace
+
+int InstructionScheduler::GetInstructionLatency(
+    const Instruction* instr) const {
+  const X64LatencyModel& model = latency_model() == LatencyModel::kHost
+                                     ? GetLatencyModel()
+                                     : kGenericLatencyModel;
   switch (instr->arch_opcode()) {
+    case kX64Movl:
+    case kX64Movq:
+    case kX64Movsd:
+    case kX64Movss:
+    case kX64Movdqu:
+    case kX64Movsxbl:
+    case kX64Movzxbl:
+    case kX64Movsxbq:
+    case kX64Movzxbq:
+    case kX64Movsxwl:
+    case kX64Movzxwl:
+    case kX64Movsxwq:
+    case kX64Movzxwq:
+    case kX64Movsxlq:
+      return IsMemoryLoad(instr) ? model.load : 1;
+    case kX64MovqDecompressTaggedSigned:
+    case kX64MovqDecompressTaggedPointer:
+    case kX64MovqDecompressAnyTagged:
+      // Decompression adds the isolate root to the loaded value.
+      return model.load + 1;
+    case kX64Peek:
+      return model.load;
     case kSSEFloat64Mul:
-      return 5;
+    case kSSEFloat32Mul:
+      return model.fp_mul;
     case kX64Imul:
     case kX64Imul32:
     case kX64ImulHigh32:
     case kX64UmulHigh32:
+      return model.imul;
     case kSSEFloat32Cmp:
     case kSSEFloat32Add:
     case kSSEFloat32Sub:
@@ -453,35 +614,39 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kSSEFloat64Min:
     case kSSEFloat64Abs:
     case kSSEFloat64Neg:
-      return 3;
-    case kSSEFloat32Mul:
+      return model.fp_add;
     case kSSEFloat32ToFloat64:
     case kSSEFloat64ToFloat32:
+      return model.fp_convert;
     case kSSEFloat32Round:
     case kSSEFloat64Round:
+      return model.fp_round;
     case kSSEFloat32ToInt32:
     case kSSEFloat32ToUint32:
     case kSSEFloat64ToInt32:
     case kSSEFloat64ToUint32:
-      return 4;
+      return model.fp_to_int32;
     case kX64Idiv:
-      return 49;
+      return model.idiv64;
     case kX64Idiv32:
-      return 35;
+      return model.idiv32;
     case kX64Udiv:
-      return 38;
+      return model.udiv64;
     case kX64Udiv32:
-      return 26;
+      return model.udiv32;
     case kSSEFloat32Div:
+      return model.float32_div;
     case kSSEFloat64Div:
+      return model.float64_div;
     case kSSEFloat32Sqrt:
+      return model.float32_sqrt;
     case kSSEFloat64Sqrt:
-      return 13;
+      return model.float64_sqrt;
     case kSSEFloat32ToInt64:
     case kSSEFloat64ToInt64:
     case kSSEFloat32ToUint64:
     case kSSEFloat64ToUint64:
-      return 10;
+      return model.fp_to_int64;
     case kSSEFloat64Mod:
       return 50;
     case kArchTruncateDoubleToI:
@@ -297,6 +297,10 @@ class BytecodeGraphBuilder {
   // Helper for building a return (from an actual return or a suspend).
   void BuildReturn(const BytecodeLivenessState* liveness);
 
+  // Subtracts |weight| from the interrupt budget of the closure's feedback
+  // cell, calling into the runtime profiler once the budget is exhausted.
+  void BuildUpdateInterruptBudget(int weight);
+
   // Simulates entry and exit of exception handlers.
   void ExitThenEnterExceptionHandlers(int current_offset);
 
@@ -393,6 +397,8 @@ class BytecodeGraphBuilder {
   const bool skip_first_stack_check_;
   bool visited_first_stack_check_ = false;
 
+  const bool update_interrupt_budget_;
+
   // Merge environments are snapshots of the environment at points where the
   // control flow merges. This models a forward data flow propagation of all
   // values from all predecessors of the merge in question. They are indexed by
@@ -969,6 +975,8 @@ BytecodeGraphBuilder::BytecodeGraphBuilder(
       currently_peeled_loop_offset_(-1),
       skip_first_stack_check_(flags &
                               BytecodeGraphBuilderFlag::kSkipFirstStackCheck),
+      update_interrupt_budget_(
+          flags & BytecodeGraphBuilderFlag::kUpdateInterruptBudget),
       merge_environments_(local_zone),
       generator_merge_environments_(local_zone),
       exception_handlers_(local_zone),
@@ -3228,7 +3236,11 @@ void BytecodeGraphBuilder::VisitJumpIfUndefinedOrNullConstant() {
   BuildJumpIfEqual(jsgraph()->NullConstant());
 }
 
-void BytecodeGraphBuilder::VisitJumpLoop() { BuildJump(); }
+void BytecodeGraphBuilder::VisitJumpLoop() {
+  BuildUpdateInterruptBudget(bytecode_iterator().current_offset() -
+                             bytecode_iterator().GetJumpTargetOffset());
+  BuildJump();
+}
 
 void BytecodeGraphBuilder::BuildSwitchOnSmi(Node* condition) {
   interpreter::JumpTableTargetOffsets offsets =
@@ -3277,12 +3289,23 @@ void BytecodeGraphBuilder::VisitSetPendingMessage() {
 
 void BytecodeGraphBuilder::BuildReturn(const BytecodeLivenessState* liveness) {
   BuildLoopExitsForFunctionExit(liveness);
+  // Like Ignition, charge the whole function up to the return to the budget.
+  BuildUpdateInterruptBudget(bytecode_iterator().current_offset());
   Node* pop_node = jsgraph()->ZeroConstant();
   Node* control =
       NewNode(common()->Return(), pop_node, environment()->LookupAccumulator());
   MergeControlToLeaveFunction(control);
 }
 
+void BytecodeGraphBuilder::BuildUpdateInterruptBudget(int weight) {
+  if (!update_interrupt_budget_) return;
+  DCHECK_GE(weight, 0);
+  Node* feedback_cell = NewNode(
+      simplified()->LoadField(AccessBuilder::ForJSFunctionFeedbackCell()),
+      GetFunctionClosure());
+  NewNode(simplified()->UpdateInterruptBudget(-weight), feedback_cell);
+}
+
 void BytecodeGraphBuilder::VisitReturn() {
   BuildReturn(bytecode_analysis().GetInLivenessFor(
       bytecode_iterator().current_offset()));
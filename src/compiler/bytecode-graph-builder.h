@@ -33,6 +33,9 @@ enum class BytecodeGraphBuilderFlag : uint8_t {
   // bytecode analysis.
   kAnalyzeEnvironmentLiveness = 1 << 1,
   kBailoutOnUninitialized = 1 << 2,
+  // Decrement the interrupt budget on back edges and returns like Ignition
+  // does, so that the runtime profiler gets to see hot mid-tier code.
+  kUpdateInterruptBudget = 1 << 3,
 };
 using BytecodeGraphBuilderFlags = base::Flags<BytecodeGraphBuilderFlag>;
 
@@ -200,6 +200,7 @@ class EffectControlLinearizer {
   Node* LowerAssertType(Node* node);
   Node* LowerConvertReceiver(Node* node);
   Node* LowerDateNow(Node* node);
+  void LowerUpdateInterruptBudget(Node* node);
 
   // Lowering of optional operators.
   Maybe<Node*> LowerFloat64RoundUp(Node* node);
@@ -1294,6 +1295,9 @@ bool EffectControlLinearizer::TryWireInStateEffect(Node* node,
     case IrOpcode::kDateNow:
       result = LowerDateNow(node);
       break;
+    case IrOpcode::kUpdateInterruptBudget:
+      LowerUpdateInterruptBudget(node);
+      break;
     default:
       return false;
   }
@@ -5980,6 +5984,35 @@ Node* EffectControlLinearizer::LowerDateNow(Node* node) {
                  __ Int32Constant(0), __ NoContextConstant());
 }
 
+void EffectControlLinearizer::LowerUpdateInterruptBudget(Node* node) {
+  int delta = InterruptBudgetDeltaOf(node->op());
+  Node* feedback_cell = node->InputAt(0);
+
+  Node* budget = __ LoadField(AccessBuilder::ForFeedbackCellInterruptBudget(),
+                              feedback_cell);
+  Node* new_budget = __ Int32Add(budget, __ Int32Constant(delta));
+  __ StoreField(AccessBuilder::ForFeedbackCellInterruptBudget(), feedback_cell,
+                new_budget);
+  if (delta >= 0) return;
+
+  auto if_exhausted = __ MakeDeferredLabel();
+  auto done = __ MakeLabel();
+  __ Branch(__ Int32LessThan(new_budget, __ Int32Constant(0)), &if_exhausted,
+            &done);
+
+  __ Bind(&if_exhausted);
+  Operator::Properties properties = Operator::kNoDeopt | Operator::kNoThrow;
+  Runtime::FunctionId id = Runtime::kBytecodeBudgetInterruptFromCode;
+  auto call_descriptor = Linkage::GetRuntimeCallDescriptor(
+      graph()->zone(), id, 1, properties, CallDescriptor::kNoFlags);
+  __ Call(call_descriptor, __ CEntryStubConstant(1), feedback_cell,
+          __ ExternalConstant(ExternalReference::Create(id)),
+          __ Int32Constant(1), __ NoContextConstant());
+  __ Goto(&done);
+
+  __ Bind(&done);
+}
+
 #undef __
 
 void LinearizeEffectControl(JSGraph* graph, Schedule* schedule, Zone* temp_zone,
@@ -17,6 +17,8 @@
 #include "src/compiler/graph-reducer.h"
 #include "src/compiler/per-isolate-compiler-cache.h"
 #include "src/execution/protectors-inl.h"
+#include "src/handles/persistent-handles.h"
+#include "src/heap/local-heap.h"
 #include "src/init/bootstrapper.h"
 #include "src/objects/allocation-site-inl.h"
 #include "src/objects/api-callbacks.h"
@@ -60,7 +62,18 @@ HEAP_BROKER_OBJECT_LIST(FORWARD_DECL)
 //   data is an instance of the base class (ObjectData), i.e. it basically
 //   carries no information other than the handle.
 //
-enum ObjectDataKind { kSmi, kSerializedHeapObject, kUnserializedHeapObject };
+// kNeverSerializedHeapObject: The underlying V8 object is an immutable
+//   HeapObject and the data is an instance of ObjectData. The object is read
+//   directly through its handle, also from the background thread, in which
+//   case the handle is a persistent handle that the GC updates at a
+//   safepoint. Only used with --turbo-direct-heap-access.
+//
+enum ObjectDataKind {
+  kSmi,
+  kSerializedHeapObject,
+  kUnserializedHeapObject,
+  kNeverSerializedHeapObject
+};
 
 class ObjectData : public ZoneObject {
  public:
@@ -74,7 +87,11 @@ class ObjectData : public ZoneObject {
     TRACE(broker, "Creating data " << this << " for handle " << object.address()
                                    << " (" << Brief(*object) << ")");
 
-    CHECK_NOT_NULL(broker->isolate()->handle_scope_data()->canonical_scope);
+    // Handles created on the background thread are canonicalized by the
+    // broker itself, see JSHeapBroker::CanonicalPersistentHandle.
+    if (broker->local_heap() == nullptr) {
+      CHECK_NOT_NULL(broker->isolate()->handle_scope_data()->canonical_scope);
+    }
   }
 
 #define DECLARE_IS_AND_AS(Name) \
@@ -86,6 +103,10 @@ class ObjectData : public ZoneObject {
   Handle<Object> object() const { return object_; }
   ObjectDataKind kind() const { return kind_; }
   bool is_smi() const { return kind_ == kSmi; }
+  bool should_access_heap() const {
+    return kind_ == kUnserializedHeapObject ||
+           kind_ == kNeverSerializedHeapObject;
+  }
 
 #ifdef DEBUG
   enum class Usage{kUnused, kOnlyIdentityUsed, kDataUsed};
@@ -671,7 +692,7 @@ class NativeContextData : public ContextData {
     return function_maps_;
   }
 
-  ScopeInfoData* scope_info() const {
+  ObjectData* scope_info() const {
     CHECK(serialized_);
     return scope_info_;
   }
@@ -686,7 +707,7 @@ class NativeContextData : public ContextData {
   BROKER_NATIVE_CONTEXT_FIELDS(DECL_MEMBER)
 #undef DECL_MEMBER
   ZoneVector<MapData*> function_maps_;
-  ScopeInfoData* scope_info_ = nullptr;
+  ObjectData* scope_info_ = nullptr;
 };
 
 class NameData : public HeapObjectData {
@@ -1646,7 +1667,7 @@ class SharedFunctionInfoData : public HeapObjectData {
   int context_header_size() const { return context_header_size_; }
   BytecodeArrayData* GetBytecodeArray() const { return GetBytecodeArray_; }
   void SerializeFunctionTemplateInfo(JSHeapBroker* broker);
-  ScopeInfoData* scope_info() const { return scope_info_; }
+  ObjectData* scope_info() const { return scope_info_; }
   void SerializeScopeInfoChain(JSHeapBroker* broker);
   FunctionTemplateInfoData* function_template_info() const {
     return function_template_info_;
@@ -1677,7 +1698,7 @@ class SharedFunctionInfoData : public HeapObjectData {
 #undef DECL_MEMBER
   FunctionTemplateInfoData* function_template_info_;
   ZoneMap<int, JSArrayData*> template_objects_;
-  ScopeInfoData* scope_info_;
+  ObjectData* scope_info_;
 };
 
 SharedFunctionInfoData::SharedFunctionInfoData(
@@ -1717,12 +1738,10 @@ void SharedFunctionInfoData::SerializeFunctionTemplateInfo(
 
 void SharedFunctionInfoData::SerializeScopeInfoChain(JSHeapBroker* broker) {
   if (scope_info_) return;
-  scope_info_ =
-      broker
-          ->GetOrCreateData(
-              Handle<SharedFunctionInfo>::cast(object())->scope_info())
-          ->AsScopeInfo();
-  scope_info_->SerializeScopeInfoChain(broker);
+  scope_info_ = broker->GetOrCreateData(
+      Handle<SharedFunctionInfo>::cast(object())->scope_info());
+  if (scope_info_->should_access_heap()) return;
+  scope_info_->AsScopeInfo()->SerializeScopeInfoChain(broker);
 }
 
 class SourceTextModuleData : public HeapObjectData {
@@ -1913,7 +1932,7 @@ class CodeData : public HeapObjectData {
 
 #define DEFINE_IS_AND_AS(Name)                                            \
   bool ObjectData::Is##Name() const {                                     \
-    if (kind() == kUnserializedHeapObject) {                              \
+    if (should_access_heap()) {                                           \
       AllowHandleDereference allow_handle_dereference;                    \
       return object()->Is##Name();                                        \
     }                                                                     \
@@ -2218,7 +2237,7 @@ Isolate* ObjectRef::isolate() const { return broker()->isolate(); }
 ContextRef ContextRef::previous(size_t* depth,
                                 SerializationPolicy policy) const {
   DCHECK_NOT_NULL(depth);
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference handle_dereference;
     Context current = *object();
@@ -2234,7 +2253,7 @@ ContextRef ContextRef::previous(size_t* depth,
 
 base::Optional<ObjectRef> ContextRef::get(int index,
                                           SerializationPolicy policy) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference handle_dereference;
     Handle<Object> value(object()->get(index), broker()->isolate());
@@ -2261,7 +2280,8 @@ JSHeapBroker::JSHeapBroker(Isolate* isolate, Zone* broker_zone,
       bytecode_analyses_(zone()),
       property_access_infos_(zone()),
       typed_array_string_tags_(zone()),
-      serialized_functions_(zone()) {
+      serialized_functions_(zone()),
+      canonical_persistent_handles_(zone()) {
   // Note that this initialization of {refs_} with the minimal initial capacity
   // is redundant in the normal use case (concurrent compilation enabled,
   // standard objects to be serialized), as the map is going to be replaced
@@ -2270,6 +2290,8 @@ JSHeapBroker::JSHeapBroker(Isolate* isolate, Zone* broker_zone,
   TRACE(this, "Constructing heap broker");
 }
 
+JSHeapBroker::~JSHeapBroker() { DCHECK_NULL(local_heap_); }
+
 std::ostream& JSHeapBroker::Trace() const {
   return trace_out_ << "[" << this << "] "
                     << std::string(trace_indentation_ * 2, ' ');
@@ -2281,6 +2303,89 @@ void JSHeapBroker::StopSerializing() {
   mode_ = kSerialized;
 }
 
+bool JSHeapBroker::IsNeverSerializedHeapObject(Handle<Object> object) const {
+  if (!FLAG_turbo_direct_heap_access) return false;
+  AllowHandleDereference handle_dereference;
+  if (!object->IsHeapObject()) return false;
+  // These objects are immutable after creation, so reading them concurrently
+  // to the main thread is safe.
+  HeapObject heap_object = HeapObject::cast(*object);
+  return heap_object.IsScopeInfo() ||
+         heap_object.IsObjectBoilerplateDescription() ||
+         heap_object.IsArrayBoilerplateDescription() ||
+         heap_object.IsTemplateObjectDescription();
+}
+
+void JSHeapBroker::AttachLocalHeap(LocalHeap* local_heap) {
+  CHECK_NULL(local_heap_);
+  CHECK_EQ(mode_, kSerialized);
+  local_heap_ = local_heap;
+  // Seed the canonical handles with all handles the broker already knows
+  // about, so that objects reached directly from the heap map to the same
+  // ObjectData as their serialized counterparts.
+  AllowHandleDereference handle_dereference;
+  for (RefsMap::Entry* ref = refs_->Start(); ref != nullptr;
+       ref = refs_->Next(ref)) {
+    Address* location = reinterpret_cast<Address*>(ref->key);
+    canonical_persistent_handles_.insert({*location, location});
+  }
+}
+
+void JSHeapBroker::DetachLocalHeap() {
+  CHECK_NOT_NULL(local_heap_);
+  CHECK(!IsLocalHeapParked());
+  local_heap_ = nullptr;
+  canonical_persistent_handles_.clear();
+}
+
+Handle<Object> JSHeapBroker::CanonicalPersistentHandle(Object object) {
+  if (local_heap_ == nullptr) return handle(object, isolate());
+  auto find_result = canonical_persistent_handles_.find(object.ptr());
+  if (find_result != canonical_persistent_handles_.end()) {
+    return Handle<Object>(find_result->second);
+  }
+  if (!persistent_handles_) {
+    persistent_handles_.reset(new PersistentHandles(isolate()));
+  }
+  Handle<Object> handle = persistent_handles_->NewHandle(object);
+  canonical_persistent_handles_.insert({object.ptr(), handle.location()});
+  return handle;
+}
+
+void JSHeapBroker::Safepoint() {
+  if (local_heap_ == nullptr || IsLocalHeapParked()) return;
+  if (!local_heap_->Safepoint()) return;
+  // The GC may have moved objects while the thread was stopped.
+  RehashCanonicalPersistentHandles();
+}
+
+void JSHeapBroker::ParkLocalHeap() {
+  CHECK_NOT_NULL(local_heap_);
+  CHECK(!IsLocalHeapParked());
+  parked_scope_.reset(new ParkedScope(local_heap_));
+}
+
+void JSHeapBroker::UnparkLocalHeap() {
+  CHECK(IsLocalHeapParked());
+  parked_scope_.reset();
+  // The GC may have moved objects while the thread was parked.
+  RehashCanonicalPersistentHandles();
+}
+
+void JSHeapBroker::RehashCanonicalPersistentHandles() {
+  // The canonical handles are keyed by the objects' addresses.
+  AllowHandleDereference handle_dereference;
+  std::vector<Address*> locations;
+  locations.reserve(canonical_persistent_handles_.size());
+  for (auto& entry : canonical_persistent_handles_) {
+    locations.push_back(entry.second);
+  }
+  canonical_persistent_handles_.clear();
+  for (Address* location : locations) {
+    canonical_persistent_handles_.insert({*location, location});
+  }
+}
+
 #ifdef DEBUG
 void JSHeapBroker::PrintRefsAnalysis() const {
   // Usage counts
@@ -2667,7 +2772,9 @@ ObjectData* JSHeapBroker::GetData(Handle<Object> object) const {
 
 // clang-format off
 ObjectData* JSHeapBroker::GetOrCreateData(Handle<Object> object) {
-  CHECK(SerializingAllowed());
+  // Objects that are never serialized may also be added after serialization
+  // has stopped, e.g. when they are first encountered on the background thread.
+  CHECK(SerializingAllowed() || IsNeverSerializedHeapObject(object));
   RefsMap::Entry* entry = refs_->LookupOrInsert(object.address(), zone());
   ObjectData** data_storage = &(entry->value);
   if (*data_storage == nullptr) {
@@ -2676,6 +2783,9 @@ ObjectData* JSHeapBroker::GetOrCreateData(Handle<Object> object) {
     AllowHandleDereference handle_dereference;
     if (object->IsSmi()) {
       new (zone()) ObjectData(this, data_storage, object, kSmi);
+    } else if (IsNeverSerializedHeapObject(object)) {
+      new (zone())
+          ObjectData(this, data_storage, object, kNeverSerializedHeapObject);
 #define CREATE_DATA_IF_MATCH(name)                                             \
     } else if (object->Is##name()) {                                           \
       new (zone()) name##Data(this, data_storage, Handle<name>::cast(object));
@@ -2712,7 +2822,7 @@ int ObjectRef::AsSmi() const {
 }
 
 base::Optional<MapRef> JSObjectRef::GetObjectCreateMap() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference allow_handle_dereference;
     AllowHeapAllocation heap_allocation;
@@ -2737,7 +2847,7 @@ INSTANCE_TYPE_CHECKERS(DEF_TESTER)
 #undef DEF_TESTER
 
 base::Optional<MapRef> MapRef::AsElementsKind(ElementsKind kind) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHeapAllocation heap_allocation;
     AllowHandleDereference allow_handle_dereference;
@@ -2817,7 +2927,7 @@ bool MapRef::HasOnlyStablePrototypesWithFastElements(
 }
 
 bool MapRef::supports_fast_array_iteration() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     AllowHandleAllocation handle_allocation;
     return SupportsFastArrayIteration(broker()->isolate(), object());
@@ -2826,7 +2936,7 @@ bool MapRef::supports_fast_array_iteration() const {
 }
 
 bool MapRef::supports_fast_array_resize() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     AllowHandleAllocation handle_allocation;
     return SupportsFastArrayResize(broker()->isolate(), object());
@@ -2835,7 +2945,7 @@ bool MapRef::supports_fast_array_resize() const {
 }
 
 int JSFunctionRef::InitialMapInstanceSizeWithMinSlack() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     AllowHandleAllocation handle_allocation;
     return object()->ComputeInstanceSizeWithMinSlack(broker()->isolate());
@@ -2891,7 +3001,7 @@ OddballType MapRef::oddball_type() const {
 }
 
 FeedbackCellRef FeedbackVectorRef::GetClosureFeedbackCell(int index) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference handle_dereference;
     return FeedbackCellRef(broker(), object()->GetClosureFeedbackCell(index));
@@ -2903,7 +3013,7 @@ FeedbackCellRef FeedbackVectorRef::GetClosureFeedbackCell(int index) const {
 }
 
 double JSObjectRef::RawFastDoublePropertyAt(FieldIndex index) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference handle_dereference;
     return object()->RawFastDoublePropertyAt(index);
   }
@@ -2913,7 +3023,7 @@ double JSObjectRef::RawFastDoublePropertyAt(FieldIndex index) const {
 }
 
 uint64_t JSObjectRef::RawFastDoublePropertyAsBitsAt(FieldIndex index) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference handle_dereference;
     return object()->RawFastDoublePropertyAsBitsAt(index);
   }
@@ -2923,7 +3033,7 @@ uint64_t JSObjectRef::RawFastDoublePropertyAsBitsAt(FieldIndex index) const {
 }
 
 ObjectRef JSObjectRef::RawFastPropertyAt(FieldIndex index) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference handle_dereference;
     return ObjectRef(broker(), handle(object()->RawFastPropertyAt(index),
@@ -2937,7 +3047,7 @@ ObjectRef JSObjectRef::RawFastPropertyAt(FieldIndex index) const {
 }
 
 bool AllocationSiteRef::IsFastLiteral() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHeapAllocation allow_heap_allocation;  // For TryMigrateInstance.
     AllowHandleAllocation allow_handle_allocation;
     AllowHandleDereference allow_handle_dereference;
@@ -2958,7 +3068,7 @@ void JSObjectRef::SerializeElements() {
 }
 
 void JSObjectRef::EnsureElementsTenured() {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation allow_handle_allocation;
     AllowHandleDereference allow_handle_dereference;
     AllowHeapAllocation allow_heap_allocation;
@@ -2979,7 +3089,7 @@ void JSObjectRef::EnsureElementsTenured() {
 }
 
 FieldIndex MapRef::GetFieldIndexFor(InternalIndex descriptor_index) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return FieldIndex::ForDescriptor(*object(), descriptor_index);
   }
@@ -2988,7 +3098,7 @@ FieldIndex MapRef::GetFieldIndexFor(InternalIndex descriptor_index) const {
 }
 
 int MapRef::GetInObjectPropertyOffset(int i) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return object()->GetInObjectPropertyOffset(i);
   }
@@ -2997,7 +3107,7 @@ int MapRef::GetInObjectPropertyOffset(int i) const {
 
 PropertyDetails MapRef::GetPropertyDetails(
     InternalIndex descriptor_index) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return object()->instance_descriptors().GetDetails(descriptor_index);
   }
@@ -3006,7 +3116,7 @@ PropertyDetails MapRef::GetPropertyDetails(
 }
 
 NameRef MapRef::GetPropertyKey(InternalIndex descriptor_index) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference allow_handle_dereference;
     return NameRef(
@@ -3030,7 +3140,7 @@ bool MapRef::IsPrimitiveMap() const {
 }
 
 MapRef MapRef::FindFieldOwner(InternalIndex descriptor_index) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference allow_handle_dereference;
     Handle<Map> owner(
@@ -3045,7 +3155,7 @@ MapRef MapRef::FindFieldOwner(InternalIndex descriptor_index) const {
 }
 
 ObjectRef MapRef::GetFieldType(InternalIndex descriptor_index) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference allow_handle_dereference;
     Handle<FieldType> field_type(
@@ -3060,7 +3170,7 @@ ObjectRef MapRef::GetFieldType(InternalIndex descriptor_index) const {
 }
 
 bool MapRef::IsUnboxedDoubleField(InternalIndex descriptor_index) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return object()->IsUnboxedDoubleField(
         FieldIndex::ForDescriptor(*object(), descriptor_index));
@@ -3072,7 +3182,7 @@ bool MapRef::IsUnboxedDoubleField(InternalIndex descriptor_index) const {
 }
 
 uint16_t StringRef::GetFirstChar() {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return object()->Get(0);
   }
@@ -3080,7 +3190,7 @@ uint16_t StringRef::GetFirstChar() {
 }
 
 base::Optional<double> StringRef::ToNumber() {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     AllowHandleAllocation allow_handle_allocation;
     AllowHeapAllocation allow_heap_allocation;
@@ -3091,7 +3201,7 @@ base::Optional<double> StringRef::ToNumber() {
 }
 
 int ArrayBoilerplateDescriptionRef::constants_elements_length() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return object()->constant_elements().length();
   }
@@ -3099,7 +3209,7 @@ int ArrayBoilerplateDescriptionRef::constants_elements_length() const {
 }
 
 int ObjectBoilerplateDescriptionRef::size() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return object()->size();
   }
@@ -3107,7 +3217,7 @@ int ObjectBoilerplateDescriptionRef::size() const {
 }
 
 ObjectRef FixedArrayRef::get(int i) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference allow_handle_dereference;
     return ObjectRef(broker(), handle(object()->get(i), broker()->isolate()));
@@ -3116,7 +3226,7 @@ ObjectRef FixedArrayRef::get(int i) const {
 }
 
 bool FixedDoubleArrayRef::is_the_hole(int i) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return object()->is_the_hole(i);
   }
@@ -3124,7 +3234,7 @@ bool FixedDoubleArrayRef::is_the_hole(int i) const {
 }
 
 double FixedDoubleArrayRef::get_scalar(int i) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return object()->get_scalar(i);
   }
@@ -3133,7 +3243,7 @@ double FixedDoubleArrayRef::get_scalar(int i) const {
 }
 
 uint8_t BytecodeArrayRef::get(int index) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference allow_handle_dereference;
     return object()->get(index);
@@ -3142,7 +3252,7 @@ uint8_t BytecodeArrayRef::get(int index) const {
 }
 
 Address BytecodeArrayRef::GetFirstBytecodeAddress() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference allow_handle_dereference;
     return object()->GetFirstBytecodeAddress();
@@ -3151,7 +3261,7 @@ Address BytecodeArrayRef::GetFirstBytecodeAddress() const {
 }
 
 Handle<Object> BytecodeArrayRef::GetConstantAtIndex(int index) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference allow_handle_dereference;
     return handle(object()->constant_pool().get(index), broker()->isolate());
@@ -3161,7 +3271,7 @@ Handle<Object> BytecodeArrayRef::GetConstantAtIndex(int index) const {
 }
 
 bool BytecodeArrayRef::IsConstantAtIndexSmi(int index) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference allow_handle_dereference;
     return object()->constant_pool().get(index).IsSmi();
@@ -3170,7 +3280,7 @@ bool BytecodeArrayRef::IsConstantAtIndexSmi(int index) const {
 }
 
 Smi BytecodeArrayRef::GetConstantAtIndexAsSmi(int index) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference allow_handle_dereference;
     return Smi::cast(object()->constant_pool().get(index));
@@ -3179,12 +3289,12 @@ Smi BytecodeArrayRef::GetConstantAtIndexAsSmi(int index) const {
 }
 
 void BytecodeArrayRef::SerializeForCompilation() {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return;
+  if (data_->should_access_heap()) return;
   data()->AsBytecodeArray()->SerializeForCompilation(broker());
 }
 
 const byte* BytecodeArrayRef::source_positions_address() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return object()->SourcePositionTableIfCollected().GetDataStartAddress();
   }
@@ -3192,7 +3302,7 @@ const byte* BytecodeArrayRef::source_positions_address() const {
 }
 
 int BytecodeArrayRef::source_positions_size() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return object()->SourcePositionTableIfCollected().length();
   }
@@ -3200,7 +3310,7 @@ int BytecodeArrayRef::source_positions_size() const {
 }
 
 Address BytecodeArrayRef::handler_table_address() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return reinterpret_cast<Address>(
         object()->handler_table().GetDataStartAddress());
@@ -3209,26 +3319,26 @@ Address BytecodeArrayRef::handler_table_address() const {
 }
 
 int BytecodeArrayRef::handler_table_size() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return object()->handler_table().length();
   }
   return data()->AsBytecodeArray()->handler_table_size();
 }
 
-#define IF_BROKER_DISABLED_ACCESS_HANDLE_C(holder, name)          \
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) { \
-    AllowHandleAllocation handle_allocation;                      \
-    AllowHandleDereference allow_handle_dereference;              \
-    return object()->name();                                      \
+#define IF_BROKER_DISABLED_ACCESS_HANDLE_C(holder, name) \
+  if (data_->should_access_heap()) {                     \
+    AllowHandleAllocation handle_allocation;             \
+    AllowHandleDereference allow_handle_dereference;     \
+    return object()->name();                             \
   }
 
-#define IF_BROKER_DISABLED_ACCESS_HANDLE(holder, result, name)         \
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {      \
-    AllowHandleAllocation handle_allocation;                           \
-    AllowHandleDereference allow_handle_dereference;                   \
-    return result##Ref(broker(),                                       \
-                       handle(object()->name(), broker()->isolate())); \
+#define IF_BROKER_DISABLED_ACCESS_HANDLE(holder, result, name)                 \
+  if (data_->should_access_heap()) {                                           \
+    AllowHandleAllocation handle_allocation;                                   \
+    AllowHandleDereference allow_handle_dereference;                           \
+    return result##Ref(broker(),                                               \
+                       broker()->CanonicalPersistentHandle(object()->name())); \
   }
 
 // Macros for definining a const getter that, depending on the broker mode,
@@ -3330,7 +3440,7 @@ BIMODAL_ACCESSOR(PropertyCell, Object, value)
 BIMODAL_ACCESSOR_C(PropertyCell, PropertyDetails, property_details)
 
 base::Optional<CallHandlerInfoRef> FunctionTemplateInfoRef::call_code() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     return CallHandlerInfoRef(
         broker(), handle(object()->call_code(), broker()->isolate()));
   }
@@ -3341,7 +3451,7 @@ base::Optional<CallHandlerInfoRef> FunctionTemplateInfoRef::call_code() const {
 }
 
 bool FunctionTemplateInfoRef::is_signature_undefined() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     AllowHandleAllocation allow_handle_allocation;
 
@@ -3351,7 +3461,7 @@ bool FunctionTemplateInfoRef::is_signature_undefined() const {
 }
 
 bool FunctionTemplateInfoRef::has_call_code() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     AllowHandleAllocation allow_handle_allocation;
 
@@ -3367,7 +3477,7 @@ HolderLookupResult FunctionTemplateInfoRef::LookupHolderOfExpectedType(
     MapRef receiver_map, SerializationPolicy policy) {
   const HolderLookupResult not_found;
 
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     AllowHandleAllocation allow_handle_allocation;
 
@@ -3447,7 +3557,7 @@ BIMODAL_ACCESSOR_C(String, int, length)
 BIMODAL_ACCESSOR(FeedbackCell, HeapObject, value)
 
 ObjectRef MapRef::GetStrongValue(InternalIndex descriptor_index) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return ObjectRef(broker(),
                      handle(object()->instance_descriptors().GetStrongValue(
@@ -3458,13 +3568,13 @@ ObjectRef MapRef::GetStrongValue(InternalIndex descriptor_index) const {
 }
 
 void MapRef::SerializeRootMap() {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return;
+  if (data_->should_access_heap()) return;
   CHECK_EQ(broker()->mode(), JSHeapBroker::kSerializing);
   data()->AsMap()->SerializeRootMap(broker());
 }
 
 base::Optional<MapRef> MapRef::FindRootMap() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return MapRef(broker(), handle(object()->FindRootMap(broker()->isolate()),
                                    broker()->isolate()));
@@ -3478,7 +3588,7 @@ base::Optional<MapRef> MapRef::FindRootMap() const {
 }
 
 void* JSTypedArrayRef::data_ptr() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return object()->DataPtr();
   }
@@ -3543,16 +3653,17 @@ bool ScopeInfoRef::HasOuterScopeInfo() const {
 }
 
 ScopeInfoRef ScopeInfoRef::OuterScopeInfo() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference handle_dereference;
-    return ScopeInfoRef(
-        broker(), handle(object()->OuterScopeInfo(), broker()->isolate()));
+    return ScopeInfoRef(broker(), broker()->CanonicalPersistentHandle(
+                                      object()->OuterScopeInfo()));
   }
   return ScopeInfoRef(broker(), data()->AsScopeInfo()->outer_scope_info());
 }
 
 void ScopeInfoRef::SerializeScopeInfoChain() {
+  if (data_->should_access_heap()) return;
   CHECK_EQ(broker()->mode(), JSHeapBroker::kSerializing);
   data()->AsScopeInfo()->SerializeScopeInfoChain(broker());
 }
@@ -3563,7 +3674,7 @@ bool StringRef::IsExternalString() const {
 }
 
 Address CallHandlerInfoRef::callback() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     return v8::ToCData<Address>(object()->callback());
   }
   return HeapObjectRef::data()->AsCallHandlerInfo()->callback();
@@ -3575,7 +3686,7 @@ bool StringRef::IsSeqString() const {
 }
 
 ScopeInfoRef NativeContextRef::scope_info() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference handle_dereference;
     return ScopeInfoRef(broker(),
@@ -3587,7 +3698,7 @@ ScopeInfoRef NativeContextRef::scope_info() const {
 MapRef NativeContextRef::GetFunctionMapFromIndex(int index) const {
   DCHECK_GE(index, Context::FIRST_FUNCTION_MAP_INDEX);
   DCHECK_LE(index, Context::LAST_FUNCTION_MAP_INDEX);
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     return get(index).value().AsMap();
   }
   return MapRef(broker(), data()->AsNativeContext()->function_maps().at(
@@ -3641,7 +3752,7 @@ bool ObjectRef::IsNullOrUndefined() const {
 }
 
 bool ObjectRef::BooleanValue() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference allow_handle_dereference;
     return object()->BooleanValue(broker()->isolate());
   }
@@ -3675,7 +3786,7 @@ Maybe<double> ObjectRef::OddballToNumber() const {
 
 base::Optional<ObjectRef> ObjectRef::GetOwnConstantElement(
     uint32_t index, SerializationPolicy policy) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     return (IsJSObject() || IsString())
                ? GetOwnElementFromHeap(broker(), object(), index, true)
                : base::nullopt;
@@ -3694,7 +3805,7 @@ base::Optional<ObjectRef> ObjectRef::GetOwnConstantElement(
 base::Optional<ObjectRef> JSObjectRef::GetOwnDataProperty(
     Representation field_representation, FieldIndex index,
     SerializationPolicy policy) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     return GetOwnDataPropertyFromHeap(broker(),
                                       Handle<JSObject>::cast(object()),
                                       field_representation, index);
@@ -3707,7 +3818,7 @@ base::Optional<ObjectRef> JSObjectRef::GetOwnDataProperty(
 
 base::Optional<ObjectRef> JSArrayRef::GetOwnCowElement(
     uint32_t index, SerializationPolicy policy) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     if (!object()->elements().IsCowArray()) return base::nullopt;
     return GetOwnElementFromHeap(broker(), object(), index, false);
   }
@@ -3737,7 +3848,7 @@ uint64_t BigIntRef::AsUint64() const {
 }
 
 base::Optional<CellRef> SourceTextModuleRef::GetCell(int cell_index) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference allow_handle_dereference;
     return CellRef(broker(),
@@ -3754,6 +3865,9 @@ ObjectRef::ObjectRef(JSHeapBroker* broker, Handle<Object> object,
   switch (broker->mode()) {
     case JSHeapBroker::kSerialized:
       data_ = broker->GetData(object);
+      if (data_ == nullptr && broker->IsNeverSerializedHeapObject(object)) {
+        data_ = broker->GetOrCreateData(object);
+      }
       break;
     case JSHeapBroker::kSerializing:
       data_ = broker->GetOrCreateData(object);
@@ -3810,7 +3924,7 @@ OddballType GetOddballType(Isolate* isolate, Map map) {
 }  // namespace
 
 HeapObjectType HeapObjectRef::GetHeapObjectType() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleDereference handle_dereference;
     Map map = Handle<HeapObject>::cast(object())->map();
     HeapObjectType::Flags flags(0);
@@ -3825,7 +3939,7 @@ HeapObjectType HeapObjectRef::GetHeapObjectType() const {
   return HeapObjectType(map().instance_type(), flags, map().oddball_type());
 }
 base::Optional<JSObjectRef> AllocationSiteRef::boilerplate() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference allow_handle_dereference;
     return JSObjectRef(broker(),
@@ -3844,7 +3958,7 @@ ElementsKind JSObjectRef::GetElementsKind() const {
 }
 
 FixedArrayBaseRef JSObjectRef::elements() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference allow_handle_dereference;
     return FixedArrayBaseRef(broker(),
@@ -4001,22 +4115,22 @@ void NativeContextData::Serialize(JSHeapBroker* broker) {
     function_maps_.push_back(broker->GetOrCreateData(context->get(i))->AsMap());
   }
 
-  scope_info_ = broker->GetOrCreateData(context->scope_info())->AsScopeInfo();
+  scope_info_ = broker->GetOrCreateData(context->scope_info());
 }
 
 void JSFunctionRef::Serialize() {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return;
+  if (data_->should_access_heap()) return;
   CHECK_EQ(broker()->mode(), JSHeapBroker::kSerializing);
   data()->AsJSFunction()->Serialize(broker());
 }
 
 bool JSBoundFunctionRef::serialized() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return true;
+  if (data_->should_access_heap()) return true;
   return data()->AsJSBoundFunction()->serialized();
 }
 
 bool JSFunctionRef::serialized() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return true;
+  if (data_->should_access_heap()) return true;
   return data()->AsJSFunction()->serialized();
 }
 
@@ -4034,7 +4148,7 @@ JSArrayRef SharedFunctionInfoRef::GetTemplateObject(
     return feedback.AsTemplateObject().value();
   }
 
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference allow_handle_dereference;
     Handle<JSArray> template_object =
@@ -4072,7 +4186,7 @@ void SharedFunctionInfoRef::SerializeScopeInfoChain() {
 
 base::Optional<FunctionTemplateInfoRef>
 SharedFunctionInfoRef::function_template_info() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     if (object()->IsApiFunction()) {
       return FunctionTemplateInfoRef(
           broker(), handle(object()->function_data(), broker()->isolate()));
@@ -4092,7 +4206,7 @@ int SharedFunctionInfoRef::context_header_size() const {
 }
 
 ScopeInfoRef SharedFunctionInfoRef::scope_info() const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     AllowHandleAllocation handle_allocation;
     AllowHandleDereference handle_dereference;
     return ScopeInfoRef(broker(),
@@ -4102,26 +4216,26 @@ ScopeInfoRef SharedFunctionInfoRef::scope_info() const {
 }
 
 void JSObjectRef::SerializeObjectCreateMap() {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return;
+  if (data_->should_access_heap()) return;
   CHECK_EQ(broker()->mode(), JSHeapBroker::kSerializing);
   data()->AsJSObject()->SerializeObjectCreateMap(broker());
 }
 
 void MapRef::SerializeOwnDescriptors() {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return;
+  if (data_->should_access_heap()) return;
   CHECK_EQ(broker()->mode(), JSHeapBroker::kSerializing);
   data()->AsMap()->SerializeOwnDescriptors(broker());
 }
 
 void MapRef::SerializeOwnDescriptor(InternalIndex descriptor_index) {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return;
+  if (data_->should_access_heap()) return;
   CHECK_EQ(broker()->mode(), JSHeapBroker::kSerializing);
   data()->AsMap()->SerializeOwnDescriptor(broker(), descriptor_index);
 }
 
 bool MapRef::serialized_own_descriptor(InternalIndex descriptor_index) const {
   CHECK_LT(descriptor_index.as_int(), NumberOfOwnDescriptors());
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return true;
+  if (data_->should_access_heap()) return true;
   DescriptorArrayData* desc_array_data =
       data()->AsMap()->instance_descriptors();
   if (!desc_array_data) return false;
@@ -4130,13 +4244,13 @@ bool MapRef::serialized_own_descriptor(InternalIndex descriptor_index) const {
 }
 
 void MapRef::SerializeBackPointer() {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return;
+  if (data_->should_access_heap()) return;
   CHECK_EQ(broker()->mode(), JSHeapBroker::kSerializing);
   data()->AsMap()->SerializeBackPointer(broker());
 }
 
 void MapRef::SerializePrototype() {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return;
+  if (data_->should_access_heap()) return;
   CHECK_EQ(broker()->mode(), JSHeapBroker::kSerializing);
   data()->AsMap()->SerializePrototype(broker());
 }
@@ -4147,19 +4261,19 @@ bool MapRef::serialized_prototype() const {
 }
 
 void SourceTextModuleRef::Serialize() {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return;
+  if (data_->should_access_heap()) return;
   CHECK_EQ(broker()->mode(), JSHeapBroker::kSerializing);
   data()->AsSourceTextModule()->Serialize(broker());
 }
 
 void NativeContextRef::Serialize() {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return;
+  if (data_->should_access_heap()) return;
   CHECK_EQ(broker()->mode(), JSHeapBroker::kSerializing);
   data()->AsNativeContext()->Serialize(broker());
 }
 
 void JSTypedArrayRef::Serialize() {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return;
+  if (data_->should_access_heap()) return;
   CHECK_EQ(broker()->mode(), JSHeapBroker::kSerializing);
   data()->AsJSTypedArray()->Serialize(broker());
 }
@@ -4170,26 +4284,26 @@ bool JSTypedArrayRef::serialized() const {
 }
 
 void JSBoundFunctionRef::Serialize() {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return;
+  if (data_->should_access_heap()) return;
   CHECK_EQ(broker()->mode(), JSHeapBroker::kSerializing);
   data()->AsJSBoundFunction()->Serialize(broker());
 }
 
 void PropertyCellRef::Serialize() {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return;
+  if (data_->should_access_heap()) return;
   CHECK_EQ(broker()->mode(), JSHeapBroker::kSerializing);
   data()->AsPropertyCell()->Serialize(broker());
 }
 
 void FunctionTemplateInfoRef::SerializeCallCode() {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) return;
+  if (data_->should_access_heap()) return;
   CHECK_EQ(broker()->mode(), JSHeapBroker::kSerializing);
   data()->AsFunctionTemplateInfo()->SerializeCallCode(broker());
 }
 
 base::Optional<PropertyCellRef> JSGlobalObjectRef::GetPropertyCell(
     NameRef const& name, SerializationPolicy policy) const {
-  if (data_->kind() == ObjectDataKind::kUnserializedHeapObject) {
+  if (data_->should_access_heap()) {
     return GetPropertyCellFromHeap(broker(), name.object());
   }
   PropertyCellData* property_cell_data =
@@ -4894,7 +5008,7 @@ void ElementAccessFeedback::AddGroup(TransitionGroup&& group) {
 }
 
 std::ostream& operator<<(std::ostream& os, const ObjectRef& ref) {
-  if (ref.data_->kind() == ObjectDataKind::kUnserializedHeapObject ||
+  if (ref.data_->should_access_heap() ||
       !FLAG_concurrent_recompilation) {
     // We cannot be in a background thread so it's safe to read the heap.
     AllowHandleDereference allow_handle_dereference;
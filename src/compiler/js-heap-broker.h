@@ -23,6 +23,11 @@
 
 namespace v8 {
 namespace internal {
+
+class LocalHeap;
+class ParkedScope;
+class PersistentHandles;
+
 namespace compiler {
 
 class BytecodeAnalysis;
@@ -73,6 +78,7 @@ struct PropertyAccessTarget {
 class V8_EXPORT_PRIVATE JSHeapBroker {
  public:
   JSHeapBroker(Isolate* isolate, Zone* broker_zone, bool tracing_enabled);
+  ~JSHeapBroker();
 
   // The compilation target's native context. We need the setter because at
   // broker construction time we don't yet have the canonical handle.
@@ -93,6 +99,33 @@ class V8_EXPORT_PRIVATE JSHeapBroker {
   void Retire();
   bool SerializingAllowed() const;
 
+  // With --turbo-direct-heap-access, immutable objects are never serialized
+  // but read directly from the heap, also from the background thread.
+  bool IsNeverSerializedHeapObject(Handle<Object> object) const;
+
+  // Attaches the LocalHeap of the background thread that executes the
+  // compilation job. While a LocalHeap is attached, handles for objects read
+  // directly from the heap are allocated as persistent handles, which live
+  // as long as the broker.
+  void AttachLocalHeap(LocalHeap* local_heap);
+  void DetachLocalHeap();
+  LocalHeap* local_heap() const { return local_heap_; }
+
+  // Returns a handle for {object} that is canonical within this broker and
+  // stays valid on the thread the broker currently runs on.
+  Handle<Object> CanonicalPersistentHandle(Object object);
+
+  // Lets the GC run if it requested a safepoint. Must only be called while no
+  // raw object pointers are live, e.g. between two pipeline phases.
+  void Safepoint();
+
+  // Parks the attached LocalHeap, so that the GC does not have to wait for
+  // the compiler while it runs phases that neither read the heap nor
+  // dereference handles. Unparking blocks until a running GC is over.
+  void ParkLocalHeap();
+  void UnparkLocalHeap();
+  bool IsLocalHeapParked() const { return parked_scope_ != nullptr; }
+
 #ifdef DEBUG
   void PrintRefsAnalysis() const;
 #endif  // DEBUG
@@ -225,6 +258,10 @@ class V8_EXPORT_PRIVATE JSHeapBroker {
   void CollectArrayAndObjectPrototypes();
   void SerializeTypedArrayStringTags();
 
+  // Rebuilds |canonical_persistent_handles_| after the GC may have moved
+  // objects.
+  void RehashCanonicalPersistentHandles();
+
   PerIsolateCompilerCache* compiler_cache() const { return compiler_cache_; }
 
   Isolate* const isolate_;
@@ -266,6 +303,13 @@ class V8_EXPORT_PRIVATE JSHeapBroker {
   };
   ZoneMultimap<SerializedFunction, HintsVector> serialized_functions_;
 
+  LocalHeap* local_heap_ = nullptr;
+  std::unique_ptr<ParkedScope> parked_scope_;
+  std::unique_ptr<PersistentHandles> persistent_handles_;
+  // Maps object addresses to persistent handle locations. Rehashed after the
+  // background thread was stopped in a safepoint, see Safepoint().
+  ZoneUnorderedMap<Address, Address*> canonical_persistent_handles_;
+
   static const size_t kMinimalRefsBucketCount = 8;     // must be power of 2
   static const size_t kInitialRefsBucketCount = 1024;  // must be power of 2
 };
@@ -4,6 +4,7 @@
 
 #include "src/compiler/loop-variable-optimizer.h"
 
+#include "src/compiler/all-nodes.h"
 #include "src/compiler/common-operator.h"
 #include "src/compiler/graph.h"
 #include "src/compiler/node-marker.h"
@@ -226,6 +227,8 @@ InductionVariable* LoopVariableOptimizer::TryGetInductionVariable(Node* phi) {
   DCHECK_EQ(IrOpcode::kLoop, loop->opcode());
   Node* initial = phi->InputAt(0);
   Node* arith = phi->InputAt(1);
+  // Look through the guard that the typer inserts on the backedge.
+  if (arith->opcode() == IrOpcode::kTypeGuard) arith = arith->InputAt(0);
   InductionVariable::ArithmeticType arithmeticType;
   if (arith->opcode() == IrOpcode::kJSAdd ||
       arith->opcode() == IrOpcode::kNumberAdd ||
@@ -345,6 +348,38 @@ void LoopVariableOptimizer::ChangeToPhisAndInsertGuards() {
   }
 }
 
+void LoopVariableOptimizer::EliminateRedundantBoundsChecks() {
+  ZoneVector<Node*> checks(zone());
+  for (Node* node : AllNodes(zone(), graph()).reachable) {
+    if (node->opcode() == IrOpcode::kCheckBounds) checks.push_back(node);
+  }
+
+  for (Node* node : checks) {
+    Node* index = NodeProperties::GetValueInput(node, 0);
+    Node* length = NodeProperties::GetValueInput(node, 1);
+    if (!FindInductionVariable(index)) continue;
+    // The limits only tell us how the comparison evaluated. That matches
+    // the bounds check if both sides are plain numbers, and the index has
+    // to be an integer for the check to succeed.
+    if (!NodeProperties::GetType(index).Is(Type::Unsigned31()) ||
+        !NodeProperties::GetType(length).Is(Type::OrderedNumber())) {
+      continue;
+    }
+    Node* control = NodeProperties::GetControlInput(node);
+    for (Constraint constraint : limits_.Get(control)) {
+      if (constraint.left == index && constraint.right == length &&
+          constraint.kind == InductionVariable::kStrict) {
+        TRACE("Eliminating bounds check %i on induction variable %i\n",
+              node->id(), index->id());
+        node->RemoveInput(1);
+        NodeProperties::ChangeOp(
+            node, common()->TypeGuard(NodeProperties::GetType(node)));
+        break;
+      }
+    }
+  }
+}
+
 #undef TRACE
 
 }  // namespace compiler
@@ -80,6 +80,16 @@ class LoopVariableOptimizer {
   void ChangeToInductionVariablePhis();
   void ChangeToPhisAndInsertGuards();
 
+  // Removes CheckBounds nodes whose index is an induction variable that is
+  // known to be non-negative and that is dominated by a comparison against
+  // the very same length node, e.g. the bounds check in
+  //
+  //   for (let i = 0; i < a.length; i++) a[i];
+  //
+  // The check is turned into a TypeGuard to keep its type. Must be called
+  // after Run() on a typed graph.
+  void EliminateRedundantBoundsChecks();
+
  private:
   const int kAssumedLoopEntryIndex = 0;
   const int kFirstBackedge = 1;
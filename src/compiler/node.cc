@@ -8,10 +8,19 @@ namespace v8 {
 namespace internal {
 namespace compiler {
 
+size_t Node::OutOfLineInputs::SizeFor(int capacity) {
+  return sizeof(OutOfLineInputs) + capacity * (sizeof(Node*) + sizeof(Use));
+}
+
+
 Node::OutOfLineInputs* Node::OutOfLineInputs::New(Zone* zone, int capacity) {
-  size_t size =
-      sizeof(OutOfLineInputs) + capacity * (sizeof(Node*) + sizeof(Use));
-  intptr_t raw_buffer = reinterpret_cast<intptr_t>(zone->New(size));
+  return Initialize(zone->New(SizeFor(capacity)), capacity);
+}
+
+
+Node::OutOfLineInputs* Node::OutOfLineInputs::Initialize(void* buffer,
+                                                         int capacity) {
+  intptr_t raw_buffer = reinterpret_cast<intptr_t>(buffer);
   Node::OutOfLineInputs* outline =
       reinterpret_cast<OutOfLineInputs*>(raw_buffer + capacity * sizeof(Use));
   outline->capacity_ = capacity;
@@ -70,12 +79,25 @@ Node* Node::New(Zone* zone, NodeId id, const Operator* op, int input_count,
 
   if (input_count > kMaxInlineCapacity) {
     // Allocate out-of-line inputs.
-    int capacity =
-        has_extensible_inputs ? input_count + kMaxInlineCapacity : input_count;
-    OutOfLineInputs* outline = OutOfLineInputs::New(zone, capacity);
+    OutOfLineInputs* outline;
+    void* node_buffer;
+    if (has_extensible_inputs) {
+      outline = OutOfLineInputs::New(zone, input_count + kMaxInlineCapacity);
 
-    // Allocate node, with space for OutOfLineInputs pointer.
-    void* node_buffer = zone->New(sizeof(Node) + sizeof(OutOfLineInputs*));
+      // Allocate node, with space for OutOfLineInputs pointer.
+      node_buffer = zone->New(sizeof(Node) + sizeof(OutOfLineInputs*));
+    } else {
+      // Inputs of nodes with a fixed number of inputs are only moved again if
+      // a reducer adds inputs later on, so the node goes into the same zone
+      // chunk right behind them. This saves an allocation and keeps the
+      // inputs within a few cache lines of the node.
+      size_t outline_size = OutOfLineInputs::SizeFor(input_count);
+      intptr_t raw_buffer = reinterpret_cast<intptr_t>(zone->New(
+          outline_size + sizeof(Node) + sizeof(OutOfLineInputs*)));
+      outline = OutOfLineInputs::Initialize(
+          reinterpret_cast<void*>(raw_buffer), input_count);
+      node_buffer = reinterpret_cast<void*>(raw_buffer + outline_size);
+    }
     node = new (node_buffer) Node(id, op, kOutlineMarker, 0);
     node->set_outline_inputs(outline);
 
@@ -173,6 +173,10 @@ class V8_EXPORT_PRIVATE Node final {
     inline Node** inputs();
 
     static OutOfLineInputs* New(Zone* zone, int capacity);
+    // Sets up out-of-line inputs in a {buffer} of at least SizeFor(capacity)
+    // bytes.
+    static OutOfLineInputs* Initialize(void* buffer, int capacity);
+    static size_t SizeFor(int capacity);
     void ExtractFrom(Use* use_ptr, Node** input_ptr, int count);
   };
 
@@ -4,6 +4,7 @@
 
 #include "src/compiler/pipeline.h"
 
+#include <atomic>
 #include <fstream>  // NOLINT(readability/streams)
 #include <iostream>
 #include <memory>
@@ -11,10 +12,12 @@
 
 #include "src/base/optional.h"
 #include "src/base/platform/elapsed-timer.h"
+#include "src/base/platform/semaphore.h"
 #include "src/codegen/assembler-inl.h"
 #include "src/codegen/compiler.h"
 #include "src/codegen/optimized-compilation-info.h"
 #include "src/codegen/register-configuration.h"
+#include "src/codegen/tick-counter.h"
 #include "src/compiler/add-type-assertions-reducer.h"
 #include "src/compiler/backend/code-generator.h"
 #include "src/compiler/backend/frame-elider.h"
@@ -83,9 +86,11 @@
 #include "src/diagnostics/disassembler.h"
 #include "src/execution/isolate-inl.h"
 #include "src/init/bootstrapper.h"
+#include "src/init/v8.h"
 #include "src/logging/counters.h"
 #include "src/objects/shared-function-info.h"
 #include "src/parsing/parse-info.h"
+#include "src/tasks/cancelable-task.h"
 #include "src/tracing/trace-event.h"
 #include "src/tracing/traced-value.h"
 #include "src/utils/ostreams.h"
@@ -99,6 +104,8 @@ namespace internal {
 namespace compiler {
 
 static constexpr char kCodegenZoneName[] = "codegen-zone";
+static constexpr char kFPRegisterAllocationZoneName[] =
+    "fp-register-allocation-zone";
 static constexpr char kGraphZoneName[] = "graph-zone";
 static constexpr char kInstructionZoneName[] = "instruction-zone";
 static constexpr char kMachineGraphVerifierZoneName[] =
@@ -109,6 +116,8 @@ static constexpr char kRegisterAllocationZoneName[] =
     "register-allocation-zone";
 static constexpr char kRegisterAllocatorVerifierZoneName[] =
     "register-allocator-verifier-zone";
+static constexpr char kFPRegisterAllocationTempZoneName[] =
+    "fp-register-allocation-temp-zone";
 namespace {
 
 Maybe<OuterContext> GetModuleContext(Handle<JSFunction> closure) {
@@ -154,6 +163,8 @@ class PipelineData {
         register_allocation_zone_scope_(zone_stats_,
                                         kRegisterAllocationZoneName),
         register_allocation_zone_(register_allocation_zone_scope_.zone()),
+        fp_register_allocation_zone_scope_(zone_stats_,
+                                           kFPRegisterAllocationZoneName),
         assembler_options_(AssemblerOptions::Default(isolate)) {
     PhaseScope scope(pipeline_statistics, "V8.TFInitPipelineData");
     graph_ = new (graph_zone_) Graph(graph_zone_);
@@ -204,6 +215,8 @@ class PipelineData {
         register_allocation_zone_scope_(zone_stats_,
                                         kRegisterAllocationZoneName),
         register_allocation_zone_(register_allocation_zone_scope_.zone()),
+        fp_register_allocation_zone_scope_(zone_stats_,
+                                           kFPRegisterAllocationZoneName),
         assembler_options_(assembler_options) {}
 
   // For CodeStubAssembler and machine graph testing entry point.
@@ -230,6 +243,8 @@ class PipelineData {
         register_allocation_zone_scope_(zone_stats_,
                                         kRegisterAllocationZoneName),
         register_allocation_zone_(register_allocation_zone_scope_.zone()),
+        fp_register_allocation_zone_scope_(zone_stats_,
+                                           kFPRegisterAllocationZoneName),
         jump_optimization_info_(jump_opt),
         assembler_options_(assembler_options) {
     simplified_ = new (graph_zone_) SimplifiedOperatorBuilder(graph_zone_);
@@ -260,6 +275,8 @@ class PipelineData {
         register_allocation_zone_scope_(zone_stats_,
                                         kRegisterAllocationZoneName),
         register_allocation_zone_(register_allocation_zone_scope_.zone()),
+        fp_register_allocation_zone_scope_(zone_stats_,
+                                           kFPRegisterAllocationZoneName),
         assembler_options_(AssemblerOptions::Default(isolate)) {}
 
   ~PipelineData() {
@@ -333,9 +350,21 @@ class PipelineData {
   Frame* frame() const { return frame_; }
 
   Zone* register_allocation_zone() const { return register_allocation_zone_; }
+  // Zone for the live ranges and spill ranges created while allocating
+  // floating point registers on a background thread. Has the same lifetime as
+  // the register allocation zone.
+  Zone* fp_register_allocation_zone() {
+    return fp_register_allocation_zone_scope_.zone();
+  }
   RegisterAllocationData* register_allocation_data() const {
     return register_allocation_data_;
   }
+  bool fp_registers_allocated_on_worker() const {
+    return fp_registers_allocated_on_worker_;
+  }
+  void set_fp_registers_allocated_on_worker() {
+    fp_registers_allocated_on_worker_ = true;
+  }
 
   BasicBlockProfiler::Data* profiler_data() const { return profiler_data_; }
   void set_profiler_data(BasicBlockProfiler::Data* profiler_data) {
@@ -436,6 +465,7 @@ class PipelineData {
   void DeleteRegisterAllocationZone() {
     if (register_allocation_zone_ == nullptr) return;
     register_allocation_zone_scope_.Destroy();
+    fp_register_allocation_zone_scope_.Destroy();
     register_allocation_zone_ = nullptr;
     register_allocation_data_ = nullptr;
   }
@@ -579,7 +609,9 @@ class PipelineData {
   // destroyed.
   ZoneStats::Scope register_allocation_zone_scope_;
   Zone* register_allocation_zone_;
+  ZoneStats::Scope fp_register_allocation_zone_scope_;
   RegisterAllocationData* register_allocation_data_ = nullptr;
+  bool fp_registers_allocated_on_worker_ = false;
 
   // Basic block profiling support.
   BasicBlockProfiler::Data* profiler_data_ = nullptr;
@@ -957,7 +989,8 @@ class PipelineCompilationJob final : public OptimizedCompilationJob {
 
  protected:
   Status PrepareJobImpl(Isolate* isolate) final;
-  Status ExecuteJobImpl(RuntimeCallStats* stats) final;
+  Status ExecuteJobImpl(RuntimeCallStats* stats,
+                        LocalHeap* local_heap) final;
   Status FinalizeJobImpl(Isolate* isolate) final;
 
   // Registers weak object to optimized code dependencies.
@@ -1011,7 +1044,7 @@ PipelineCompilationJob::Status PipelineCompilationJob::PrepareJobImpl(
   if (FLAG_turbo_loop_peeling) {
     compilation_info()->MarkAsLoopPeelingEnabled();
   }
-  if (FLAG_turbo_inlining) {
+  if (FLAG_turbo_inlining && !compilation_info()->is_turboprop()) {
     compilation_info()->MarkAsInliningEnabled();
   }
 
@@ -1087,13 +1120,59 @@ class PipelineExecuteJobScope {
  private:
   PipelineData* data_;
 };
+
+// Attaches the LocalHeap of the background thread to the broker for the
+// duration of the Execute phase, which allows the broker to read immutable
+// objects directly from the heap.
+class LocalHeapScope {
+ public:
+  LocalHeapScope(JSHeapBroker* broker, LocalHeap* local_heap)
+      : broker_(broker) {
+    if (local_heap != nullptr && FLAG_turbo_direct_heap_access) {
+      broker_->AttachLocalHeap(local_heap);
+    }
+  }
+
+  ~LocalHeapScope() {
+    if (broker_->local_heap() != nullptr) broker_->DetachLocalHeap();
+  }
+
+ private:
+  JSHeapBroker* broker_;
+};
+
+// Parks the broker's LocalHeap for phases that only work on the instruction
+// sequence, so that a GC requested meanwhile does not wait for them. Tracing
+// prints heap constants and therefore keeps the LocalHeap running.
+class ParkedLocalHeapScope {
+ public:
+  explicit ParkedLocalHeapScope(PipelineData* data) : broker_(nullptr) {
+    JSHeapBroker* broker = data->broker();
+    if (broker == nullptr || broker->local_heap() == nullptr) return;
+    OptimizedCompilationInfo* info = data->info();
+    if (info->trace_turbo_json_enabled() || info->trace_turbo_graph_enabled() ||
+        info->trace_turbo_allocation_enabled()) {
+      return;
+    }
+    broker_ = broker;
+    broker_->ParkLocalHeap();
+  }
+
+  ~ParkedLocalHeapScope() {
+    if (broker_ != nullptr) broker_->UnparkLocalHeap();
+  }
+
+ private:
+  JSHeapBroker* broker_;
+};
 }  // namespace
 
 PipelineCompilationJob::Status PipelineCompilationJob::ExecuteJobImpl(
-    RuntimeCallStats* stats) {
+    RuntimeCallStats* stats, LocalHeap* local_heap) {
   // Ensure that the RuntimeCallStats table is only available during execution
   // and not during finalization as that might be on a different thread.
   PipelineExecuteJobScope scope(&data_, stats);
+  LocalHeapScope local_heap_scope(data_.broker(), local_heap);
   if (FLAG_concurrent_inlining) {
     if (!pipeline_.CreateGraph()) {
       return AbortOptimization(BailoutReason::kGraphBuildingFailed);
@@ -1101,7 +1180,7 @@ PipelineCompilationJob::Status PipelineCompilationJob::ExecuteJobImpl(
   }
 
   bool success;
-  if (FLAG_turboprop) {
+  if (compilation_info()->is_turboprop()) {
     success = pipeline_.OptimizeGraphForMidTier(linkage_);
   } else {
     success = pipeline_.OptimizeGraph(linkage_);
@@ -1187,7 +1266,8 @@ class WasmHeapStubCompilationJob final : public OptimizedCompilationJob {
 
  protected:
   Status PrepareJobImpl(Isolate* isolate) final;
-  Status ExecuteJobImpl(RuntimeCallStats* stats) final;
+  Status ExecuteJobImpl(RuntimeCallStats* stats,
+                        LocalHeap* local_heap) final;
   Status FinalizeJobImpl(Isolate* isolate) final;
 
  private:
@@ -1222,7 +1302,7 @@ CompilationJob::Status WasmHeapStubCompilationJob::PrepareJobImpl(
 }
 
 CompilationJob::Status WasmHeapStubCompilationJob::ExecuteJobImpl(
-    RuntimeCallStats* stats) {
+    RuntimeCallStats* stats, LocalHeap* local_heap) {
   std::unique_ptr<PipelineStatistics> pipeline_statistics;
   if (FLAG_turbo_stats || FLAG_turbo_stats_nvp) {
     pipeline_statistics.reset(new PipelineStatistics(
@@ -1278,6 +1358,9 @@ CompilationJob::Status WasmHeapStubCompilationJob::FinalizeJobImpl(
 
 template <typename Phase, typename... Args>
 void PipelineImpl::Run(Args&&... args) {
+  // Phases only hold handles across their boundaries, so this is where a
+  // background thread with direct heap access lets the GC run.
+  if (this->data_->broker() != nullptr) this->data_->broker()->Safepoint();
   PipelineRunScope scope(this->data_, Phase::phase_name());
   Phase phase;
   phase.Run(this->data_, scope.zone(), std::forward<Args>(args)...);
@@ -1294,6 +1377,9 @@ struct GraphBuilderPhase {
     if (data->info()->is_bailout_on_uninitialized()) {
       flags |= BytecodeGraphBuilderFlag::kBailoutOnUninitialized;
     }
+    if (data->info()->is_turboprop() && FLAG_turboprop_mid_tier) {
+      flags |= BytecodeGraphBuilderFlag::kUpdateInterruptBudget;
+    }
 
     JSFunctionRef closure(data->broker(), data->info()->closure());
     CallFrequency frequency(1.0f);
@@ -1703,6 +1789,19 @@ struct StoreStoreEliminationPhase {
   }
 };
 
+struct LoopBoundsCheckEliminationPhase {
+  static const char* phase_name() {
+    return "V8.TFLoopBoundsCheckElimination";
+  }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    LoopVariableOptimizer induction_vars(data->jsgraph()->graph(),
+                                         data->common(), temp_zone);
+    induction_vars.Run();
+    induction_vars.EliminateRedundantBoundsChecks();
+  }
+};
+
 struct LoadEliminationPhase {
   static const char* phase_name() { return "V8.TFLoadElimination"; }
 
@@ -2010,7 +2109,12 @@ struct InstructionSelectionPhase {
         data->info()->GetPoisoningMitigationLevel(),
         data->info()->trace_turbo_json_enabled()
             ? InstructionSelector::kEnableTraceTurboJson
-            : InstructionSelector::kDisableTraceTurboJson);
+            : InstructionSelector::kDisableTraceTurboJson,
+        // Builtins and stubs end up in the snapshot and must be scheduled
+        // the same way regardless of the build machine.
+        data->info()->IsOptimizing() || data->info()->IsWasm()
+            ? InstructionScheduler::LatencyModel::kHost
+            : InstructionScheduler::LatencyModel::kGeneric);
     if (!selector.SelectInstructions()) {
       data->set_compilation_failed();
     }
@@ -2097,6 +2201,79 @@ struct AllocateFPRegistersPhase {
   }
 };
 
+// Allocates floating point registers on a worker thread, unless the main
+// thread already claimed the work because the task did not start in time.
+// The allocator only walks the floating point live ranges and everything it
+// creates lives in zones of its own, so it does not race with the general
+// register allocator on the main thread.
+template <typename RegAllocator>
+class AllocateFPRegistersTask final : public CancelableTask {
+ public:
+  AllocateFPRegistersTask(CancelableTaskManager* task_manager,
+                          PipelineData* data, std::atomic<bool>* claimed,
+                          base::Semaphore* done)
+      : CancelableTask(task_manager),
+        data_(data),
+        allocation_zone_(data->fp_register_allocation_zone()),
+        claimed_(claimed),
+        done_(done) {}
+
+  static void Allocate(PipelineData* data, Zone* allocation_zone) {
+    Zone temp_zone(data->allocator(), kFPRegisterAllocationTempZoneName);
+    TickCounter tick_counter;
+    RegAllocator allocator(data->register_allocation_data(), FP_REGISTERS,
+                           &temp_zone, allocation_zone, &tick_counter);
+    allocator.AllocateRegisters();
+  }
+
+ private:
+  void RunInternal() override {
+    if (!claimed_->exchange(true)) Allocate(data_, allocation_zone_);
+    done_->Signal();
+  }
+
+  PipelineData* const data_;
+  Zone* const allocation_zone_;
+  std::atomic<bool>* const claimed_;
+  base::Semaphore* const done_;
+};
+
+template <typename RegAllocator>
+struct AllocateRegistersInParallelPhase {
+  static const char* phase_name() {
+    return "V8.TFAllocateRegistersInParallel";
+  }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    CancelableTaskManager task_manager;
+    std::atomic<bool> claimed{false};
+    base::Semaphore fp_allocation_done(0);
+    // The zone is created on the main thread, since ZoneStats is not
+    // thread-safe.
+    Zone* fp_allocation_zone = data->fp_register_allocation_zone();
+    V8::GetCurrentPlatform()->CallOnWorkerThread(
+        std::make_unique<AllocateFPRegistersTask<RegAllocator>>(
+            &task_manager, data, &claimed, &fp_allocation_done));
+
+    RegAllocator allocator(data->register_allocation_data(), GENERAL_REGISTERS,
+                           temp_zone);
+    allocator.AllocateRegisters();
+
+    bool on_worker = true;
+    if (FLAG_stress_parallel_register_allocation) {
+      // Leave the floating point registers to the worker thread.
+      fp_allocation_done.Wait();
+    } else if (!claimed.exchange(true)) {
+      on_worker = false;
+      AllocateFPRegistersTask<RegAllocator>::Allocate(data,
+                                                      fp_allocation_zone);
+    }
+    // Also waits for the worker thread if it claimed the work.
+    task_manager.CancelAndWait();
+    if (on_worker) data->set_fp_registers_allocated_on_worker();
+  }
+};
+
 
 struct MergeSplintersPhase {
   static const char* phase_name() { return "V8.TFMergeSplinteredRanges"; }
@@ -2310,7 +2487,8 @@ void PipelineImpl::Serialize() {
     OFStream os(tracing_scope.file());
     os << "---------------------------------------------------\n"
        << "Begin compiling method " << info()->GetDebugName().get()
-       << " using TurboFan" << std::endl;
+       << " using " << (info()->is_turboprop() ? "Turboprop" : "TurboFan")
+       << std::endl;
   }
   if (info()->trace_turbo_json_enabled()) {
     TurboCfgFile tcf(isolate());
@@ -2399,6 +2577,11 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
     Run<LoadEliminationPhase>();
     RunPrintAndVerify(LoadEliminationPhase::phase_name());
   }
+
+  if (FLAG_turbo_loop_bounds_check_elimination) {
+    Run<LoopBoundsCheckEliminationPhase>();
+    RunPrintAndVerify(LoopBoundsCheckEliminationPhase::phase_name());
+  }
   data->DeleteTyper();
 
   if (FLAG_turbo_escape) {
@@ -2952,7 +3135,8 @@ void Pipeline::GenerateCodeForWasmFunction(
 
 bool Pipeline::AllocateRegistersForTesting(const RegisterConfiguration* config,
                                            InstructionSequence* sequence,
-                                           bool run_verifier) {
+                                           bool run_verifier,
+                                           bool* fp_allocated_on_worker) {
   OptimizedCompilationInfo info(ArrayVector("testing"), sequence->zone(),
                                 Code::STUB);
   ZoneStats zone_stats(sequence->isolate()->allocator());
@@ -2960,6 +3144,9 @@ bool Pipeline::AllocateRegistersForTesting(const RegisterConfiguration* config,
   data.InitializeFrameData(nullptr);
   PipelineImpl pipeline(&data);
   pipeline.AllocateRegisters(config, nullptr, run_verifier);
+  if (fp_allocated_on_worker != nullptr) {
+    *fp_allocated_on_worker = data.fp_registers_allocated_on_worker();
+  }
   return !data.compilation_failed();
 }
 
@@ -3057,6 +3244,10 @@ bool PipelineImpl::SelectInstructions(Linkage* linkage) {
 
   data->BeginPhaseKind("V8.TFRegisterAllocation");
 
+  // Register allocation, frame elision and jump threading neither read the
+  // heap nor dereference handles.
+  ParkedLocalHeapScope parked_local_heap_scope(data);
+
   bool run_verifier = FLAG_turbo_verify_allocation;
 
   // Allocate registers.
@@ -3355,10 +3546,20 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
     }
   }
 
-  Run<AllocateGeneralRegistersPhase<LinearScanAllocator>>();
+  data->register_allocation_data()->PartitionLiveRangesByKind();
+
+  if (FLAG_turbo_parallel_register_allocation &&
+      !data->info()->trace_turbo_allocation_enabled() &&
+      data->sequence()->HasFPVirtualRegisters() &&
+      data->sequence()->LastInstructionIndex() >=
+          FLAG_turbo_parallel_register_allocation_min_instructions) {
+    Run<AllocateRegistersInParallelPhase<LinearScanAllocator>>();
+  } else {
+    Run<AllocateGeneralRegistersPhase<LinearScanAllocator>>();
 
-  if (data->sequence()->HasFPVirtualRegisters()) {
-    Run<AllocateFPRegistersPhase<LinearScanAllocator>>();
+    if (data->sequence()->HasFPVirtualRegisters()) {
+      Run<AllocateFPRegistersPhase<LinearScanAllocator>>();
+    }
   }
 
   if (info()->is_turbo_preprocess_ranges()) {
@@ -95,10 +95,11 @@ class Pipeline : public AllStatic {
       CallDescriptor* call_descriptor, Graph* graph,
       const AssemblerOptions& options, Schedule* schedule = nullptr);
 
-  // Run just the register allocator phases.
+  // Run just the register allocator phases. {fp_allocated_on_worker} is set
+  // to whether floating point registers were allocated on a worker thread.
   V8_EXPORT_PRIVATE static bool AllocateRegistersForTesting(
       const RegisterConfiguration* config, InstructionSequence* sequence,
-      bool run_verifier);
+      bool run_verifier, bool* fp_allocated_on_worker = nullptr);
 
  private:
   DISALLOW_IMPLICIT_CONSTRUCTORS(Pipeline);
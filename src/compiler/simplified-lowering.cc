@@ -3469,6 +3469,10 @@ class RepresentationSelector {
             node, UseInfo::CheckedHeapObjectAsTaggedPointer(FeedbackSource()),
             MachineRepresentation::kNone);
       }
+      case IrOpcode::kUpdateInterruptBudget: {
+        return VisitUnop(node, UseInfo::AnyTagged(),
+                         MachineRepresentation::kNone);
+      }
       case IrOpcode::kCompareMaps:
         return VisitUnop(
             node, UseInfo::CheckedHeapObjectAsTaggedPointer(FeedbackSource()),
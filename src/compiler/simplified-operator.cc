@@ -619,6 +619,11 @@ AbortReason AbortReasonOf(const Operator* op) {
   return static_cast<AbortReason>(OpParameter<int>(op));
 }
 
+int InterruptBudgetDeltaOf(const Operator* op) {
+  DCHECK_EQ(IrOpcode::kUpdateInterruptBudget, op->opcode());
+  return OpParameter<int>(op);
+}
+
 const CheckTaggedInputParameters& CheckTaggedInputParametersOf(
     const Operator* op) {
   DCHECK(op->opcode() == IrOpcode::kCheckedTruncateTaggedToWord32 ||
@@ -1242,6 +1247,15 @@ const Operator* SimplifiedOperatorBuilder::RuntimeAbort(AbortReason reason) {
       static_cast<int>(reason));                // parameter
 }
 
+const Operator* SimplifiedOperatorBuilder::UpdateInterruptBudget(int delta) {
+  return new (zone()) Operator1<int>(           // --
+      IrOpcode::kUpdateInterruptBudget,         // opcode
+      Operator::kNoThrow | Operator::kNoDeopt,  // flags
+      "UpdateInterruptBudget",                  // name
+      1, 1, 1, 0, 1, 0,                         // counts
+      delta);                                   // parameter
+}
+
 const Operator* SimplifiedOperatorBuilder::BigIntAsUintN(int bits) {
   CHECK(0 <= bits && bits <= 64);
 
@@ -576,6 +576,9 @@ UnicodeEncoding UnicodeEncodingOf(const Operator*) V8_WARN_UNUSED_RESULT;
 
 AbortReason AbortReasonOf(const Operator* op) V8_WARN_UNUSED_RESULT;
 
+// The delta applied by an UpdateInterruptBudget operator.
+int InterruptBudgetDeltaOf(const Operator* op) V8_WARN_UNUSED_RESULT;
+
 DeoptimizeReason DeoptimizeReasonOf(const Operator* op) V8_WARN_UNUSED_RESULT;
 
 int NewArgumentsElementsMappedCountOf(const Operator* op) V8_WARN_UNUSED_RESULT;
@@ -920,6 +923,9 @@ class V8_EXPORT_PRIVATE SimplifiedOperatorBuilder final
 
   const Operator* DateNow();
 
+  // update-interrupt-budget feedback-cell
+  const Operator* UpdateInterruptBudget(int delta);
+
  private:
   Zone* zone() const { return zone_; }
 
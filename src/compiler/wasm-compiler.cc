@@ -170,6 +170,7 @@ WasmGraphBuilder::WasmGraphBuilder(
     : zone_(zone),
       mcgraph_(mcgraph),
       env_(env),
+      bounds_checks_(zone),
       has_simd_(ContainsSimd(sig)),
       untrusted_code_mitigations_(FLAG_untrusted_code_mitigations),
       sig_(sig),
@@ -3528,6 +3529,7 @@ Node* WasmGraphBuilder::BoundsCheckMem(uint8_t access_size, Node* index,
                                        wasm::WasmCodePosition position,
                                        EnforceBoundsCheck enforce_check) {
   DCHECK_LE(1, access_size);
+  Node* const wasm_index = index;
   index = Uint32ToUintptr(index);
   if (FLAG_wasm_no_bounds_checks) return index;
 
@@ -3541,6 +3543,10 @@ Node* WasmGraphBuilder::BoundsCheckMem(uint8_t access_size, Node* index,
     return mcgraph()->IntPtrConstant(0);
   }
   uint64_t end_offset = uint64_t{offset} + access_size - 1u;
+  const bool eliminate_checks = FLAG_wasm_bounds_check_elimination;
+  if (eliminate_checks && HasDominatingBoundsCheck(wasm_index, end_offset)) {
+    return MaskIndexIfMitigated(index);
+  }
   Node* end_offset_node = IntPtrConstant(end_offset);
 
   // The accessed memory is [index + offset, index + end_offset].
@@ -3580,14 +3586,36 @@ Node* WasmGraphBuilder::BoundsCheckMem(uint8_t access_size, Node* index,
   // Introduce the actual bounds check.
   Node* cond = graph()->NewNode(m->UintLessThan(), index, effective_size);
   TrapIfFalse(wasm::kTrapMemOutOfBounds, cond, position);
+  if (eliminate_checks) RecordBoundsCheck(wasm_index, end_offset);
 
-  if (untrusted_code_mitigations_) {
-    // In the fallthrough case, condition the index with the memory mask.
-    Node* mem_mask = instance_cache_->mem_mask;
-    DCHECK_NOT_NULL(mem_mask);
-    index = graph()->NewNode(m->WordAnd(), index, mem_mask);
+  return MaskIndexIfMitigated(index);
+}
+
+Node* WasmGraphBuilder::MaskIndexIfMitigated(Node* index) {
+  if (!untrusted_code_mitigations_) return index;
+  // In the fallthrough case, condition the index with the memory mask.
+  Node* mem_mask = instance_cache_->mem_mask;
+  DCHECK_NOT_NULL(mem_mask);
+  return graph()->NewNode(mcgraph()->machine()->WordAnd(), index, mem_mask);
+}
+
+bool WasmGraphBuilder::HasDominatingBoundsCheck(Node* index,
+                                                uint64_t end_offset) {
+  if (Control() != bounds_checks_control_) {
+    bounds_checks_.clear();
+    return false;
   }
-  return index;
+  // Memory never shrinks, so a check stays valid even if memory grew since.
+  auto it = bounds_checks_.find(index);
+  return it != bounds_checks_.end() && it->second >= end_offset;
+}
+
+void WasmGraphBuilder::RecordBoundsCheck(Node* index, uint64_t end_offset) {
+  // The checks recorded so far precede the new one on the same path, so they
+  // still hold after it.
+  uint64_t& checked_end_offset = bounds_checks_[index];
+  checked_end_offset = std::max(checked_end_offset, end_offset);
+  bounds_checks_control_ = Control();
 }
 
 Node* WasmGraphBuilder::BoundsCheckRange(Node* start, Node** size, Node* max,
@@ -16,6 +16,7 @@
 #include "src/wasm/wasm-module.h"
 #include "src/wasm/wasm-opcodes.h"
 #include "src/wasm/wasm-result.h"
+#include "src/zone/zone-containers.h"
 #include "src/zone/zone.h"
 
 namespace v8 {
@@ -416,6 +417,13 @@ class WasmGraphBuilder {
   Node** effect_ = nullptr;
   WasmInstanceCacheNodes* instance_cache_ = nullptr;
 
+  // Explicit memory bounds checks on the current straight-line path, mapping
+  // the index of an access to the largest end offset checked for it. Only
+  // valid while {Control()} is still {bounds_checks_control_}, i.e. the last
+  // of these checks; any other control node clears them.
+  ZoneMap<Node*, uint64_t> bounds_checks_;
+  Node* bounds_checks_control_ = nullptr;
+
   SetOncePointer<Node> instance_node_;
   SetOncePointer<Node> globals_start_;
   SetOncePointer<Node> imported_mutable_globals_;
@@ -443,6 +451,13 @@ class WasmGraphBuilder {
   // BoundsCheckMem receives a uint32 {index} node and returns a ptrsize index.
   Node* BoundsCheckMem(uint8_t access_size, Node* index, uint32_t offset,
                        wasm::WasmCodePosition, EnforceBoundsCheck);
+  // Whether {index + end_offset} is known to be in bounds because of an
+  // earlier check that dominates the current control.
+  bool HasDominatingBoundsCheck(Node* index, uint64_t end_offset);
+  void RecordBoundsCheck(Node* index, uint64_t end_offset);
+  // Applies the memory mask to an index that passed its bounds check if
+  // untrusted code mitigations are enabled.
+  Node* MaskIndexIfMitigated(Node* index);
   // Check that the range [start, start + size) is in the range [0, max).
   // Also updates *size with the valid range. Returns true if the range is
   // partially out-of-bounds, traps if it is completely out-of-bounds.
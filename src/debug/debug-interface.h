@@ -6,6 +6,7 @@
 #define V8_DEBUG_DEBUG_INTERFACE_H_
 
 #include <memory>
+#include <vector>
 
 #include "include/v8-inspector.h"
 #include "include/v8-util.h"
@@ -383,6 +384,17 @@ class V8_EXPORT_PRIVATE TypeProfile {
   std::shared_ptr<i::TypeProfile> type_profile_;
 };
 
+// Serializes the tiering state and the map-independent type feedback of all
+// functions that have feedback, so that a later run of the same scripts can be
+// warmed up with SetFeedbackProfile.
+V8_EXPORT_PRIVATE std::vector<uint8_t> CollectFeedbackProfile(Isolate* isolate);
+
+// Installs a profile produced by CollectFeedbackProfile. Feedback vectors
+// allocated from now on are seeded from it. Returns false if the profile is
+// malformed or was produced by a different V8 version.
+V8_EXPORT_PRIVATE bool SetFeedbackProfile(Isolate* isolate,
+                                          const uint8_t* data, size_t size);
+
 class V8_EXPORT_PRIVATE ScopeIterator {
  public:
   static std::unique_ptr<ScopeIterator> CreateForFunction(
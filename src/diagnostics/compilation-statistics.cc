@@ -61,7 +61,7 @@ void CompilationStatistics::BasicStats::Accumulate(const BasicStats& stats) {
 static void WriteLine(std::ostream& os, bool machine_format, const char* name,
                       const CompilationStatistics::BasicStats& stats,
                       const CompilationStatistics::BasicStats& total_stats) {
-  const size_t kBufferSize = 128;
+  const size_t kBufferSize = 256;
   char buffer[kBufferSize];
 
   double ms = stats.delta_.InMillisecondsF();
@@ -71,8 +71,10 @@ static void WriteLine(std::ostream& os, bool machine_format, const char* name,
       static_cast<double>(total_stats.total_allocated_bytes_);
   if (machine_format) {
     base::OS::SNPrintF(buffer, kBufferSize,
-                       "\"%s_time\"=%.3f\n\"%s_space\"=%zu", name, ms, name,
-                       stats.total_allocated_bytes_);
+                       "\"%s_time\"=%.3f\n\"%s_space\"=%zu\n"
+                       "\"%s_peak_space\"=%zu",
+                       name, ms, name, stats.total_allocated_bytes_, name,
+                       stats.absolute_max_allocated_bytes_);
     os << buffer;
   } else {
     base::OS::SNPrintF(buffer, kBufferSize,
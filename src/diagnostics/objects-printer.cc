@@ -931,6 +931,7 @@ void FeedbackVector::FeedbackVectorPrint(std::ostream& os) {  // NOLINT
   }
   os << "\n - invocation count: " << invocation_count();
   os << "\n - profiler ticks: " << profiler_ticks();
+  os << "\n - optimization tier: " << optimization_tier();
 
   FeedbackMetadataIterator iter(metadata());
   while (iter.HasNext()) {
@@ -0,0 +1,433 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/execution/feedback-profile.h"
+
+#include <algorithm>
+#include <tuple>
+
+#include "src/execution/isolate.h"
+#include "src/handles/global-handles.h"
+#include "src/heap/heap-inl.h"
+#include "src/objects/feedback-vector-inl.h"
+#include "src/objects/objects-inl.h"
+#include "src/objects/shared-function-info-inl.h"
+#include "src/utils/version.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+const uint8_t kMagic[] = {'V', '8', 'F', 'P'};
+
+// Feedback that consists of a Smi bit set only and therefore can be carried
+// over to another process. All of these kinds only ever widen their feedback
+// by or-ing in new bits.
+bool IsMapIndependentKind(FeedbackSlotKind kind) {
+  return kind == FeedbackSlotKind::kBinaryOp ||
+         kind == FeedbackSlotKind::kCompareOp ||
+         kind == FeedbackSlotKind::kForIn;
+}
+
+class ProfileWriter {
+ public:
+  void WriteBytes(const uint8_t* bytes, size_t size) {
+    data_.insert(data_.end(), bytes, bytes + size);
+  }
+
+  void WriteVarint(uint32_t value) {
+    while (value >= 0x80) {
+      data_.push_back(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    data_.push_back(static_cast<uint8_t>(value));
+  }
+
+  void WriteString(const std::string& value) {
+    WriteVarint(static_cast<uint32_t>(value.size()));
+    WriteBytes(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+  }
+
+  std::vector<uint8_t> Release() { return std::move(data_); }
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+class ProfileReader {
+ public:
+  ProfileReader(const uint8_t* data, size_t size)
+      : position_(data), end_(data + size) {}
+
+  bool ReadBytes(size_t size, const uint8_t** bytes) {
+    if (static_cast<size_t>(end_ - position_) < size) return false;
+    *bytes = position_;
+    position_ += size;
+    return true;
+  }
+
+  bool ReadVarint(uint32_t* value) {
+    uint32_t result = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+      if (position_ == end_) return false;
+      uint8_t byte = *position_++;
+      result |= static_cast<uint32_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) {
+        *value = result;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadInt(int* value) {
+    uint32_t raw;
+    if (!ReadVarint(&raw) || raw > static_cast<uint32_t>(kMaxInt)) {
+      return false;
+    }
+    *value = static_cast<int>(raw);
+    return true;
+  }
+
+  bool ReadString(std::string* value) {
+    uint32_t length;
+    const uint8_t* bytes;
+    if (!ReadVarint(&length) || !ReadBytes(length, &bytes)) return false;
+    value->assign(reinterpret_cast<const char*>(bytes), length);
+    return true;
+  }
+
+  bool AtEnd() const { return position_ == end_; }
+
+ private:
+  const uint8_t* position_;
+  const uint8_t* const end_;
+};
+
+}  // namespace
+
+bool FeedbackProfile::Key::operator<(const Key& other) const {
+  return std::tie(start_position, end_position, script_name) <
+         std::tie(other.start_position, other.end_position, other.script_name);
+}
+
+bool FeedbackProfile::Key::operator==(const Key& other) const {
+  return std::tie(start_position, end_position, script_name) ==
+         std::tie(other.start_position, other.end_position, other.script_name);
+}
+
+FeedbackProfile::~FeedbackProfile() {
+  for (const auto& pair : call_targets_) {
+    if (pair.second != nullptr) GlobalHandles::Destroy(pair.second);
+  }
+  for (const auto& pair : pending_calls_) {
+    if (pair.second.vector != nullptr) {
+      GlobalHandles::Destroy(pair.second.vector);
+    }
+  }
+}
+
+// static
+bool FeedbackProfile::GetKey(SharedFunctionInfo shared, Key* key) {
+  if (!shared.IsUserJavaScript()) return false;
+  Object name = Script::cast(shared.script()).name();
+  if (!name.IsString() || String::cast(name).length() == 0) return false;
+  key->script_name = String::cast(name).ToCString().get();
+  key->start_position = shared.StartPosition();
+  key->end_position = shared.EndPosition();
+  return true;
+}
+
+// static
+std::vector<uint8_t> FeedbackProfile::Collect(Isolate* isolate) {
+  using TargetKind = CallEntry::TargetKind;
+  const MaybeObject megamorphic_sentinel =
+      MaybeObject::FromObject(ReadOnlyRoots(isolate).megamorphic_symbol());
+  std::map<Key, Entry> entries;
+  {
+    HeapObjectIterator iterator(isolate->heap());
+    for (HeapObject obj = iterator.Next(); !obj.is_null();
+         obj = iterator.Next()) {
+      if (!obj.IsFeedbackVector()) continue;
+      FeedbackVector vector = FeedbackVector::cast(obj);
+      SharedFunctionInfo shared = vector.shared_function_info();
+      Key key;
+      if (!GetKey(shared, &key)) continue;
+
+      // Closures of the same function in different contexts have separate
+      // feedback vectors; merge them into a single entry.
+      Entry& entry = entries[key];
+      entry.slot_count = vector.length();
+      entry.profiler_ticks =
+          std::max(entry.profiler_ticks, vector.profiler_ticks());
+      entry.invocation_count =
+          std::max(entry.invocation_count, vector.invocation_count());
+      entry.was_optimized |= vector.has_optimized_code() ||
+                             (shared.HasBytecodeArray() &&
+                              shared.GetBytecodeArray().was_optimized());
+
+      FeedbackMetadata metadata = shared.feedback_metadata();
+      for (int i = 0; i < metadata.slot_count();) {
+        FeedbackSlot slot(i);
+        FeedbackSlotKind kind = metadata.GetKind(slot);
+        i += FeedbackMetadata::GetSlotSize(kind);
+        if (kind == FeedbackSlotKind::kCall) {
+          FeedbackNexus nexus(vector, slot);
+          CallEntry call;
+          call.slot = slot.ToInt();
+          call.call_count = nexus.GetCallCount();
+          MaybeObject feedback = nexus.GetFeedback();
+          HeapObject target;
+          if (feedback == megamorphic_sentinel) {
+            call.target_kind = TargetKind::kMegamorphic;
+          } else if (feedback->GetHeapObjectIfWeak(&target) &&
+                     target.IsJSFunction() &&
+                     GetKey(JSFunction::cast(target).shared(), &call.target)) {
+            call.target_kind = TargetKind::kFunction;
+          }
+          if (call.call_count == 0 && call.target_kind == TargetKind::kNone) {
+            continue;
+          }
+          auto it = std::find_if(
+              entry.calls.begin(), entry.calls.end(),
+              [&](const CallEntry& other) { return other.slot == call.slot; });
+          if (it == entry.calls.end()) {
+            entry.calls.push_back(call);
+            continue;
+          }
+          // Different closures called different targets from here.
+          it->call_count = std::max(it->call_count, call.call_count);
+          if (it->target_kind == TargetKind::kNone) {
+            it->target_kind = call.target_kind;
+            it->target = call.target;
+          } else if (call.target_kind != TargetKind::kNone &&
+                     (it->target_kind != call.target_kind ||
+                      !(it->target == call.target))) {
+            it->target_kind = TargetKind::kMegamorphic;
+          }
+          continue;
+        }
+        if (!IsMapIndependentKind(kind)) continue;
+        int value = vector.Get(slot)->ToSmi().value();
+        if (value == 0) continue;
+        auto it = std::find_if(
+            entry.hints.begin(), entry.hints.end(),
+            [&](const std::pair<int, int>& hint) {
+              return hint.first == slot.ToInt();
+            });
+        if (it == entry.hints.end()) {
+          entry.hints.emplace_back(slot.ToInt(), value);
+        } else {
+          it->second |= value;
+        }
+      }
+    }
+  }
+
+  ProfileWriter writer;
+  writer.WriteBytes(kMagic, sizeof(kMagic));
+  writer.WriteVarint(Version::Hash());
+  writer.WriteVarint(static_cast<uint32_t>(entries.size()));
+  for (const auto& pair : entries) {
+    const Key& key = pair.first;
+    const Entry& entry = pair.second;
+    writer.WriteString(key.script_name);
+    writer.WriteVarint(key.start_position);
+    writer.WriteVarint(key.end_position);
+    writer.WriteVarint(entry.slot_count);
+    writer.WriteVarint(entry.profiler_ticks);
+    writer.WriteVarint(entry.invocation_count);
+    writer.WriteVarint(entry.was_optimized ? 1 : 0);
+    writer.WriteVarint(static_cast<uint32_t>(entry.hints.size()));
+    for (const auto& hint : entry.hints) {
+      writer.WriteVarint(hint.first);
+      writer.WriteVarint(hint.second);
+    }
+    writer.WriteVarint(static_cast<uint32_t>(entry.calls.size()));
+    for (const CallEntry& call : entry.calls) {
+      writer.WriteVarint(call.slot);
+      writer.WriteVarint(call.call_count);
+      writer.WriteVarint(static_cast<uint32_t>(call.target_kind));
+      if (call.target_kind == TargetKind::kFunction) {
+        writer.WriteString(call.target.script_name);
+        writer.WriteVarint(call.target.start_position);
+        writer.WriteVarint(call.target.end_position);
+      }
+    }
+  }
+  return writer.Release();
+}
+
+// static
+std::unique_ptr<FeedbackProfile> FeedbackProfile::Parse(const uint8_t* data,
+                                                        size_t size) {
+  ProfileReader reader(data, size);
+  const uint8_t* magic;
+  if (!reader.ReadBytes(sizeof(kMagic), &magic) ||
+      memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+    return nullptr;
+  }
+  uint32_t version_hash;
+  if (!reader.ReadVarint(&version_hash) || version_hash != Version::Hash()) {
+    return nullptr;
+  }
+
+  using TargetKind = CallEntry::TargetKind;
+  std::unique_ptr<FeedbackProfile> profile(new FeedbackProfile());
+  uint32_t count;
+  if (!reader.ReadVarint(&count)) return nullptr;
+  for (uint32_t i = 0; i < count; i++) {
+    Key key;
+    Entry entry;
+    uint32_t was_optimized;
+    uint32_t hint_count;
+    if (!reader.ReadString(&key.script_name) ||
+        !reader.ReadInt(&key.start_position) ||
+        !reader.ReadInt(&key.end_position) ||
+        !reader.ReadInt(&entry.slot_count) ||
+        !reader.ReadInt(&entry.profiler_ticks) ||
+        !reader.ReadInt(&entry.invocation_count) ||
+        !reader.ReadVarint(&was_optimized) ||
+        !reader.ReadVarint(&hint_count)) {
+      return nullptr;
+    }
+    entry.was_optimized = was_optimized != 0;
+    for (uint32_t j = 0; j < hint_count; j++) {
+      int slot;
+      int value;
+      if (!reader.ReadInt(&slot) || !reader.ReadInt(&value) ||
+          slot >= entry.slot_count || !Smi::IsValid(value)) {
+        return nullptr;
+      }
+      entry.hints.emplace_back(slot, value);
+    }
+    uint32_t call_count;
+    if (!reader.ReadVarint(&call_count)) return nullptr;
+    for (uint32_t j = 0; j < call_count; j++) {
+      CallEntry call;
+      uint32_t target_kind;
+      // Call slots have an extra element for the call count.
+      if (!reader.ReadInt(&call.slot) || !reader.ReadInt(&call.call_count) ||
+          !reader.ReadVarint(&target_kind) ||
+          call.slot >= entry.slot_count - 1 ||
+          !FeedbackNexus::CallCountField::is_valid(
+              static_cast<uint32_t>(call.call_count)) ||
+          target_kind > static_cast<uint32_t>(TargetKind::kMegamorphic)) {
+        return nullptr;
+      }
+      call.target_kind = static_cast<TargetKind>(target_kind);
+      if (call.target_kind == TargetKind::kFunction) {
+        if (!reader.ReadString(&call.target.script_name) ||
+            !reader.ReadInt(&call.target.start_position) ||
+            !reader.ReadInt(&call.target.end_position)) {
+          return nullptr;
+        }
+        profile->call_targets_.emplace(call.target, nullptr);
+      }
+      entry.calls.push_back(std::move(call));
+    }
+    profile->entries_.emplace(std::move(key), std::move(entry));
+  }
+  if (!reader.AtEnd()) return nullptr;
+  return profile;
+}
+
+void FeedbackProfile::Apply(Isolate* isolate, Handle<JSFunction> function) {
+  using TargetKind = CallEntry::TargetKind;
+  DisallowHeapAllocation no_gc;
+  SharedFunctionInfo shared = function->shared();
+  FeedbackVector vector = function->feedback_vector();
+  Key key;
+  if (!GetKey(shared, &key)) return;
+
+  // Remember the closure if it is a call target, and seed the calls that
+  // have been waiting for it. The first closure of a function that gets a
+  // feedback vector stands in for all of them.
+  auto target = call_targets_.find(key);
+  if (target != call_targets_.end() && target->second == nullptr) {
+    target->second = isolate->global_handles()->Create(*function).location();
+    GlobalHandles::MakeWeak(&target->second);
+    const MaybeObject uninitialized_sentinel =
+        MaybeObject::FromObject(ReadOnlyRoots(isolate).uninitialized_symbol());
+    auto pending = pending_calls_.equal_range(key);
+    for (auto it = pending.first; it != pending.second; ++it) {
+      if (it->second.vector == nullptr) continue;
+      FeedbackNexus nexus(FeedbackVector::cast(Object(*it->second.vector)),
+                          FeedbackSlot(it->second.slot));
+      // Keep the feedback the call collected in the meantime.
+      if (nexus.GetFeedback() == uninitialized_sentinel) {
+        nexus.SetFeedback(HeapObjectReference::Weak(*function));
+      }
+      GlobalHandles::Destroy(it->second.vector);
+    }
+    pending_calls_.erase(pending.first, pending.second);
+  }
+
+  auto it = entries_.find(key);
+  if (it == entries_.end()) return;
+  const Entry& entry = it->second;
+
+  // The script may have changed since the profile was taken without its name
+  // changing. Only trust the entry if the feedback layout still matches.
+  if (entry.slot_count != vector.length()) return;
+  FeedbackMetadata metadata = shared.feedback_metadata();
+  for (const auto& hint : entry.hints) {
+    if (!IsMapIndependentKind(metadata.GetKind(FeedbackSlot(hint.first)))) {
+      return;
+    }
+  }
+  for (const CallEntry& call : entry.calls) {
+    if (metadata.GetKind(FeedbackSlot(call.slot)) != FeedbackSlotKind::kCall) {
+      return;
+    }
+  }
+
+  vector.set_profiler_ticks(entry.profiler_ticks);
+  vector.set_invocation_count(entry.invocation_count);
+  if (entry.was_optimized && shared.HasBytecodeArray()) {
+    shared.GetBytecodeArray().set_was_optimized(true);
+  }
+  for (const auto& hint : entry.hints) {
+    vector.Set(FeedbackSlot(hint.first),
+               MaybeObject::FromSmi(Smi::FromInt(hint.second)),
+               SKIP_WRITE_BARRIER);
+  }
+  // Call counts are restored together with the invocation count, so that the
+  // call frequencies used for inlining decisions stay the same.
+  for (const CallEntry& call : entry.calls) {
+    FeedbackNexus nexus(vector, FeedbackSlot(call.slot));
+    nexus.SetFeedbackExtra(
+        Smi::FromInt(static_cast<int>(
+            FeedbackNexus::CallCountField::encode(call.call_count))),
+        SKIP_WRITE_BARRIER);
+    switch (call.target_kind) {
+      case TargetKind::kNone:
+        break;
+      case TargetKind::kMegamorphic:
+        nexus.SetFeedback(ReadOnlyRoots(isolate).megamorphic_symbol(),
+                          SKIP_WRITE_BARRIER);
+        break;
+      case TargetKind::kFunction: {
+        Address* target_location = call_targets_.at(call.target);
+        if (target_location != nullptr) {
+          nexus.SetFeedback(HeapObjectReference::Weak(
+              JSFunction::cast(Object(*target_location))));
+          break;
+        }
+        PendingCall pending_call;
+        pending_call.vector =
+            isolate->global_handles()->Create(vector).location();
+        pending_call.slot = call.slot;
+        auto pending =
+            pending_calls_.emplace(call.target, std::move(pending_call));
+        GlobalHandles::MakeWeak(&pending->second.vector);
+        break;
+      }
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
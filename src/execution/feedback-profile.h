@@ -0,0 +1,112 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_EXECUTION_FEEDBACK_PROFILE_H_
+#define V8_EXECUTION_FEEDBACK_PROFILE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/common/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class Isolate;
+class JSFunction;
+class SharedFunctionInfo;
+template <typename T>
+class Handle;
+
+// Tiering state and type feedback of the functions of a previous run, used to
+// warm up a new process. Functions are identified by the name of their script
+// and their source range, so a profile survives restarts as long as the
+// scripts are unchanged.
+//
+// Recorded are the invocation counts, the hints of binary operations, compare
+// operations and for-in, and the call counts and targets of calls. Call
+// targets are recorded by the key of their function and resolved to the
+// closure of that function in the new process. Feedback that refers to maps
+// or allocation sites has no meaning in another process and is collected
+// anew. Functions that were optimized in the previous run are optimized as
+// soon as the runtime profiler sees them in the new one.
+class FeedbackProfile {
+ public:
+  ~FeedbackProfile();
+
+  // Serializes the profile of all functions that currently have a feedback
+  // vector.
+  V8_EXPORT_PRIVATE static std::vector<uint8_t> Collect(Isolate* isolate);
+
+  // Parses a profile produced by Collect(). Returns nullptr if the data is
+  // malformed or was produced by a different V8 version.
+  V8_EXPORT_PRIVATE static std::unique_ptr<FeedbackProfile> Parse(
+      const uint8_t* data, size_t size);
+
+  // Seeds the freshly allocated feedback vector of {function} from the
+  // recorded entry of its function, if there is one. Entries whose feedback
+  // layout does not match the function anymore are ignored.
+  //
+  // A call target is only known once its closure got a feedback vector. Calls
+  // whose target has not got one yet are seeded when it does, unless they
+  // collected feedback of their own in the meantime.
+  void Apply(Isolate* isolate, Handle<JSFunction> function);
+
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct Key {
+    std::string script_name;
+    int start_position;
+    int end_position;
+
+    bool operator<(const Key& other) const;
+    bool operator==(const Key& other) const;
+  };
+
+  struct CallEntry {
+    enum class TargetKind : uint8_t { kNone, kFunction, kMegamorphic };
+
+    int slot = 0;
+    int call_count = 0;
+    TargetKind target_kind = TargetKind::kNone;
+    // Only used for TargetKind::kFunction.
+    Key target;
+  };
+
+  struct Entry {
+    int slot_count = 0;
+    int profiler_ticks = 0;
+    int invocation_count = 0;
+    bool was_optimized = false;
+    // Pairs of slot index and Smi feedback value.
+    std::vector<std::pair<int, int>> hints;
+    std::vector<CallEntry> calls;
+  };
+
+  // A call whose target did not have a feedback vector yet when the vector of
+  // the calling function was allocated.
+  struct PendingCall {
+    // Weak global handle to the feedback vector of the calling function. It
+    // is reset once the vector dies.
+    Address* vector = nullptr;
+    int slot = 0;
+  };
+
+  static bool GetKey(SharedFunctionInfo shared, Key* key);
+
+  std::map<Key, Entry> entries_;
+  // Weak global handles to the closures of all recorded call targets, or
+  // nullptr until the first closure of a target got its feedback vector or
+  // after it died.
+  std::map<Key, Address*> call_targets_;
+  std::multimap<Key, PendingCall> pending_calls_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_EXECUTION_FEEDBACK_PROFILE_H_
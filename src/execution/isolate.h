@@ -85,6 +85,8 @@ class MaterializedObjectStore;
 class Microtask;
 class MicrotaskQueue;
 class OptimizingCompileDispatcher;
+class FeedbackProfile;
+class PersistentHandlesList;
 class ReadOnlyDeserializer;
 class RegExpStack;
 class RootVisitor;
@@ -1187,6 +1189,15 @@ class Isolate final : private HiddenFactory {
   void LinkDeferredHandles(DeferredHandles* deferred_handles);
   void UnlinkDeferredHandles(DeferredHandles* deferred_handles);
 
+  PersistentHandlesList* persistent_handles_list() {
+    return persistent_handles_list_.get();
+  }
+
+  // Profile of an earlier run that newly allocated feedback vectors are seeded
+  // from, or nullptr.
+  FeedbackProfile* feedback_profile() const { return feedback_profile_.get(); }
+  void set_feedback_profile(std::unique_ptr<FeedbackProfile> profile);
+
 #ifdef DEBUG
   bool IsDeferredHandle(Address* location);
 #endif  // DEBUG
@@ -1726,6 +1737,8 @@ class Isolate final : private HiddenFactory {
 #endif
 
   DeferredHandles* deferred_handles_head_ = nullptr;
+  std::unique_ptr<PersistentHandlesList> persistent_handles_list_;
+  std::unique_ptr<FeedbackProfile> feedback_profile_;
   OptimizingCompileDispatcher* optimizing_compile_dispatcher_ = nullptr;
 
   // Counts deopt points if deopt_every_n_times is enabled.
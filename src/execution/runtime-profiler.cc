@@ -23,6 +23,19 @@ namespace internal {
 // optimized.
 static const int kProfilerTicksBeforeOptimization = 2;
 
+// Number of times a function has to be seen on the stack before it is
+// optimized if it was already optimized when its code cache was created (see
+// --code-cache-optimization-hints) or when the installed feedback profile was
+// collected. The function was hot in an earlier run, so we only wait for
+// enough feedback to be collected.
+static const int kProfilerTicksBeforeHintedOptimization = 1;
+
+// Number of times a function has to be seen on the stack before it is
+// optimized with the mid tier (see --turboprop-mid-tier). The mid tier is much
+// cheaper to compile for, so we get there early and let the mid-tier code
+// collect the ticks for the tier-up to TurboFan.
+static const int kProfilerTicksBeforeMidTierOptimization = 1;
+
 // The number of ticks required for optimizing a function increases with
 // the size of the bytecode. This is in addition to the
 // kProfilerTicksBeforeOptimization required for any function.
@@ -37,10 +50,11 @@ static const int kOSRBytecodeSizeAllowancePerTick = 48;
 // the very first time it is seen on the stack.
 static const int kMaxBytecodeSizeForEarlyOpt = 90;
 
-#define OPTIMIZATION_REASON_LIST(V)   \
-  V(DoNotOptimize, "do not optimize") \
-  V(HotAndStable, "hot and stable")   \
-  V(SmallFunction, "small function")
+#define OPTIMIZATION_REASON_LIST(V)              \
+  V(DoNotOptimize, "do not optimize")            \
+  V(HotAndStable, "hot and stable")              \
+  V(SmallFunction, "small function")             \
+  V(PreviouslyOptimized, "previously optimized")
 
 enum class OptimizationReason : uint8_t {
 #define OPTIMIZATION_REASON_CONSTANTS(Constant, message) k##Constant,
@@ -173,11 +187,22 @@ bool RuntimeProfiler::MaybeOSR(JSFunction function, InterpretedFrame* frame) {
 OptimizationReason RuntimeProfiler::ShouldOptimize(JSFunction function,
                                                    BytecodeArray bytecode) {
   int ticks = function.feedback_vector().profiler_ticks();
+  int ticks_before_optimization = kProfilerTicksBeforeOptimization;
+  if (FLAG_turboprop_mid_tier &&
+      function.feedback_vector().optimization_tier() ==
+          OptimizationTier::kNone) {
+    ticks_before_optimization = kProfilerTicksBeforeMidTierOptimization;
+  }
   int ticks_for_optimization =
-      kProfilerTicksBeforeOptimization +
+      ticks_before_optimization +
       (bytecode.length() / kBytecodeSizeAllowancePerTick);
   if (ticks >= ticks_for_optimization) {
     return OptimizationReason::kHotAndStable;
+  } else if ((FLAG_code_cache_optimization_hints ||
+              isolate_->feedback_profile() != nullptr) &&
+             bytecode.was_optimized() &&
+             ticks >= kProfilerTicksBeforeHintedOptimization) {
+    return OptimizationReason::kPreviouslyOptimized;
   } else if (!any_ic_changed_ &&
              bytecode.length() < kMaxBytecodeSizeForEarlyOpt) {
     // If no IC was patched since the last tick and this function is very
@@ -187,7 +212,7 @@ OptimizationReason RuntimeProfiler::ShouldOptimize(JSFunction function,
     PrintF("[not yet optimizing ");
     function.PrintName();
     PrintF(", not enough ticks: %d/%d and ", ticks,
-           kProfilerTicksBeforeOptimization);
+           ticks_before_optimization);
     if (any_ic_changed_) {
       PrintF("ICs changed]\n");
     } else {
@@ -198,6 +223,56 @@ OptimizationReason RuntimeProfiler::ShouldOptimize(JSFunction function,
   return OptimizationReason::kDoNotOptimize;
 }
 
+void RuntimeProfiler::MaybeTierUpFromMidTier(JSFunction function) {
+  if (!function.has_feedback_vector()) return;
+  FeedbackVector vector = function.feedback_vector();
+  Code interpreter_entry_trampoline =
+      isolate_->builtins()->builtin(Builtins::kInterpreterEntryTrampoline);
+
+  if (vector.optimization_tier() == OptimizationTier::kTopTier) {
+    // Another closure sharing the feedback vector already tiered up, but this
+    // one still calls into the mid-tier code directly. Go through the
+    // trampoline on the next call, which installs the cached TurboFan code.
+    if (vector.has_optimized_code() &&
+        function.code() != vector.optimized_code()) {
+      function.set_code(interpreter_entry_trampoline);
+    }
+    return;
+  }
+  if (vector.optimization_tier() != OptimizationTier::kMidTier) return;
+  if (function.shared().optimization_disabled()) return;
+
+  if (FLAG_testing_d8_test_runner &&
+      !PendingOptimizationTable::IsHeuristicOptimizationAllowed(isolate_,
+                                                                function)) {
+    return;
+  }
+
+  int ticks = vector.profiler_ticks();
+  int ticks_for_optimization =
+      kProfilerTicksBeforeOptimization +
+      (function.shared().GetBytecodeArray().length() /
+       kBytecodeSizeAllowancePerTick);
+  if (ticks < ticks_for_optimization) {
+    if (FLAG_trace_opt_verbose) {
+      PrintF("[not yet tiering up ");
+      function.PrintName();
+      PrintF(", not enough ticks: %d/%d]\n", ticks, ticks_for_optimization);
+    }
+    if (ticks < Smi::kMaxValue) vector.set_profiler_ticks(ticks + 1);
+    return;
+  }
+
+  // Drop the mid-tier code so that the next call enters the interpreter entry
+  // trampoline again, which picks up the optimization marker and eventually
+  // the TurboFan code. Frames currently running mid-tier code are unaffected.
+  if (vector.has_optimized_code()) vector.ClearOptimizedCode();
+  function.set_code(interpreter_entry_trampoline);
+  if (!function.IsInOptimizationQueue()) {
+    Optimize(function, OptimizationReason::kHotAndStable);
+  }
+}
+
 void RuntimeProfiler::MarkCandidatesForOptimization() {
   HandleScope scope(isolate_);
 
@@ -215,6 +290,10 @@ void RuntimeProfiler::MarkCandidatesForOptimization() {
   for (JavaScriptFrameIterator it(isolate_);
        frame_count++ < frame_count_limit && !it.done(); it.Advance()) {
     JavaScriptFrame* frame = it.frame();
+    if (FLAG_turboprop_mid_tier && frame->is_optimized()) {
+      MaybeTierUpFromMidTier(frame->function());
+      continue;
+    }
     if (!frame->is_interpreted()) continue;
 
     JSFunction function = frame->function();
@@ -35,6 +35,9 @@ class RuntimeProfiler {
   OptimizationReason ShouldOptimize(JSFunction function,
                                     BytecodeArray bytecode_array);
   void Optimize(JSFunction function, OptimizationReason reason);
+  // Tiers up functions running mid-tier optimized code to TurboFan once they
+  // got hot enough (see --turboprop-mid-tier).
+  void MaybeTierUpFromMidTier(JSFunction function);
   void Baseline(JSFunction function, OptimizationReason reason);
 
   Isolate* isolate_;
@@ -486,6 +486,11 @@ DEFINE_BOOL(turboprop, false,
 DEFINE_NEG_IMPLICATION(turboprop, turbo_inlining)
 DEFINE_IMPLICATION(turboprop, concurrent_inlining)
 DEFINE_VALUE_IMPLICATION(turboprop, interrupt_budget, 10 * KB)
+DEFINE_BOOL(turboprop_mid_tier, false,
+            "compile hot functions with turboprop first and tier up to "
+            "turbofan once the turboprop code gets hot")
+DEFINE_NEG_IMPLICATION(turboprop_mid_tier, turboprop)
+DEFINE_IMPLICATION(turboprop_mid_tier, concurrent_inlining)
 
 // Flags for concurrent recompilation.
 DEFINE_BOOL(concurrent_recompilation, true,
@@ -501,6 +506,11 @@ DEFINE_BOOL(block_concurrent_recompilation, false,
 DEFINE_BOOL(concurrent_inlining, false,
             "run optimizing compiler's inlining phase on a separate thread")
 DEFINE_IMPLICATION(future, concurrent_inlining)
+DEFINE_BOOL(turbo_direct_heap_access, false,
+            "access immutable heap objects directly from the compiler's "
+            "background thread instead of serializing them")
+DEFINE_IMPLICATION(turbo_direct_heap_access, concurrent_inlining)
+DEFINE_IMPLICATION(turbo_direct_heap_access, local_heaps)
 DEFINE_BOOL(trace_heap_broker_verbose, false,
             "trace the heap broker verbosely (all reports)")
 DEFINE_BOOL(trace_heap_broker_memory, false,
@@ -522,6 +532,14 @@ DEFINE_BOOL(turbo_sp_frame_access, false,
             "use stack pointer-relative access to frame wherever possible")
 DEFINE_BOOL(turbo_control_flow_aware_allocation, true,
             "consider control flow while allocating registers")
+DEFINE_BOOL(turbo_parallel_register_allocation, false,
+            "allocate general and floating point registers in parallel")
+DEFINE_INT(turbo_parallel_register_allocation_min_instructions, 5000,
+           "minimum number of instructions for allocating registers in "
+           "parallel")
+DEFINE_BOOL(stress_parallel_register_allocation, false,
+            "always allocate floating point registers on a worker thread "
+            "when allocating registers in parallel (for testing)")
 
 DEFINE_STRING(turbo_filter, "*", "optimization filter for TurboFan compiler")
 DEFINE_BOOL(trace_turbo, false, "trace generated TurboFan IR")
@@ -615,6 +633,9 @@ DEFINE_BOOL(turbo_move_optimization, true, "optimize gap moves in TurboFan")
 DEFINE_BOOL(turbo_jt, true, "enable jump threading in TurboFan")
 DEFINE_BOOL(turbo_loop_peeling, true, "Turbofan loop peeling")
 DEFINE_BOOL(turbo_loop_variable, true, "Turbofan loop variable optimization")
+DEFINE_BOOL(turbo_loop_bounds_check_elimination, true,
+            "eliminate bounds checks on induction variables that are "
+            "known to be in range")
 DEFINE_BOOL(turbo_loop_rotation, true, "Turbofan loop rotation")
 DEFINE_BOOL(turbo_cf_optimization, true, "optimize control flow in TurboFan")
 DEFINE_BOOL(turbo_escape, true, "enable escape analysis")
@@ -686,6 +707,13 @@ DEFINE_BOOL(
 DEFINE_IMPLICATION(future, wasm_tier_up)
 #endif
 DEFINE_IMPLICATION(wasm_tier_up, liftoff)
+DEFINE_BOOL(wasm_dynamic_tiering, false,
+            "only tier up wasm functions to the optimizing compiler once they "
+            "are hot, instead of recompiling all functions in the background")
+DEFINE_INT(wasm_tiering_budget, 1800,
+           "number of function entries and loop iterations of a wasm function "
+           "in Liftoff code before it is tiered up (with "
+           "--wasm-dynamic-tiering)")
 DEFINE_DEBUG_BOOL(trace_wasm_decoder, false, "trace decoding of wasm code")
 DEFINE_DEBUG_BOOL(trace_wasm_compiler, false, "trace compiling of wasm code")
 DEFINE_DEBUG_BOOL(trace_wasm_interpreter, false,
@@ -718,6 +746,13 @@ DEFINE_BOOL(stress_validate_asm, false, "try to validate everything as asm.js")
 DEFINE_DEBUG_BOOL(dump_wasm_module, false, "dump wasm module bytes")
 DEFINE_STRING(dump_wasm_module_path, nullptr,
               "directory to dump wasm modules to")
+DEFINE_BOOL(wasm_native_module_cache, false,
+            "share compiled wasm modules with identical wire bytes between all "
+            "isolates of the process")
+DEFINE_STRING(wasm_code_cache_dir, nullptr,
+              "directory to cache compiled wasm modules in across processes; "
+              "code loaded from there is executed without being verified, so "
+              "the directory must be trusted and only be writable by V8")
 
 // Declare command-line flags for WASM features. Warning: avoid using these
 // flags directly in the implementation. Instead accept wasm::WasmFeatures
@@ -740,6 +775,9 @@ FOREACH_WASM_STAGING_FEATURE_FLAG(WASM_STAGING_IMPLICATION)
 DEFINE_BOOL(wasm_opt, false, "enable wasm optimization")
 DEFINE_BOOL(wasm_no_bounds_checks, false,
             "disable bounds checks (performance testing only)")
+DEFINE_BOOL(wasm_bounds_check_elimination, true,
+            "omit explicit memory bounds checks in wasm code that are implied "
+            "by a preceding check of the same index")
 DEFINE_BOOL(wasm_no_stack_checks, false,
             "disable stack checks (performance testing only)")
 DEFINE_BOOL(wasm_math_intrinsics, true,
@@ -768,6 +806,9 @@ DEFINE_BOOL(wasm_atomics_on_non_shared_memory, false,
             "allow atomic operations on non-shared WebAssembly memory")
 DEFINE_BOOL(wasm_lazy_validation, false,
             "enable lazy validation for lazily compiled wasm functions")
+DEFINE_BOOL(wasm_lazy_deserialization, false,
+            "keep serialized wasm code and only relocate each function when "
+            "it is first called")
 // wasm-interpret-all resets {asm-,}wasm-lazy-compilation.
 DEFINE_NEG_IMPLICATION(wasm_interpret_all, asm_wasm_lazy_compilation)
 DEFINE_NEG_IMPLICATION(wasm_interpret_all, wasm_lazy_compilation)
@@ -888,9 +929,20 @@ DEFINE_BOOL(trace_concurrent_marking, false, "trace concurrent marking")
 DEFINE_BOOL(concurrent_store_buffer, true,
             "use concurrent store buffer processing")
 DEFINE_BOOL(concurrent_sweeping, true, "use concurrent sweeping")
+DEFINE_BOOL(concurrent_large_object_sweeping, true,
+            "release dead large object pages on the sweeper tasks")
 DEFINE_BOOL(parallel_compaction, true, "use parallel compaction")
 DEFINE_BOOL(parallel_pointer_update, true,
             "use parallel pointer update during compaction")
+DEFINE_BOOL(numa_aware_heap, false,
+            "bind heap pages to the NUMA node of the allocating thread and "
+            "let parallel GC tasks prefer work items on their own node")
+DEFINE_BOOL(transparent_huge_pages, false,
+            "place old and map space pages in 2MB-aligned blocks and "
+            "back them with transparent huge pages where possible")
+DEFINE_BOOL(local_heaps, false,
+            "allow background threads to allocate in old space through "
+            "local heaps")
 DEFINE_BOOL(detect_ineffective_gcs_near_heap_limit, true,
             "trigger out-of-memory failure to avoid GC storm near heap limit")
 DEFINE_BOOL(trace_incremental_marking, false,
@@ -942,6 +994,9 @@ DEFINE_BOOL(always_compact, false, "Perform compaction on every full GC")
 DEFINE_BOOL(never_compact, false,
             "Never perform compaction on full GC - testing only")
 DEFINE_BOOL(compact_code_space, true, "Compact code space on full collections")
+DEFINE_INT(evacuation_pause_budget, 0,
+           "limits the time (in ms) spent on evacuating old generation pages "
+           "in the atomic pause, 0 means no limit")
 DEFINE_BOOL(flush_bytecode, true,
             "flush of bytecode when it has not been executed recently")
 DEFINE_BOOL(stress_flush_bytecode, false, "stress bytecode flushing")
@@ -1100,6 +1155,9 @@ DEFINE_BOOL(always_osr, false, "always try to OSR functions")
 DEFINE_BOOL(prepare_always_opt, false, "prepare for turning on always opt")
 
 DEFINE_BOOL(trace_serializer, false, "print code serializer trace")
+DEFINE_BOOL(code_cache_optimization_hints, false,
+            "optimize functions early that were optimized when the code cache "
+            "was created")
 #ifdef DEBUG
 DEFINE_BOOL(external_reference_stats, false,
             "print statistics on external references used during serialization")
@@ -1154,6 +1212,9 @@ DEFINE_BOOL(heap_profiler_use_embedder_graph, true,
             "Use the new EmbedderGraph API to get embedder nodes")
 DEFINE_INT(heap_snapshot_string_limit, 1024,
            "truncate strings to this length in the heap snapshot")
+DEFINE_BOOL(parallel_heap_snapshot_serialization, false,
+            "format heap snapshot nodes and edges on worker threads while "
+            "writing them to the output stream")
 
 // sampling-heap-profiler.cc
 DEFINE_BOOL(sampling_heap_profiler_suppress_randomness, false,
@@ -1330,6 +1391,11 @@ DEFINE_BOOL(minor_mc_parallel_marking, true,
 DEFINE_BOOL(trace_minor_mc_parallel_marking, false,
             "trace parallel marking for the young generation")
 DEFINE_BOOL(minor_mc, false, "perform young generation mark compact GCs")
+DEFINE_BOOL(minor_mc_concurrent_marking, false,
+            "mark the young generation concurrently to the mutator")
+DEFINE_IMPLICATION(minor_mc_concurrent_marking, minor_mc)
+DEFINE_BOOL(trace_minor_mc_concurrent_marking, false,
+            "trace concurrent marking for the young generation")
 #endif  // ENABLE_MINOR_MC
 
 //
@@ -1614,6 +1680,7 @@ DEFINE_NEG_IMPLICATION(single_threaded, compiler_dispatcher)
 DEFINE_BOOL(single_threaded_gc, false, "disable the use of background gc tasks")
 DEFINE_NEG_IMPLICATION(single_threaded_gc, concurrent_marking)
 DEFINE_NEG_IMPLICATION(single_threaded_gc, concurrent_sweeping)
+DEFINE_NEG_IMPLICATION(single_threaded_gc, concurrent_large_object_sweeping)
 DEFINE_NEG_IMPLICATION(single_threaded_gc, parallel_compaction)
 DEFINE_NEG_IMPLICATION(single_threaded_gc, parallel_marking)
 DEFINE_NEG_IMPLICATION(single_threaded_gc, parallel_pointer_update)
@@ -1621,6 +1688,7 @@ DEFINE_NEG_IMPLICATION(single_threaded_gc, parallel_scavenge)
 DEFINE_NEG_IMPLICATION(single_threaded_gc, concurrent_store_buffer)
 #ifdef ENABLE_MINOR_MC
 DEFINE_NEG_IMPLICATION(single_threaded_gc, minor_mc_parallel_marking)
+DEFINE_NEG_IMPLICATION(single_threaded_gc, minor_mc_concurrent_marking)
 #endif  // ENABLE_MINOR_MC
 DEFINE_NEG_IMPLICATION(single_threaded_gc, concurrent_array_buffer_freeing)
 
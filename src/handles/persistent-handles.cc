@@ -0,0 +1,104 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/handles/persistent-handles.h"
+
+#include "src/execution/isolate.h"
+#include "src/objects/visitors.h"
+
+namespace v8 {
+namespace internal {
+
+PersistentHandles::PersistentHandles(Isolate* isolate)
+    : isolate_(isolate),
+      block_next_(nullptr),
+      block_limit_(nullptr),
+      prev_(nullptr),
+      next_(nullptr) {
+  isolate_->persistent_handles_list()->Add(this);
+}
+
+PersistentHandles::~PersistentHandles() {
+  isolate_->persistent_handles_list()->Remove(this);
+
+  for (Address* block_start : blocks_) {
+    DeleteArray(block_start);
+  }
+}
+
+void PersistentHandles::AddBlock() {
+  DCHECK_EQ(block_next_, block_limit_);
+
+  Address* block_start = NewArray<Address>(kBlockSize);
+  blocks_.push_back(block_start);
+
+  block_next_ = block_start;
+  block_limit_ = block_start + kBlockSize;
+}
+
+Address* PersistentHandles::GetHandle(Address value) {
+  if (block_next_ == block_limit_) {
+    AddBlock();
+  }
+
+  DCHECK_LT(block_next_, block_limit_);
+  *block_next_ = value;
+  return block_next_++;
+}
+
+void PersistentHandles::Iterate(RootVisitor* visitor) {
+  if (blocks_.empty()) return;
+
+  // All blocks but the last one are completely filled.
+  for (size_t i = 0; i < blocks_.size() - 1; i++) {
+    Address* block_start = blocks_[i];
+    Address* block_end = block_start + kBlockSize;
+    visitor->VisitRootPointers(Root::kHandleScope, nullptr,
+                               FullObjectSlot(block_start),
+                               FullObjectSlot(block_end));
+  }
+
+  visitor->VisitRootPointers(Root::kHandleScope, nullptr,
+                             FullObjectSlot(blocks_.back()),
+                             FullObjectSlot(block_next_));
+}
+
+int PersistentHandles::NumberOfHandles() const {
+  if (blocks_.empty()) return 0;
+  return static_cast<int>((blocks_.size() - 1) * kBlockSize +
+                          (block_next_ - blocks_.back()));
+}
+
+void PersistentHandlesList::Add(PersistentHandles* persistent_handles) {
+  base::MutexGuard guard(&persistent_handles_mutex_);
+  if (persistent_handles_head_) {
+    persistent_handles_head_->prev_ = persistent_handles;
+  }
+  persistent_handles->prev_ = nullptr;
+  persistent_handles->next_ = persistent_handles_head_;
+  persistent_handles_head_ = persistent_handles;
+}
+
+void PersistentHandlesList::Remove(PersistentHandles* persistent_handles) {
+  base::MutexGuard guard(&persistent_handles_mutex_);
+  if (persistent_handles->next_) {
+    persistent_handles->next_->prev_ = persistent_handles->prev_;
+  }
+  if (persistent_handles->prev_) {
+    persistent_handles->prev_->next_ = persistent_handles->next_;
+  } else {
+    persistent_handles_head_ = persistent_handles->next_;
+  }
+}
+
+void PersistentHandlesList::Iterate(RootVisitor* visitor) {
+  base::MutexGuard guard(&persistent_handles_mutex_);
+  for (PersistentHandles* current = persistent_handles_head_; current;
+       current = current->next_) {
+    current->Iterate(visitor);
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,87 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HANDLES_PERSISTENT_HANDLES_H_
+#define V8_HANDLES_PERSISTENT_HANDLES_H_
+
+#include <vector>
+
+#include "src/base/platform/mutex.h"
+#include "src/handles/handles.h"
+#include "src/objects/objects.h"
+
+namespace v8 {
+namespace internal {
+
+class PersistentHandlesList;
+class RootVisitor;
+
+// Container for handles that are created on a background thread, e.g. by the
+// optimizing compiler. Unlike handles in a HandleScope, persistent handles are
+// not tied to the handle scope data of the isolate and stay alive as long as
+// the container does. Every container is registered with the isolate, so the
+// GC treats its handles as strong roots.
+//
+// New handles may only be created on the main thread or on a background
+// thread whose LocalHeap is running, which guarantees that the GC does not
+// visit the container while it is being modified.
+class PersistentHandles {
+ public:
+  V8_EXPORT_PRIVATE explicit PersistentHandles(Isolate* isolate);
+  V8_EXPORT_PRIVATE ~PersistentHandles();
+
+  PersistentHandles(const PersistentHandles&) = delete;
+  PersistentHandles& operator=(const PersistentHandles&) = delete;
+
+  template <typename T>
+  Handle<T> NewHandle(T obj) {
+    return Handle<T>(GetHandle(obj.ptr()));
+  }
+
+  void Iterate(RootVisitor* visitor);
+
+  V8_EXPORT_PRIVATE int NumberOfHandles() const;
+
+  Isolate* isolate() const { return isolate_; }
+
+ private:
+  static const int kBlockSize = 256;
+
+  V8_EXPORT_PRIVATE Address* GetHandle(Address value);
+  void AddBlock();
+
+  Isolate* const isolate_;
+  std::vector<Address*> blocks_;
+
+  Address* block_next_;
+  Address* block_limit_;
+
+  PersistentHandles* prev_;
+  PersistentHandles* next_;
+
+  friend class PersistentHandlesList;
+};
+
+// All PersistentHandles of an isolate, linked into a list that is guarded by
+// a mutex since containers are added and removed on background threads.
+class PersistentHandlesList {
+ public:
+  PersistentHandlesList() : persistent_handles_head_(nullptr) {}
+
+  void Iterate(RootVisitor* visitor);
+
+ private:
+  void Add(PersistentHandles* persistent_handles);
+  void Remove(PersistentHandles* persistent_handles);
+
+  base::Mutex persistent_handles_mutex_;
+  PersistentHandles* persistent_handles_head_;
+
+  friend class PersistentHandles;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HANDLES_PERSISTENT_HANDLES_H_
@@ -0,0 +1,39 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_CONCURRENT_ALLOCATOR_INL_H_
+#define V8_HEAP_CONCURRENT_ALLOCATOR_INL_H_
+
+#include "src/heap/concurrent-allocator.h"
+
+#include "src/heap/heap.h"
+#include "src/heap/spaces-inl.h"
+
+namespace v8 {
+namespace internal {
+
+AllocationResult ConcurrentAllocator::Allocate(int object_size,
+                                               AllocationAlignment alignment,
+                                               AllocationOrigin origin) {
+  if (object_size > kMaxLabObjectSize) {
+    return AllocateOutsideLab(object_size, alignment, origin);
+  }
+
+  return AllocateInLab(object_size, alignment, origin);
+}
+
+AllocationResult ConcurrentAllocator::AllocateInLab(
+    int object_size, AllocationAlignment alignment, AllocationOrigin origin) {
+  AllocationResult allocation = lab_.AllocateRawAligned(object_size, alignment);
+  if (allocation.IsRetry()) {
+    return AllocateInLabSlow(object_size, alignment, origin);
+  } else {
+    return allocation;
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_CONCURRENT_ALLOCATOR_INL_H_
@@ -0,0 +1,83 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/concurrent-allocator.h"
+
+#include "src/heap/concurrent-allocator-inl.h"
+#include "src/heap/incremental-marking.h"
+#include "src/heap/local-heap.h"
+#include "src/heap/spaces-inl.h"
+
+namespace v8 {
+namespace internal {
+
+void ConcurrentAllocator::FreeLinearAllocationArea() {
+  // Closing the LAB writes a filler over the unused part, which keeps the
+  // page iterable.
+  lab_.Close();
+}
+
+AllocationResult ConcurrentAllocator::AllocateInLabSlow(
+    int object_size, AllocationAlignment alignment, AllocationOrigin origin) {
+  if (!EnsureLabSlow(origin)) {
+    return AllocationResult::Retry(OLD_SPACE);
+  }
+
+  AllocationResult allocation = lab_.AllocateRawAligned(object_size, alignment);
+  DCHECK(!allocation.IsRetry());
+  return allocation;
+}
+
+bool ConcurrentAllocator::EnsureLabSlow(AllocationOrigin origin) {
+  auto result = space_->SlowGetLinearAllocationAreaBackground(
+      local_heap_, kLabSize, kMaxLabSize, kWordAligned, origin);
+  if (!result) return false;
+
+  Address start = result->first;
+  Address end = start + result->second;
+  MarkBlackIfNeeded(start, end);
+
+  // The LAB constructor writes a filler over the new area, so the page stays
+  // iterable until the LAB is closed.
+  LocalAllocationBuffer saved_lab = lab_;
+  lab_ = LocalAllocationBuffer::FromResult(
+      local_heap_->heap(), AllocationResult(HeapObject::FromAddress(start)),
+      result->second);
+  DCHECK(lab_.IsValid());
+  if (!lab_.TryMerge(&saved_lab)) {
+    saved_lab.Close();
+  }
+  return true;
+}
+
+AllocationResult ConcurrentAllocator::AllocateOutsideLab(
+    int object_size, AllocationAlignment alignment, AllocationOrigin origin) {
+  int aligned_size = object_size + Heap::GetMaximumFillToAlign(alignment);
+  auto result = space_->SlowGetLinearAllocationAreaBackground(
+      local_heap_, aligned_size, aligned_size, alignment, origin);
+  if (!result) return AllocationResult::Retry(OLD_SPACE);
+  DCHECK_EQ(result->second, static_cast<size_t>(aligned_size));
+
+  Address start = result->first;
+  Address end = start + result->second;
+  MarkBlackIfNeeded(start, end);
+
+  HeapObject object = HeapObject::FromAddress(start);
+  if (alignment != kWordAligned) {
+    object = local_heap_->heap()->AlignWithFiller(object, object_size,
+                                                  aligned_size, alignment);
+  }
+  return AllocationResult(object);
+}
+
+void ConcurrentAllocator::MarkBlackIfNeeded(Address start, Address end) {
+  Heap* heap = local_heap_->heap();
+  if (heap->incremental_marking()->black_allocation() && start != end) {
+    Page::FromAllocationAreaAddress(start)->CreateBlackAreaBackground(start,
+                                                                      end);
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
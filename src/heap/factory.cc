@@ -525,7 +525,7 @@ Handle<FeedbackVector> Factory::NewFeedbackVector(
   vector->set_length(length);
   vector->set_invocation_count(0);
   vector->set_profiler_ticks(0);
-  vector->clear_padding();
+  vector->set_flags(0);
   vector->set_closure_feedback_cell_array(*closure_feedback_cell_array);
 
   // TODO(leszeks): Initialize based on the feedback metadata.
@@ -1757,6 +1757,7 @@ Handle<BytecodeArray> Factory::NewBytecodeArray(
       interpreter::Register::invalid_value());
   instance->set_osr_loop_nesting_level(0);
   instance->set_bytecode_age(BytecodeArray::kNoAgeBytecodeAge);
+  instance->set_was_optimized(false);
   instance->set_constant_pool(*constant_pool);
   instance->set_handler_table(*empty_byte_array());
   instance->set_source_position_table(*undefined_value());
@@ -2707,6 +2708,7 @@ Handle<BytecodeArray> Factory::CopyBytecodeArray(
   copy->set_source_position_table(bytecode_array->source_position_table());
   copy->set_osr_loop_nesting_level(bytecode_array->osr_loop_nesting_level());
   copy->set_bytecode_age(bytecode_array->bytecode_age());
+  copy->set_was_optimized(bytecode_array->was_optimized());
   bytecode_array->CopyBytecodesTo(*copy);
   return copy;
 }
@@ -319,8 +319,12 @@ void GCTracer::Stop(GarbageCollector collector) {
   double duration = current_.end_time - current_.start_time;
 
   switch (current_.type) {
-    case Event::SCAVENGER:
     case Event::MINOR_MARK_COMPACTOR:
+      current_.scopes[Scope::MINOR_MC_CONCURRENT_MARKING_START] =
+          minor_mc_concurrent_marking_start_duration_;
+      minor_mc_concurrent_marking_start_duration_ = 0;
+      V8_FALLTHROUGH;
+    case Event::SCAVENGER:
       recorded_minor_gcs_total_.Push(
           MakeBytesAndDuration(current_.young_object_size, duration));
       recorded_minor_gcs_survived_.Push(
@@ -647,6 +651,8 @@ void GCTracer::PrintNVP() const {
           "mark.roots=%.2f "
           "mark.weak=%.2f "
           "mark.global_handles=%.2f "
+          "mark.finish_concurrent=%.2f "
+          "concurrent_marking_start=%.2f "
           "clear=%.2f "
           "clear.string_table=%.2f "
           "clear.weak_lists=%.2f "
@@ -656,6 +662,7 @@ void GCTracer::PrintNVP() const {
           "evacuate.update_pointers.to_new_roots=%.2f "
           "evacuate.update_pointers.slots=%.2f "
           "background.mark=%.2f "
+          "background.concurrent_mark=%.2f "
           "background.evacuate.copy=%.2f "
           "background.evacuate.update_pointers=%.2f "
           "background.array_buffer_free=%.2f "
@@ -671,6 +678,8 @@ void GCTracer::PrintNVP() const {
           current_.scopes[Scope::MINOR_MC_MARK_ROOTS],
           current_.scopes[Scope::MINOR_MC_MARK_WEAK],
           current_.scopes[Scope::MINOR_MC_MARK_GLOBAL_HANDLES],
+          current_.scopes[Scope::MINOR_MC_MARK_FINISH_CONCURRENT],
+          current_.scopes[Scope::MINOR_MC_CONCURRENT_MARKING_START],
           current_.scopes[Scope::MINOR_MC_CLEAR],
           current_.scopes[Scope::MINOR_MC_CLEAR_STRING_TABLE],
           current_.scopes[Scope::MINOR_MC_CLEAR_WEAK_LISTS],
@@ -681,6 +690,7 @@ void GCTracer::PrintNVP() const {
               .scopes[Scope::MINOR_MC_EVACUATE_UPDATE_POINTERS_TO_NEW_ROOTS],
           current_.scopes[Scope::MINOR_MC_EVACUATE_UPDATE_POINTERS_SLOTS],
           current_.scopes[Scope::MINOR_MC_BACKGROUND_MARKING],
+          current_.scopes[Scope::MINOR_MC_BACKGROUND_CONCURRENT_MARKING],
           current_.scopes[Scope::MINOR_MC_BACKGROUND_EVACUATE_COPY],
           current_.scopes[Scope::MINOR_MC_BACKGROUND_EVACUATE_UPDATE_POINTERS],
           current_.scopes[Scope::BACKGROUND_ARRAY_BUFFER_FREE],
@@ -719,6 +729,7 @@ void GCTracer::PrintNVP() const {
           "evacuate.copy=%.1f "
           "evacuate.prologue=%.1f "
           "evacuate.epilogue=%.1f "
+          "evacuate.postponed=%.1f "
           "evacuate.rebalance=%.1f "
           "evacuate.update_pointers=%.1f "
           "evacuate.update_pointers.to_new_roots=%.1f "
@@ -742,6 +753,7 @@ void GCTracer::PrintNVP() const {
           "prologue=%.1f "
           "sweep=%.1f "
           "sweep.code=%.1f "
+          "sweep.lo=%.1f "
           "sweep.map=%.1f "
           "sweep.old=%.1f "
           "incremental=%.1f "
@@ -763,6 +775,7 @@ void GCTracer::PrintNVP() const {
           "incremental_walltime_duration=%.f "
           "background.mark=%.1f "
           "background.sweep=%.1f "
+          "background.sweep.lo=%.1f "
           "background.evacuate.copy=%.1f "
           "background.evacuate.update_pointers=%.1f "
           "background.array_buffer_free=%.2f "
@@ -810,6 +823,7 @@ void GCTracer::PrintNVP() const {
           current_.scopes[Scope::MC_EVACUATE_COPY],
           current_.scopes[Scope::MC_EVACUATE_PROLOGUE],
           current_.scopes[Scope::MC_EVACUATE_EPILOGUE],
+          current_.scopes[Scope::MC_EVACUATE_POSTPONED],
           current_.scopes[Scope::MC_EVACUATE_REBALANCE],
           current_.scopes[Scope::MC_EVACUATE_UPDATE_POINTERS],
           current_.scopes[Scope::MC_EVACUATE_UPDATE_POINTERS_TO_NEW_ROOTS],
@@ -831,6 +845,7 @@ void GCTracer::PrintNVP() const {
           current_.scopes[Scope::MC_MARK_EMBEDDER_TRACING],
           current_.scopes[Scope::MC_PROLOGUE], current_.scopes[Scope::MC_SWEEP],
           current_.scopes[Scope::MC_SWEEP_CODE],
+          current_.scopes[Scope::MC_SWEEP_LO],
           current_.scopes[Scope::MC_SWEEP_MAP],
           current_.scopes[Scope::MC_SWEEP_OLD],
           current_.scopes[Scope::MC_INCREMENTAL],
@@ -860,6 +875,7 @@ void GCTracer::PrintNVP() const {
           incremental_walltime_duration,
           current_.scopes[Scope::MC_BACKGROUND_MARKING],
           current_.scopes[Scope::MC_BACKGROUND_SWEEPING],
+          current_.scopes[Scope::MC_BACKGROUND_LARGE_OBJECT_SWEEPING],
           current_.scopes[Scope::MC_BACKGROUND_EVACUATE_COPY],
           current_.scopes[Scope::MC_BACKGROUND_EVACUATE_UPDATE_POINTERS],
           current_.scopes[Scope::BACKGROUND_ARRAY_BUFFER_FREE],
@@ -1212,6 +1228,11 @@ void GCTracer::RecordGCPhasesHistograms(TimedHistogram* gc_timer) {
         static_cast<int>(current_.scopes[Scope::SCAVENGER_SCAVENGE_PARALLEL]));
     counters->gc_scavenger_scavenge_roots()->AddSample(
         static_cast<int>(current_.scopes[Scope::SCAVENGER_SCAVENGE_ROOTS]));
+  } else if (gc_timer == counters->gc_minor_mc()) {
+    counters->gc_minor_mc_mark()->AddSample(
+        static_cast<int>(current_.scopes[Scope::MINOR_MC_MARK]));
+    counters->gc_minor_mc_evacuate()->AddSample(
+        static_cast<int>(current_.scopes[Scope::MINOR_MC_EVACUATE]));
   }
 }
 
@@ -1238,6 +1259,8 @@ void GCTracer::RecordGCSumCounters(double atomic_pause_duration) {
       background_counter_[BackgroundScope::MC_BACKGROUND_MARKING]
           .total_duration_ms +
       background_counter_[BackgroundScope::MC_BACKGROUND_SWEEPING]
+          .total_duration_ms +
+      background_counter_[BackgroundScope::MC_BACKGROUND_LARGE_OBJECT_SWEEPING]
           .total_duration_ms;
 
   const double marking_duration =
@@ -84,7 +84,8 @@ class V8_EXPORT_PRIVATE GCTracer {
       LAST_MC_BACKGROUND_SCOPE = MC_BACKGROUND_SWEEPING,
       FIRST_TOP_MC_SCOPE = MC_CLEAR,
       LAST_TOP_MC_SCOPE = MC_SWEEP,
-      FIRST_MINOR_GC_BACKGROUND_SCOPE = MINOR_MC_BACKGROUND_EVACUATE_COPY,
+      FIRST_MINOR_GC_BACKGROUND_SCOPE =
+          MINOR_MC_BACKGROUND_CONCURRENT_MARKING,
       LAST_MINOR_GC_BACKGROUND_SCOPE = SCAVENGER_BACKGROUND_SCAVENGE_PARALLEL,
       FIRST_BACKGROUND_SCOPE = FIRST_GENERAL_BACKGROUND_SCOPE
     };
@@ -114,7 +115,8 @@ class V8_EXPORT_PRIVATE GCTracer {
       LAST_GENERAL_BACKGROUND_SCOPE = BACKGROUND_UNMAPPER,
       FIRST_MC_BACKGROUND_SCOPE = MC_BACKGROUND_EVACUATE_COPY,
       LAST_MC_BACKGROUND_SCOPE = MC_BACKGROUND_SWEEPING,
-      FIRST_MINOR_GC_BACKGROUND_SCOPE = MINOR_MC_BACKGROUND_EVACUATE_COPY,
+      FIRST_MINOR_GC_BACKGROUND_SCOPE =
+          MINOR_MC_BACKGROUND_CONCURRENT_MARKING,
       LAST_MINOR_GC_BACKGROUND_SCOPE = SCAVENGER_BACKGROUND_SCAVENGE_PARALLEL
     };
     BackgroundScope(GCTracer* tracer, ScopeId scope,
@@ -341,6 +343,10 @@ class V8_EXPORT_PRIVATE GCTracer {
         scope <= Scope::LAST_INCREMENTAL_SCOPE) {
       incremental_marking_scopes_[scope - Scope::FIRST_INCREMENTAL_SCOPE]
           .Update(duration);
+    } else if (scope == Scope::MINOR_MC_CONCURRENT_MARKING_START) {
+      // Concurrent young generation marking is started outside of a GC. The
+      // time is attributed to the next minor mark-compact.
+      minor_mc_concurrent_marking_start_duration_ += duration;
     } else {
       current_.scopes[scope] += duration;
     }
@@ -453,6 +459,10 @@ class V8_EXPORT_PRIVATE GCTracer {
   IncrementalMarkingInfos
       incremental_marking_scopes_[Scope::NUMBER_OF_INCREMENTAL_SCOPES];
 
+  // Duration of starting concurrent young generation marking since the end of
+  // the last minor mark-compact event.
+  double minor_mc_concurrent_marking_start_duration_ = 0.0;
+
 
   // Timestamp and allocation counter at the last sampled allocation event.
   double allocation_time_ms_;
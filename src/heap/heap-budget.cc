@@ -0,0 +1,94 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/heap-budget.h"
+
+#include <algorithm>
+
+#include "src/execution/isolate.h"
+#include "src/heap/heap.h"
+
+namespace v8 {
+namespace internal {
+
+HeapBudget::HeapBudget(size_t budget_in_bytes) : budget_(budget_in_bytes) {
+  CHECK_LT(0, budget_in_bytes);
+}
+
+HeapBudget::~HeapBudget() { DCHECK(heaps_.empty()); }
+
+size_t HeapBudget::used_bytes(v8::Isolate* isolate) const {
+  Heap* heap = reinterpret_cast<Isolate*>(isolate)->heap();
+  return heap->heap_budget_usage_.load(std::memory_order_relaxed);
+}
+
+void HeapBudget::AddHeap(Heap* heap) {
+  base::MutexGuard guard(&mutex_);
+  DCHECK_EQ(std::find(heaps_.begin(), heaps_.end(), heap), heaps_.end());
+  heaps_.push_back(heap);
+}
+
+void HeapBudget::RemoveHeap(Heap* heap) {
+  base::MutexGuard guard(&mutex_);
+  // Heaps that failed to set up may have reported usage without having been
+  // added.
+  auto it = std::find(heaps_.begin(), heaps_.end(), heap);
+  if (it != heaps_.end()) heaps_.erase(it);
+  while (std::find(notified_heaps_.begin(), notified_heaps_.end(), heap) !=
+         notified_heaps_.end()) {
+    notification_done_.Wait(&mutex_);
+  }
+  total_usage_.fetch_sub(
+      heap->heap_budget_usage_.exchange(0, std::memory_order_relaxed),
+      std::memory_order_relaxed);
+}
+
+void HeapBudget::ReportUsage(Heap* heap, size_t usage, size_t reclaimable) {
+  heap->heap_budget_reclaimable_.store(reclaimable, std::memory_order_relaxed);
+  size_t previous =
+      heap->heap_budget_usage_.exchange(usage, std::memory_order_relaxed);
+  // Unsigned arithmetic wraps around correctly when the usage decreased.
+  size_t total =
+      total_usage_.fetch_add(usage - previous, std::memory_order_relaxed) +
+      usage - previous;
+  if (total < budget_ * kNearBudgetRatio) return;
+
+  Heap* victim;
+  {
+    base::MutexGuard guard(&mutex_);
+    victim = SelectHeapForGC();
+    if (victim == nullptr) return;
+    victim->heap_budget_gc_requested_.store(true, std::memory_order_relaxed);
+    notified_heaps_.push_back(victim);
+  }
+  // The victim may run on a different thread, so the GC is requested through
+  // the same interrupt as memory pressure notifications.
+  victim->MemoryPressureNotification(MemoryPressureLevel::kModerate, false);
+  {
+    base::MutexGuard guard(&mutex_);
+    notified_heaps_.erase(
+        std::find(notified_heaps_.begin(), notified_heaps_.end(), victim));
+  }
+  notification_done_.NotifyAll();
+}
+
+Heap* HeapBudget::SelectHeapForGC() {
+  Heap* victim = nullptr;
+  size_t max_reclaimable = 0;
+  for (Heap* heap : heaps_) {
+    if (heap->heap_budget_gc_requested_.load(std::memory_order_relaxed)) {
+      continue;
+    }
+    size_t reclaimable =
+        heap->heap_budget_reclaimable_.load(std::memory_order_relaxed);
+    if (reclaimable > max_reclaimable) {
+      max_reclaimable = reclaimable;
+      victim = heap;
+    }
+  }
+  return victim;
+}
+
+}  // namespace internal
+}  // namespace v8
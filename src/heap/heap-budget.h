@@ -0,0 +1,81 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_HEAP_BUDGET_H_
+#define V8_HEAP_HEAP_BUDGET_H_
+
+#include <atomic>
+#include <vector>
+
+#include "include/v8.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/heap/heap-controller.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// Implementation of v8::HeapBudget. Heaps register themselves once they are
+// set up and report their old generation size whenever the old generation
+// expands and after every GC. Reporting only updates atomic counters; once
+// the combined size approaches the budget, the heap with the most memory
+// allocated since its last mark-compact is asked for a garbage collection.
+class V8_EXPORT_PRIVATE HeapBudget final : public v8::HeapBudget {
+ public:
+  // Fraction of the budget at which a garbage collection is requested.
+  static constexpr double kNearBudgetRatio = 0.9;
+
+  static HeapBudget* From(v8::HeapBudget* heap_budget) {
+    return static_cast<HeapBudget*>(heap_budget);
+  }
+
+  explicit HeapBudget(size_t budget_in_bytes);
+  ~HeapBudget() override;
+
+  size_t budget_in_bytes() const override { return budget_; }
+  size_t used_bytes() const override {
+    return total_usage_.load(std::memory_order_relaxed);
+  }
+  size_t used_bytes(v8::Isolate* isolate) const override;
+
+  void AddHeap(Heap* heap);
+  void RemoveHeap(Heap* heap);
+
+  // Records the old generation size of |heap| and the part of it that may be
+  // reclaimed by the next mark-compact. Requests a GC in one of the heaps if
+  // the budget is nearly exhausted.
+  void ReportUsage(Heap* heap, size_t usage, size_t reclaimable);
+
+  // Shares the memory left in the budget between the old generation limits
+  // of the registered heaps.
+  AdaptiveHeapController* limit_controller() { return &limit_controller_; }
+
+ private:
+  // Returns the heap with the most reclaimable memory that does not have a
+  // pending GC request, or nullptr.
+  Heap* SelectHeapForGC();
+
+  const size_t budget_;
+  std::atomic<size_t> total_usage_{0};
+
+  // Guards |heaps_| and |notified_heaps_|. GC requests are sent without
+  // holding the mutex, as they take locks of the receiving isolate. A heap
+  // that is being removed waits until no GC request is sent to it anymore.
+  base::Mutex mutex_;
+  std::vector<Heap*> heaps_;
+  // Heaps that are currently sent a GC request, with duplicates.
+  std::vector<Heap*> notified_heaps_;
+  base::ConditionVariable notification_done_;
+
+  AdaptiveHeapController limit_controller_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapBudget);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_HEAP_BUDGET_H_
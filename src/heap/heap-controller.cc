@@ -4,6 +4,7 @@
 
 #include "src/heap/heap-controller.h"
 
+#include "src/base/lazy-instance.h"
 #include "src/execution/isolate-inl.h"
 #include "src/heap/spaces.h"
 
@@ -175,5 +176,85 @@ template class V8_EXPORT_PRIVATE MemoryController<GlobalMemoryTrait>;
 const char* V8HeapTrait::kName = "HeapController";
 const char* GlobalMemoryTrait::kName = "GlobalMemoryController";
 
+DEFINE_LAZY_LEAKY_OBJECT_GETTER(AdaptiveHeapController,
+                                GetProcessWideAdaptiveHeapController)
+
+AdaptiveHeapController* AdaptiveHeapController::ProcessWide() {
+  return GetProcessWideAdaptiveHeapController();
+}
+
+void AdaptiveHeapController::AddHeap(size_t memory_cap) {
+  DCHECK_LT(0, memory_cap);
+  base::MutexGuard guard(&mutex_);
+  heaps_++;
+  memory_cap_ = memory_cap_ == 0 ? memory_cap : Min(memory_cap_, memory_cap);
+}
+
+void AdaptiveHeapController::RemoveHeap(size_t reported_size) {
+  base::MutexGuard guard(&mutex_);
+  DCHECK_LT(0, heaps_);
+  DCHECK_LE(reported_size, total_size_);
+  heaps_--;
+  total_size_ -= reported_size;
+  // The cap belongs to the embedder configuration of the live heaps.
+  if (heaps_ == 0) memory_cap_ = 0;
+}
+
+void AdaptiveHeapController::ReportSize(size_t previous_size,
+                                        size_t current_size) {
+  base::MutexGuard guard(&mutex_);
+  DCHECK_LE(previous_size, total_size_);
+  total_size_ = total_size_ - previous_size + current_size;
+}
+
+size_t AdaptiveHeapController::BoundAllocationLimit(size_t current_size,
+                                                    size_t limit,
+                                                    size_t min_growing_step) {
+  base::MutexGuard guard(&mutex_);
+  if (memory_cap_ == 0 || heaps_ == 0) return limit;
+  const size_t available =
+      memory_cap_ > total_size_ ? memory_cap_ - total_size_ : 0;
+  const size_t share = Max(available / heaps_, min_growing_step);
+  return Min(limit, current_size + share);
+}
+
+size_t AdaptiveHeapController::memory_cap() {
+  base::MutexGuard guard(&mutex_);
+  return memory_cap_;
+}
+
+size_t AdaptiveHeapController::total_size() {
+  base::MutexGuard guard(&mutex_);
+  return total_size_;
+}
+
+// static
+double AdaptiveHeapController::PauseBoundedGrowingFactor(
+    double factor, size_t current_size, double gc_speed,
+    double pause_budget_ms) {
+  if (pause_budget_ms <= 0 || gc_speed == 0 || current_size == 0) {
+    return factor;
+  }
+  // The atomic pause has to process the whole heap at |gc_speed| in the worst
+  // case, so the largest limit that fits into the budget is budget * speed.
+  const double max_factor = pause_budget_ms * gc_speed / current_size;
+  return Max(Min(factor, max_factor), V8HeapTrait::kMinGrowingFactor);
+}
+
+// static
+double AdaptiveHeapController::NewSpaceGrowingFactor(double max_factor,
+                                                     size_t survived_bytes,
+                                                     double survived_speed,
+                                                     double pause_budget_ms) {
+  if (pause_budget_ms <= 0 || survived_speed == 0 || survived_bytes == 0) {
+    return max_factor;
+  }
+  // The amount of surviving objects grows roughly with the new space size.
+  const double last_pause_ms = survived_bytes / survived_speed;
+  const double factor = pause_budget_ms / last_pause_ms;
+  if (factor <= 1.0) return 1.0;
+  return Min(factor, max_factor);
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -6,6 +6,7 @@
 #define V8_HEAP_HEAP_CONTROLLER_H_
 
 #include <cstddef>
+#include "src/base/platform/mutex.h"
 #include "src/heap/heap.h"
 #include "src/utils/allocation.h"
 #include "testing/gtest/include/gtest/gtest_prod.h"  // nogncheck
@@ -56,6 +57,60 @@ class V8_EXPORT_PRIVATE MemoryController : public AllStatic {
   FRIEND_TEST(MemoryControllerTest, MaxHeapGrowingFactor);
 };
 
+// Adaptive heap sizing for processes that run many isolates under a common
+// memory budget (see process_heap_size_cap_in_bytes and target_gc_pause_in_ms
+// in v8::ResourceConstraints). All participating heaps share the
+// process-wide instance: they report their old generation size after every GC
+// and their old generation limit is bounded by an equal share of the memory
+// that is still available under the cap.
+class V8_EXPORT_PRIVATE AdaptiveHeapController {
+ public:
+  static AdaptiveHeapController* ProcessWide();
+
+  AdaptiveHeapController() = default;
+
+  // Registers a heap. The smallest cap of all registered heaps wins.
+  void AddHeap(size_t memory_cap);
+  // Unregisters a heap that last reported |reported_size|.
+  void RemoveHeap(size_t reported_size);
+
+  // Replaces the previously reported size of a heap with |current_size|.
+  void ReportSize(size_t previous_size, size_t current_size);
+
+  // Bounds the |limit| of a heap with |current_size| such that the heap
+  // grows at most by its share of the remaining memory. Never returns less
+  // than |current_size| + |min_growing_step|, so that a heap at the cap can
+  // still make progress until the next GC.
+  size_t BoundAllocationLimit(size_t current_size, size_t limit,
+                              size_t min_growing_step);
+
+  size_t memory_cap();
+  size_t total_size();
+
+  // Bounds the old generation growing |factor| such that the atomic pause of
+  // the next mark-compact is expected to stay within |pause_budget_ms| at the
+  // given |gc_speed| in bytes/ms.
+  static double PauseBoundedGrowingFactor(double factor, size_t current_size,
+                                          double gc_speed,
+                                          double pause_budget_ms);
+
+  // Returns the factor by which the new space may grow, at most
+  // |max_factor|, such that a scavenge that has to copy proportionally more
+  // than |survived_bytes| at |survived_speed| in bytes/ms is expected to stay
+  // within |pause_budget_ms|. Returns 1 if the new space must not grow.
+  static double NewSpaceGrowingFactor(double max_factor, size_t survived_bytes,
+                                      double survived_speed,
+                                      double pause_budget_ms);
+
+ private:
+  base::Mutex mutex_;
+  size_t memory_cap_ = 0;
+  size_t total_size_ = 0;
+  int heaps_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(AdaptiveHeapController);
+};
+
 }  // namespace internal
 }  // namespace v8
 
@@ -13,6 +13,7 @@
 #include "src/base/bits.h"
 #include "src/base/flags.h"
 #include "src/base/once.h"
+#include "src/base/optional.h"
 #include "src/base/utils/random-number-generator.h"
 #include "src/builtins/accessors.h"
 #include "src/codegen/assembler-inl.h"
@@ -24,6 +25,7 @@
 #include "src/execution/v8threads.h"
 #include "src/execution/vm-state-inl.h"
 #include "src/handles/global-handles.h"
+#include "src/handles/persistent-handles.h"
 #include "src/heap/array-buffer-collector.h"
 #include "src/heap/array-buffer-tracker-inl.h"
 #include "src/heap/barrier.h"
@@ -33,10 +35,12 @@
 #include "src/heap/embedder-tracing.h"
 #include "src/heap/gc-idle-time-handler.h"
 #include "src/heap/gc-tracer.h"
+#include "src/heap/heap-budget.h"
 #include "src/heap/heap-controller.h"
 #include "src/heap/heap-write-barrier-inl.h"
 #include "src/heap/incremental-marking-inl.h"
 #include "src/heap/incremental-marking.h"
+#include "src/heap/local-heap.h"
 #include "src/heap/mark-compact-inl.h"
 #include "src/heap/mark-compact.h"
 #include "src/heap/memory-measurement.h"
@@ -46,6 +50,7 @@
 #include "src/heap/objects-visiting.h"
 #include "src/heap/read-only-heap.h"
 #include "src/heap/remembered-set.h"
+#include "src/heap/safepoint.h"
 #include "src/heap/scavenge-job.h"
 #include "src/heap/scavenger-inl.h"
 #include "src/heap/stress-marking-observer.h"
@@ -196,6 +201,8 @@ Heap::Heap()
   // Ensure old_generation_size_ is a multiple of kPageSize.
   DCHECK_EQ(0, max_old_generation_size_ & (Page::kPageSize - 1));
 
+  safepoint_.reset(new Safepoint());
+
   set_native_contexts_list(Smi::zero());
   set_allocation_sites_list(Smi::zero());
   // Put a dummy entry in the remembered pages so we can find the list the
@@ -1269,7 +1276,9 @@ TimedHistogram* Heap::GCTypePriorityTimer(GarbageCollector collector) {
 }
 
 TimedHistogram* Heap::GCTypeTimer(GarbageCollector collector) {
-  if (IsYoungGenerationCollector(collector)) {
+  if (collector == MINOR_MARK_COMPACTOR) {
+    return isolate_->counters()->gc_minor_mc();
+  } else if (IsYoungGenerationCollector(collector)) {
     return isolate_->counters()->gc_scavenger();
   } else {
     if (!incremental_marking()->IsStopped()) {
@@ -1650,6 +1659,8 @@ void Heap::StartIncrementalMarking(int gc_flags,
                                    GarbageCollectionReason gc_reason,
                                    GCCallbackFlags gc_callback_flags) {
   DCHECK(incremental_marking()->IsStopped());
+  // Incremental marking uses the same page flags for the marking barrier.
+  AbortMinorMCConcurrentMarking();
   set_current_gc_flags(gc_flags);
   current_gc_callback_flags_ = gc_callback_flags;
   incremental_marking()->Start(gc_reason);
@@ -1689,7 +1700,8 @@ void Heap::MoveRange(HeapObject dst_object, const ObjectSlot dst_slot,
   DCHECK(dst_slot < dst_end);
   DCHECK(src_slot < src_slot + len);
 
-  if (FLAG_concurrent_marking && incremental_marking()->IsMarking()) {
+  if ((FLAG_concurrent_marking && incremental_marking()->IsMarking()) ||
+      IsMinorMCConcurrentMarking()) {
     if (dst_slot < src_slot) {
       // Copy tagged values forward using relaxed load/stores that do not
       // involve value decompression.
@@ -1740,7 +1752,8 @@ void Heap::CopyRange(HeapObject dst_object, const TSlot dst_slot,
   // Ensure ranges do not overlap.
   DCHECK(dst_end <= src_slot || (src_slot + len) <= dst_slot);
 
-  if (FLAG_concurrent_marking && incremental_marking()->IsMarking()) {
+  if ((FLAG_concurrent_marking && incremental_marking()->IsMarking()) ||
+      IsMinorMCConcurrentMarking()) {
     // Copy tagged values using relaxed load/stores that do not involve value
     // decompression.
     const AtomicSlot atomic_dst_end(dst_end);
@@ -1971,6 +1984,12 @@ bool Heap::PerformGarbageCollection(
 
   EnsureFromSpaceIsCommitted();
 
+  base::Optional<SafepointScope> optional_safepoint_scope;
+  if (FLAG_local_heaps) {
+    optional_safepoint_scope.emplace(this);
+    FreeLocalLinearAllocationAreas();
+  }
+
   size_t start_young_generation_size =
       Heap::new_space()->Size() + new_lo_space()->SizeOfObjects();
 
@@ -2060,6 +2079,11 @@ bool Heap::PerformGarbageCollection(
   // Update relocatables.
   Relocatable::PostGarbageCollectionProcessing(isolate_);
 
+  UpdateAdaptiveHeapSize();
+  if (collector == MARK_COMPACTOR) {
+    heap_budget_gc_requested_.store(false, std::memory_order_relaxed);
+  }
+  ReportHeapBudgetUsage();
   RecomputeLimits(collector);
 
   {
@@ -2096,6 +2120,15 @@ void Heap::RecomputeLimits(GarbageCollector collector) {
       tracer()->CurrentOldGenerationAllocationThroughputInBytesPerMillisecond();
   double v8_growing_factor = MemoryController<V8HeapTrait>::GrowingFactor(
       this, max_old_generation_size_, v8_gc_speed, v8_mutator_speed);
+  if (target_gc_pause_ms_ > 0) {
+    double atomic_pause_speed =
+        FLAG_incremental_marking
+            ? tracer()->FinalIncrementalMarkCompactSpeedInBytesPerMillisecond()
+            : tracer()->MarkCompactSpeedInBytesPerMillisecond();
+    v8_growing_factor = AdaptiveHeapController::PauseBoundedGrowingFactor(
+        v8_growing_factor, OldGenerationSizeOfObjects(), atomic_pause_speed,
+        target_gc_pause_ms_);
+  }
   double global_growing_factor = 0;
   if (UseGlobalMemoryScheduling()) {
     DCHECK_NOT_NULL(local_embedder_heap_tracer());
@@ -2160,6 +2193,29 @@ void Heap::RecomputeLimits(GarbageCollector collector) {
       }
     }
   }
+
+  if (adaptive_heap_controller_ != nullptr) {
+    // Only grow by the share of the memory that is left under the
+    // process-wide cap.
+    old_generation_allocation_limit_ =
+        adaptive_heap_controller_->BoundAllocationLimit(
+            old_gen_size, old_generation_allocation_limit_,
+            MemoryController<V8HeapTrait>::MinimumAllocationLimitGrowingStep(
+                mode));
+  }
+}
+
+void Heap::ReportHeapBudgetUsage() {
+  if (heap_budget_ == nullptr) return;
+  heap_budget_->ReportUsage(this, OldGenerationSizeOfObjects(),
+                            PromotedSinceLastGC());
+}
+
+void Heap::UpdateAdaptiveHeapSize() {
+  if (adaptive_heap_controller_ == nullptr) return;
+  size_t size = OldGenerationSizeOfObjects();
+  adaptive_heap_controller_->ReportSize(adaptive_heap_reported_size_, size);
+  adaptive_heap_reported_size_ = size;
 }
 
 void Heap::CallGCPrologueCallbacks(GCType gc_type, GCCallbackFlags flags) {
@@ -2188,6 +2244,9 @@ void Heap::CallGCEpilogueCallbacks(GCType gc_type, GCCallbackFlags flags) {
 void Heap::MarkCompact() {
   PauseAllocationObserversScope pause_observers(this);
 
+  // The full collector also collects the young generation.
+  AbortMinorMCConcurrentMarking();
+
   SetGCState(MARK_COMPACT);
 
   LOG(isolate_, ResourceEvent("markcompact", "begin"));
@@ -2236,6 +2295,32 @@ void Heap::MinorMarkCompact() {
 #endif  // ENABLE_MINOR_MC
 }
 
+bool Heap::IsMinorMCConcurrentMarking() const {
+#ifdef ENABLE_MINOR_MC
+  return minor_mark_compact_collector_ != nullptr &&
+         minor_mark_compact_collector_->IsConcurrentMarking();
+#else
+  return false;
+#endif  // ENABLE_MINOR_MC
+}
+
+void Heap::MinorMCMarkingBarrier(HeapObject value) {
+#ifdef ENABLE_MINOR_MC
+  DCHECK(IsMinorMCConcurrentMarking());
+  minor_mark_compact_collector()->RecordWrite(value);
+#else
+  UNREACHABLE();
+#endif  // ENABLE_MINOR_MC
+}
+
+void Heap::AbortMinorMCConcurrentMarking() {
+#ifdef ENABLE_MINOR_MC
+  if (IsMinorMCConcurrentMarking()) {
+    minor_mark_compact_collector()->AbortConcurrentMarking();
+  }
+#endif  // ENABLE_MINOR_MC
+}
+
 void Heap::MarkCompactEpilogue() {
   TRACE_GC(tracer(), GCTracer::Scope::MC_EPILOGUE);
   SetGCState(NOT_IN_GC);
@@ -2266,19 +2351,30 @@ void Heap::CheckNewSpaceExpansionCriteria() {
         survived_last_scavenge_ * 100 / new_space_->TotalCapacity() >= 10) {
       // Grow the size of new space if there is room to grow, and more than 10%
       // have survived the last scavenge.
-      new_space_->Grow();
-      survived_since_last_expansion_ = 0;
+      if (GrowNewSpace()) survived_since_last_expansion_ = 0;
     }
   } else if (new_space_->TotalCapacity() < new_space_->MaximumCapacity() &&
              survived_since_last_expansion_ > new_space_->TotalCapacity()) {
     // Grow the size of new space if there is room to grow, and enough data
     // has survived scavenge since the last expansion.
-    new_space_->Grow();
-    survived_since_last_expansion_ = 0;
+    if (GrowNewSpace()) survived_since_last_expansion_ = 0;
   }
   new_lo_space()->SetCapacity(new_space()->Capacity());
 }
 
+bool Heap::GrowNewSpace() {
+  double factor = FLAG_semi_space_growth_factor;
+  if (target_gc_pause_ms_ > 0) {
+    factor = AdaptiveHeapController::NewSpaceGrowingFactor(
+        factor, survived_last_scavenge_,
+        tracer()->ScavengeSpeedInBytesPerMillisecond(kForSurvivedObjects),
+        target_gc_pause_ms_);
+  }
+  size_t old_capacity = new_space_->TotalCapacity();
+  new_space_->GrowBy(factor);
+  return new_space_->TotalCapacity() > old_capacity;
+}
+
 void Heap::EvacuateYoungGeneration() {
   TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_FAST_PROMOTE);
   base::MutexGuard guard(relocation_mutex());
@@ -2903,6 +2999,9 @@ bool Heap::CanMoveObjectStart(HeapObject object) {
 
   if (IsLargeObject(object)) return false;
 
+  // Concurrent markers of the young generation may be visiting the object.
+  if (IsMinorMCConcurrentMarking() && InYoungGeneration(object)) return false;
+
   // We can move the object start if the page was already swept.
   return Page::FromHeapObject(object)->SweepingDone();
 }
@@ -3435,6 +3534,10 @@ void Heap::NotifyObjectLayoutChange(
       MemoryChunk::FromHeapObject(object)
           ->RegisterObjectWithInvalidatedSlots<OLD_TO_OLD>(object);
     }
+#ifdef ENABLE_MINOR_MC
+  } else if (IsMinorMCConcurrentMarking() && InYoungGeneration(object)) {
+    minor_mark_compact_collector()->VisitObjectDueToLayoutChange(object);
+#endif  // ENABLE_MINOR_MC
   }
   if (invalidate_recorded_slots == InvalidateRecordedSlots::kYes &&
       MayContainRecordedSlots(object)) {
@@ -4346,6 +4449,12 @@ void Heap::IterateStrongRoots(RootVisitor* v, VisitMode mode) {
   isolate_->handle_scope_implementer()->Iterate(v);
   isolate_->IterateDeferredHandles(&left_trim_visitor);
   isolate_->IterateDeferredHandles(v);
+  // Background threads only add persistent handles while their LocalHeap is
+  // running, so the handles can be visited safely during a safepoint.
+  if (!FLAG_local_heaps || safepoint()->IsActive()) {
+    isolate_->persistent_handles_list()->Iterate(&left_trim_visitor);
+    isolate_->persistent_handles_list()->Iterate(v);
+  }
   v->Synchronize(VisitorSynchronization::kHandleScope);
 
   // Iterate over the builtin code objects in the heap. Note that it is not
@@ -4593,6 +4702,21 @@ void Heap::ConfigureHeap(const v8::ResourceConstraints& constraints) {
 
   code_range_size_ = constraints.code_range_size_in_bytes();
 
+  evacuation_pause_budget_ms_ = constraints.evacuation_pause_budget_in_ms();
+  if (FLAG_evacuation_pause_budget > 0) {
+    evacuation_pause_budget_ms_ = FLAG_evacuation_pause_budget;
+  }
+
+  target_gc_pause_ms_ = constraints.target_gc_pause_in_ms();
+  if (heap_budget_ != nullptr) {
+    adaptive_heap_controller_ = heap_budget_->limit_controller();
+    adaptive_heap_controller_->AddHeap(heap_budget_->budget_in_bytes());
+  } else if (constraints.process_heap_size_cap_in_bytes() > 0) {
+    adaptive_heap_controller_ = AdaptiveHeapController::ProcessWide();
+    adaptive_heap_controller_->AddHeap(
+        constraints.process_heap_size_cap_in_bytes());
+  }
+
   configured_ = true;
 }
 
@@ -4893,6 +5017,12 @@ void Heap::DisableInlineAllocation() {
   }
 }
 
+void Heap::FreeLocalLinearAllocationAreas() {
+  DCHECK(safepoint()->IsActive());
+  safepoint()->IterateLocalHeaps(
+      [](LocalHeap* local_heap) { local_heap->FreeLinearAllocationArea(); });
+}
+
 HeapObject Heap::EnsureImmovableCode(HeapObject heap_object, int object_size) {
   // Code objects which should stay at a fixed address are allocated either
   // in the first page of code space, in large object space, or (during
@@ -5183,6 +5313,8 @@ void Heap::NotifyDeserializationComplete() {
   }
 
   deserialization_complete_ = true;
+
+  if (heap_budget_ != nullptr) heap_budget_->AddHeap(this);
 }
 
 void Heap::NotifyBootstrapComplete() {
@@ -5195,6 +5327,8 @@ void Heap::NotifyBootstrapComplete() {
 
 void Heap::NotifyOldGenerationExpansion() {
   const size_t kMemoryReducerActivationThreshold = 1 * MB;
+  // Compaction spaces also expand during GC, the size is reported afterwards.
+  if (gc_state_ == NOT_IN_GC) ReportHeapBudgetUsage();
   if (old_generation_capacity_after_bootstrap_ && ms_count_ == 0 &&
       OldGenerationCapacity() >= old_generation_capacity_after_bootstrap_ +
                                      kMemoryReducerActivationThreshold &&
@@ -5236,7 +5370,11 @@ void Heap::RegisterExternallyReferencedObject(Address* location) {
   }
 }
 
-void Heap::StartTearDown() { SetGCState(TEAR_DOWN); }
+void Heap::StartTearDown() {
+  SetGCState(TEAR_DOWN);
+  // Stop the budget from requesting GCs in this heap.
+  if (heap_budget_ != nullptr) heap_budget_->RemoveHeap(this);
+}
 
 void Heap::TearDown() {
   DCHECK_EQ(gc_state_, TEAR_DOWN);
@@ -5292,6 +5430,12 @@ void Heap::TearDown() {
   }
 #endif  // ENABLE_MINOR_MC
 
+  if (adaptive_heap_controller_ != nullptr) {
+    adaptive_heap_controller_->RemoveHeap(adaptive_heap_reported_size_);
+    adaptive_heap_controller_ = nullptr;
+    adaptive_heap_reported_size_ = 0;
+  }
+
   scavenger_collector_.reset();
   array_buffer_collector_.reset();
   incremental_marking_.reset();
@@ -6249,6 +6393,12 @@ void Heap::EphemeronKeyWriteBarrierFromCode(Address raw_object,
   if (!ObjectInYoungGeneration(table) && ObjectInYoungGeneration(key)) {
     isolate->heap()->RecordEphemeronKeyWrite(table, key_slot_address);
   }
+  if (V8_UNLIKELY(isolate->heap()->IsMinorMCConcurrentMarking())) {
+    if (ObjectInYoungGeneration(key)) {
+      isolate->heap()->MinorMCMarkingBarrier(key);
+    }
+    return;
+  }
   isolate->heap()->incremental_marking()->RecordWrite(table, key_slot,
                                                       maybe_key);
 }
@@ -6257,13 +6407,16 @@ enum RangeWriteBarrierMode {
   kDoGenerational = 1 << 0,
   kDoMarking = 1 << 1,
   kDoEvacuationSlotRecording = 1 << 2,
+  kDoMinorMarking = 1 << 3,
 };
 
 template <int kModeMask, typename TSlot>
 void Heap::WriteBarrierForRangeImpl(MemoryChunk* source_page, HeapObject object,
                                     TSlot start_slot, TSlot end_slot) {
   // At least one of generational or marking write barrier should be requested.
-  STATIC_ASSERT(kModeMask & (kDoGenerational | kDoMarking));
+  STATIC_ASSERT(kModeMask & (kDoGenerational | kDoMarking | kDoMinorMarking));
+  // Marking of the full heap and of the young generation are exclusive.
+  STATIC_ASSERT(!(kModeMask & kDoMarking) || !(kModeMask & kDoMinorMarking));
   // kDoEvacuationSlotRecording implies kDoMarking.
   STATIC_ASSERT(!(kModeMask & kDoEvacuationSlotRecording) ||
                 (kModeMask & kDoMarking));
@@ -6282,6 +6435,11 @@ void Heap::WriteBarrierForRangeImpl(MemoryChunk* source_page, HeapObject object,
                                                                 slot.address());
     }
 
+    if ((kModeMask & kDoMinorMarking) &&
+        Heap::InYoungGeneration(value_heap_object)) {
+      MinorMCMarkingBarrier(value_heap_object);
+    }
+
     if ((kModeMask & kDoMarking) &&
         incremental_marking->BaseRecordWrite(object, value_heap_object)) {
       if (kModeMask & kDoEvacuationSlotRecording) {
@@ -6314,6 +6472,8 @@ void Heap::WriteBarrierForRange(HeapObject object, TSlot start_slot,
     if (!source_page->ShouldSkipEvacuationSlotRecording<AccessMode::ATOMIC>()) {
       mode |= kDoEvacuationSlotRecording;
     }
+  } else if (IsMinorMCConcurrentMarking()) {
+    mode |= kDoMinorMarking;
   }
 
   switch (mode) {
@@ -6345,6 +6505,16 @@ void Heap::WriteBarrierForRange(HeapObject object, TSlot start_slot,
                                       kDoEvacuationSlotRecording>(
           source_page, object, start_slot, end_slot);
 
+    // Marking of the young generation.
+    case kDoMinorMarking:
+      return WriteBarrierForRangeImpl<kDoMinorMarking>(source_page, object,
+                                                       start_slot, end_slot);
+
+    // Generational and marking of the young generation.
+    case kDoGenerational | kDoMinorMarking:
+      return WriteBarrierForRangeImpl<kDoGenerational | kDoMinorMarking>(
+          source_page, object, start_slot, end_slot);
+
     default:
       UNREACHABLE();
   }
@@ -6378,6 +6548,10 @@ void Heap::GenerationalBarrierForCodeSlow(Code host, RelocInfo* rinfo,
 void Heap::MarkingBarrierSlow(HeapObject object, Address slot,
                               HeapObject value) {
   Heap* heap = Heap::FromWritableHeapObject(object);
+  if (V8_UNLIKELY(heap->IsMinorMCConcurrentMarking())) {
+    heap->MinorMCMarkingBarrier(value);
+    return;
+  }
   heap->incremental_marking()->RecordWriteSlow(object, HeapObjectSlot(slot),
                                                value);
 }
@@ -6385,6 +6559,10 @@ void Heap::MarkingBarrierSlow(HeapObject object, Address slot,
 void Heap::MarkingBarrierForCodeSlow(Code host, RelocInfo* rinfo,
                                      HeapObject object) {
   Heap* heap = Heap::FromWritableHeapObject(host);
+  if (V8_UNLIKELY(heap->IsMinorMCConcurrentMarking())) {
+    heap->MinorMCMarkingBarrier(object);
+    return;
+  }
   DCHECK(heap->incremental_marking()->IsMarking());
   heap->incremental_marking()->RecordWriteIntoCode(host, rinfo, object);
 }
@@ -6392,6 +6570,10 @@ void Heap::MarkingBarrierForCodeSlow(Code host, RelocInfo* rinfo,
 void Heap::MarkingBarrierForDescriptorArraySlow(Heap* heap, HeapObject host,
                                                 HeapObject raw_descriptor_array,
                                                 int number_of_own_descriptors) {
+  if (V8_UNLIKELY(heap->IsMinorMCConcurrentMarking())) {
+    heap->MinorMCMarkingBarrier(raw_descriptor_array);
+    return;
+  }
   DCHECK(heap->incremental_marking()->IsMarking());
   DescriptorArray descriptor_array =
       DescriptorArray::cast(raw_descriptor_array);
@@ -6431,7 +6613,10 @@ bool Heap::PageFlagsAreConsistent(HeapObject object) {
     // find a heap. The exception is when the ReadOnlySpace is writeable, during
     // bootstrapping, so explicitly allow this case.
     Heap* heap = Heap::FromWritableHeapObject(object);
-    CHECK_EQ(slim_chunk->IsMarking(), heap->incremental_marking()->IsMarking());
+    CHECK_EQ(slim_chunk->IsMarking(),
+             heap->incremental_marking()->IsMarking() ||
+                 (slim_chunk->InYoungGeneration() &&
+                  heap->IsMinorMCConcurrentMarking()));
   } else {
     // Non-writable RO_SPACE must never have marking flag set.
     CHECK(!slim_chunk->IsMarking());
@@ -57,6 +57,7 @@ class NativeContext;
 
 using v8::MemoryPressureLevel;
 
+class AdaptiveHeapController;
 class AllocationObserver;
 class ArrayBufferCollector;
 class CodeLargeObjectSpace;
@@ -64,6 +65,7 @@ class ConcurrentMarking;
 class GCIdleTimeHandler;
 class GCIdleTimeHeapState;
 class GCTracer;
+class HeapBudget;
 class HeapObjectAllocationTracker;
 class HeapObjectsFilter;
 class HeapStats;
@@ -80,6 +82,7 @@ class Page;
 class PagedSpace;
 class ReadOnlyHeap;
 class RootVisitor;
+class Safepoint;
 class ScavengeJob;
 class Scavenger;
 class ScavengerCollector;
@@ -585,6 +588,11 @@ class Heap {
   // Check new space expansion criteria and expand semispaces if it was hit.
   void CheckNewSpaceExpansionCriteria();
 
+  // Grows the new space by --semi-space-growth-factor, or less if scavenges
+  // would exceed the target pause otherwise. Returns false if the new space
+  // did not grow.
+  bool GrowNewSpace();
+
   void VisitExternalResources(v8::ExternalResourceVisitor* visitor);
 
   // An object should be promoted if the object has survived a
@@ -916,6 +924,49 @@ class Heap {
 
   ConcurrentMarking* concurrent_marking() { return concurrent_marking_.get(); }
 
+  // ===========================================================================
+  // Local heaps API. ==========================================================
+  // ===========================================================================
+
+  Safepoint* safepoint() { return safepoint_.get(); }
+
+  // Gives up the linear allocation areas of all local heaps. Background
+  // threads have to be stopped in a safepoint.
+  void FreeLocalLinearAllocationAreas();
+
+  // Limits the time spent on evacuating old generation pages in the atomic
+  // pause of a full GC, configured through v8::ResourceConstraints or
+  // --evacuation-pause-budget. Evacuation candidates that do not fit into the
+  // budget stay in place. A budget of 0 disables the limit.
+  double evacuation_pause_budget_ms() const {
+    return evacuation_pause_budget_ms_;
+  }
+  void set_evacuation_pause_budget_ms(double budget_ms) {
+    evacuation_pause_budget_ms_ = budget_ms;
+  }
+
+  // Target duration of GC pauses for adaptive heap sizing, configured through
+  // v8::ResourceConstraints. A target of 0 disables pause-based sizing.
+  double target_gc_pause_ms() const { return target_gc_pause_ms_; }
+
+  // Memory budget shared with other isolates of the process, see
+  // v8::HeapBudget. Has to be set before the heap is configured.
+  void set_heap_budget(HeapBudget* heap_budget) {
+    DCHECK(!configured_);
+    heap_budget_ = heap_budget;
+  }
+  HeapBudget* heap_budget() const { return heap_budget_; }
+
+  // Returns true while the young generation is marked concurrently by the
+  // minor mark-compactor (--minor-mc-concurrent-marking).
+  V8_EXPORT_PRIVATE bool IsMinorMCConcurrentMarking() const;
+  // Marking write barrier for young generation values while concurrent
+  // marking of the young generation is in progress.
+  V8_EXPORT_PRIVATE void MinorMCMarkingBarrier(HeapObject value);
+  // Aborts concurrent marking of the young generation, e.g., before full heap
+  // marking is started.
+  void AbortMinorMCConcurrentMarking();
+
   // The runtime uses this function to notify potentially unsafe object layout
   // changes that require special synchronization with the concurrent marker.
   // The old size is the size of the object before layout change.
@@ -1736,6 +1787,13 @@ class Heap {
 
   void RecomputeLimits(GarbageCollector collector);
 
+  // Reports the old generation size to the process-wide adaptive heap
+  // controller if the heap participates in adaptive heap sizing.
+  void UpdateAdaptiveHeapSize();
+
+  // Reports the old generation size to the heap budget, if any.
+  void ReportHeapBudgetUsage();
+
   // ===========================================================================
   // Idle notification. ========================================================
   // ===========================================================================
@@ -2009,6 +2067,7 @@ class Heap {
   std::unique_ptr<MemoryAllocator> memory_allocator_;
   std::unique_ptr<IncrementalMarking> incremental_marking_;
   std::unique_ptr<ConcurrentMarking> concurrent_marking_;
+  std::unique_ptr<Safepoint> safepoint_;
   std::unique_ptr<GCIdleTimeHandler> gc_idle_time_handler_;
   std::unique_ptr<MemoryMeasurement> memory_measurement_;
   std::unique_ptr<MemoryReducer> memory_reducer_;
@@ -2044,6 +2103,23 @@ class Heap {
   // Used as boolean.
   uint8_t is_marking_flag_ = 0;
 
+  double evacuation_pause_budget_ms_ = 0.0;
+
+  double target_gc_pause_ms_ = 0.0;
+
+  // Set if the embedder configured a process-wide heap size cap.
+  AdaptiveHeapController* adaptive_heap_controller_ = nullptr;
+  // Old generation size last reported to |adaptive_heap_controller_|.
+  size_t adaptive_heap_reported_size_ = 0;
+
+  HeapBudget* heap_budget_ = nullptr;
+  // Last old generation size and reclaimable estimate reported to
+  // |heap_budget_|. Read by other threads through the budget.
+  std::atomic<size_t> heap_budget_usage_{0};
+  std::atomic<size_t> heap_budget_reclaimable_{0};
+  // Set while a GC requested by the budget is pending.
+  std::atomic<bool> heap_budget_gc_requested_{false};
+
   // If it's not full then the data is from 0 to ring_buffer_end_.  If it's
   // full then the data is from ring_buffer_end_ to the end of the buffer and
   // from 0 to ring_buffer_end_.
@@ -2109,6 +2185,7 @@ class Heap {
   friend class ArrayBufferCollector;
   friend class ConcurrentMarking;
   friend class GCCallbacksScope;
+  friend class HeapBudget;
   friend class GCTracer;
   friend class HeapObjectIterator;
   friend class IdleScavengeObserver;
@@ -4,6 +4,7 @@
 
 #include "src/heap/incremental-marking.h"
 
+#include "src/base/optional.h"
 #include "src/codegen/compilation-cache.h"
 #include "src/execution/vm-state-inl.h"
 #include "src/heap/concurrent-marking.h"
@@ -18,6 +19,7 @@
 #include "src/heap/object-stats.h"
 #include "src/heap/objects-visiting-inl.h"
 #include "src/heap/objects-visiting.h"
+#include "src/heap/safepoint.h"
 #include "src/heap/sweeper.h"
 #include "src/init/v8.h"
 #include "src/numbers/conversions.h"
@@ -86,6 +88,14 @@ int IncrementalMarking::RecordWriteFromCode(Address raw_obj,
                                             Isolate* isolate) {
   HeapObject obj = HeapObject::cast(Object(raw_obj));
   MaybeObjectSlot slot(slot_address);
+  if (V8_UNLIKELY(isolate->heap()->IsMinorMCConcurrentMarking())) {
+    // Only the young generation is being marked.
+    HeapObject value;
+    if ((*slot).GetHeapObject(&value)) {
+      isolate->heap()->MinorMCMarkingBarrier(value);
+    }
+    return 0;
+  }
   isolate->heap()->incremental_marking()->RecordWrite(obj, slot, *slot);
   // Called by RecordWriteCodeStubAssembler, which doesnt accept void type
   return 0;
@@ -383,6 +393,13 @@ void IncrementalMarking::StartMarking() {
 void IncrementalMarking::StartBlackAllocation() {
   DCHECK(!black_allocation_);
   DCHECK(IsMarking());
+  base::Optional<SafepointScope> optional_safepoint_scope;
+  if (FLAG_local_heaps) {
+    // Background threads have to start over with fresh linear allocation
+    // areas, which are then created black.
+    optional_safepoint_scope.emplace(heap());
+    heap()->FreeLocalLinearAllocationAreas();
+  }
   black_allocation_ = true;
   heap()->old_space()->MarkLinearAllocationAreaBlack();
   heap()->map_space()->MarkLinearAllocationAreaBlack();
@@ -395,6 +412,11 @@ void IncrementalMarking::StartBlackAllocation() {
 
 void IncrementalMarking::PauseBlackAllocation() {
   DCHECK(IsMarking());
+  base::Optional<SafepointScope> optional_safepoint_scope;
+  if (FLAG_local_heaps) {
+    optional_safepoint_scope.emplace(heap());
+    heap()->FreeLocalLinearAllocationAreas();
+  }
   heap()->old_space()->UnmarkLinearAllocationArea();
   heap()->map_space()->UnmarkLinearAllocationArea();
   heap()->code_space()->UnmarkLinearAllocationArea();
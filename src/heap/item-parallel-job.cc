@@ -5,13 +5,16 @@
 #include "src/heap/item-parallel-job.h"
 
 #include "src/base/platform/semaphore.h"
+#include "src/execution/isolate.h"
+#include "src/flags/flags.h"
 #include "src/init/v8.h"
 #include "src/logging/counters.h"
 
 namespace v8 {
 namespace internal {
 
-ItemParallelJob::Task::Task(Isolate* isolate) : CancelableTask(isolate) {}
+ItemParallelJob::Task::Task(Isolate* isolate)
+    : CancelableTask(isolate), counters_(isolate->counters()) {}
 
 void ItemParallelJob::Task::SetupInternal(base::Semaphore* on_finish,
                                           std::vector<Item*>* items,
@@ -21,17 +24,44 @@ void ItemParallelJob::Task::SetupInternal(base::Semaphore* on_finish,
 
   if (start_index < items->size()) {
     cur_index_ = start_index;
+    numa_index_ = start_index;
   } else {
     items_considered_ = items_->size();
+    numa_items_considered_ = items_->size();
   }
 }
 
+ItemParallelJob::Item* ItemParallelJob::Task::GetItemOnNumaNode() {
+  while (numa_items_considered_ != items_->size()) {
+    numa_items_considered_++;
+    // Wrap around.
+    if (numa_index_ == items_->size()) {
+      numa_index_ = 0;
+    }
+    Item* item = (*items_)[numa_index_++];
+    if (item->numa_node() == numa_node_ && item->TryMarkingAsProcessing()) {
+      local_items_++;
+      return item;
+    }
+  }
+  return nullptr;
+}
+
 void ItemParallelJob::Task::WillRunOnForeground() {
   runner_ = Runner::kForeground;
 }
 
 void ItemParallelJob::Task::RunInternal() {
+  if (FLAG_numa_aware_heap) {
+    numa_node_ = base::OS::GetCurrentNumaNode();
+  }
   RunInParallel(runner_);
+  if (local_items_ > 0) {
+    counters_->gc_numa_local_items()->Increment(local_items_);
+  }
+  if (remote_items_ > 0) {
+    counters_->gc_numa_remote_items()->Increment(remote_items_);
+  }
   on_finish_->Signal();
 }
 
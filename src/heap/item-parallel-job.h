@@ -11,6 +11,7 @@
 #include "src/base/atomic-utils.h"
 #include "src/base/logging.h"
 #include "src/base/macros.h"
+#include "src/base/platform/platform.h"
 #include "src/common/globals.h"
 #include "src/tasks/cancelable-task.h"
 
@@ -34,6 +35,10 @@ class Isolate;
 //
 // Items need to be marked as finished after processing them. Task and Item
 // ownership is transferred to the job.
+//
+// With --numa-aware-heap, items may be tagged with the NUMA node of the memory
+// they refer to. Tasks then first process the items of the node they are
+// running on before helping out with items of other nodes.
 class V8_EXPORT_PRIVATE ItemParallelJob {
  public:
   class Task;
@@ -46,6 +51,9 @@ class V8_EXPORT_PRIVATE ItemParallelJob {
     // Marks an item as being finished.
     void MarkFinished() { CHECK_EQ(kProcessing, state_.exchange(kFinished)); }
 
+    int numa_node() const { return numa_node_; }
+    void set_numa_node(int numa_node) { numa_node_ = numa_node; }
+
    private:
     enum ProcessingState : uintptr_t { kAvailable, kProcessing, kFinished };
 
@@ -56,6 +64,7 @@ class V8_EXPORT_PRIVATE ItemParallelJob {
     bool IsFinished() { return state_ == kFinished; }
 
     std::atomic<ProcessingState> state_{kAvailable};
+    int numa_node_ = base::OS::kNoNumaNode;
 
     friend class ItemParallelJob;
     friend class ItemParallelJob::Task;
@@ -77,6 +86,10 @@ class V8_EXPORT_PRIVATE ItemParallelJob {
     // to process the item and mark the item as finished after doing so.
     template <class ItemType>
     ItemType* GetItem() {
+      if (numa_node_ != base::OS::kNoNumaNode) {
+        Item* item = GetItemOnNumaNode();
+        if (item != nullptr) return static_cast<ItemType*>(item);
+      }
       while (items_considered_++ != items_->size()) {
         // Wrap around.
         if (cur_index_ == items_->size()) {
@@ -84,6 +97,10 @@ class V8_EXPORT_PRIVATE ItemParallelJob {
         }
         Item* item = (*items_)[cur_index_++];
         if (item->TryMarkingAsProcessing()) {
+          if (item->numa_node() != base::OS::kNoNumaNode &&
+              numa_node_ != base::OS::kNoNumaNode) {
+            remote_items_++;
+          }
           return static_cast<ItemType*>(item);
         }
       }
@@ -104,12 +121,27 @@ class V8_EXPORT_PRIVATE ItemParallelJob {
     // We don't allow overriding this method any further.
     void RunInternal() final;
 
+    // Retrieves an item tagged with the NUMA node this task runs on. Returns
+    // |nullptr| once all such items have been considered.
+    Item* GetItemOnNumaNode();
+
     std::vector<Item*>* items_ = nullptr;
     size_t cur_index_ = 0;
     size_t items_considered_ = 0;
     Runner runner_ = Runner::kBackground;
     base::Semaphore* on_finish_ = nullptr;
 
+    // NUMA node this task runs on or base::OS::kNoNumaNode if items are
+    // processed in plain order.
+    int numa_node_ = base::OS::kNoNumaNode;
+    size_t numa_index_ = 0;
+    size_t numa_items_considered_ = 0;
+    // Number of processed items tagged with the task's own or a different
+    // NUMA node.
+    int local_items_ = 0;
+    int remote_items_ = 0;
+    Counters* counters_;
+
     DISALLOW_COPY_AND_ASSIGN(Task);
   };
 
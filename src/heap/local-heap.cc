@@ -0,0 +1,77 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/local-heap.h"
+
+#include "src/heap/concurrent-allocator-inl.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/safepoint.h"
+
+namespace v8 {
+namespace internal {
+
+LocalHeap::LocalHeap(Heap* heap)
+    : heap_(heap),
+      state_(ThreadState::kRunning),
+      safepoint_requested_(false),
+      prev_(nullptr),
+      next_(nullptr),
+      old_space_allocator_(new ConcurrentAllocator(this, heap->old_space())) {
+  DCHECK(FLAG_local_heaps);
+  heap_->safepoint()->AddLocalHeap(this);
+}
+
+LocalHeap::~LocalHeap() {
+  // Give up the linear allocation area while still running and park the
+  // thread afterwards, so that an ongoing safepoint does not wait for a local
+  // heap that is about to be removed.
+  FreeLinearAllocationArea();
+  Park();
+  heap_->safepoint()->RemoveLocalHeap(this);
+}
+
+AllocationResult LocalHeap::AllocateRaw(int size_in_bytes,
+                                        AllocationOrigin origin,
+                                        AllocationAlignment alignment) {
+  DCHECK(!IsParked());
+  Safepoint();
+  return old_space_allocator_->Allocate(size_in_bytes, alignment, origin);
+}
+
+void LocalHeap::Park() {
+  base::MutexGuard guard(&state_mutex_);
+  CHECK_EQ(state_, ThreadState::kRunning);
+  state_ = ThreadState::kParked;
+  state_change_.NotifyAll();
+}
+
+void LocalHeap::Unpark() {
+  {
+    base::MutexGuard guard(&state_mutex_);
+    CHECK_EQ(state_, ThreadState::kParked);
+  }
+  heap_->safepoint()->WaitUntilResumed(this);
+}
+
+bool LocalHeap::IsParked() {
+  base::MutexGuard guard(&state_mutex_);
+  return state_ == ThreadState::kParked;
+}
+
+void LocalHeap::RequestSafepoint() {
+  safepoint_requested_.store(true, std::memory_order_relaxed);
+}
+
+void LocalHeap::ClearSafepointRequested() {
+  safepoint_requested_.store(false, std::memory_order_relaxed);
+}
+
+void LocalHeap::EnterSafepoint() { heap_->safepoint()->EnterFromThread(this); }
+
+void LocalHeap::FreeLinearAllocationArea() {
+  old_space_allocator_->FreeLinearAllocationArea();
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,121 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_LOCAL_HEAP_H_
+#define V8_HEAP_LOCAL_HEAP_H_
+
+#include <atomic>
+#include <memory>
+
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/common/globals.h"
+#include "src/heap/heap.h"
+
+namespace v8 {
+namespace internal {
+
+class ConcurrentAllocator;
+class Safepoint;
+
+// Per-thread view of the heap for background threads that allocate directly
+// into old space. Each LocalHeap owns a linear allocation area that is
+// refilled from the old space free list under the space's allocation mutex,
+// so the common allocation path does not synchronize with the main thread.
+//
+// Background threads have to call Safepoint() regularly while running and
+// need to park the LocalHeap (see ParkedScope) before blocking for a longer
+// period of time. A garbage collection only starts once all LocalHeaps are
+// either parked or have reached a safepoint.
+class LocalHeap {
+ public:
+  V8_EXPORT_PRIVATE explicit LocalHeap(Heap* heap);
+  V8_EXPORT_PRIVATE ~LocalHeap();
+
+  // Frequently invoked by the local thread to check whether a safepoint was
+  // requested from the main thread. Returns true if the thread was stopped, in
+  // which case objects may have been moved by the GC.
+  bool Safepoint() {
+    if (IsSafepointRequested()) {
+      ClearSafepointRequested();
+      EnterSafepoint();
+      return true;
+    }
+    return false;
+  }
+
+  // Allocates an object of |size_in_bytes| in old space. Returns a retry
+  // result when the allocation cannot be satisfied without a garbage
+  // collection on the main thread.
+  V8_WARN_UNUSED_RESULT V8_EXPORT_PRIVATE AllocationResult
+  AllocateRaw(int size_in_bytes,
+              AllocationOrigin origin = AllocationOrigin::kRuntime,
+              AllocationAlignment alignment = kWordAligned);
+
+  // Gives up the current linear allocation area and makes it iterable. Only
+  // invoked by the owning thread or by the main thread during a safepoint.
+  void FreeLinearAllocationArea();
+
+  Heap* heap() { return heap_; }
+
+  bool IsParked();
+
+ private:
+  enum class ThreadState {
+    // Threads in this state need to be stopped in a safepoint.
+    kRunning,
+    // Thread was parked, which means that the thread is not allowed to access
+    // or manipulate the heap in any way.
+    kParked,
+    // Thread was stopped in a safepoint.
+    kSafepoint
+  };
+
+  V8_EXPORT_PRIVATE void Park();
+  V8_EXPORT_PRIVATE void Unpark();
+
+  void RequestSafepoint();
+  bool IsSafepointRequested() {
+    return safepoint_requested_.load(std::memory_order_relaxed);
+  }
+  void ClearSafepointRequested();
+
+  void EnterSafepoint();
+
+  Heap* heap_;
+
+  base::Mutex state_mutex_;
+  base::ConditionVariable state_change_;
+  ThreadState state_;
+
+  std::atomic<bool> safepoint_requested_;
+
+  LocalHeap* prev_;
+  LocalHeap* next_;
+
+  std::unique_ptr<ConcurrentAllocator> old_space_allocator_;
+
+  friend class Safepoint;
+  friend class ParkedScope;
+};
+
+// Parks the LocalHeap for the lifetime of the scope, e.g. while the thread
+// blocks on a lock or waits for other work. The GC does not wait for parked
+// threads and unparking blocks until a running safepoint is over.
+class ParkedScope {
+ public:
+  explicit ParkedScope(LocalHeap* local_heap) : local_heap_(local_heap) {
+    local_heap_->Park();
+  }
+
+  ~ParkedScope() { local_heap_->Unpark(); }
+
+ private:
+  LocalHeap* local_heap_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_LOCAL_HEAP_H_
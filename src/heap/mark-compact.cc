@@ -2699,7 +2699,16 @@ void MarkCompactCollector::EvacuateEpilogue() {
   DCHECK_IMPLIES(FLAG_always_promote_young_mc,
                  heap()->new_space()->Size() == 0);
   // Deallocate unmarked large objects.
-  heap()->lo_space()->FreeUnmarkedObjects();
+  {
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_SWEEP_LO);
+    if (FLAG_concurrent_sweeping && FLAG_concurrent_large_object_sweeping) {
+      // Only unlink the dead pages here and let the sweeper tasks release
+      // them. Sweeping has already been started at this point.
+      heap()->lo_space()->FreeUnmarkedObjectsConcurrently(sweeper());
+    } else {
+      heap()->lo_space()->FreeUnmarkedObjects();
+    }
+  }
   heap()->code_lo_space()->FreeUnmarkedObjects();
   heap()->new_lo_space()->FreeUnmarkedObjects();
   // Old space. Deallocate evacuated candidate pages.
@@ -2947,7 +2956,9 @@ void FullEvacuator::RawEvacuatePage(MemoryChunk* chunk, intptr_t* live_bytes) {
 
 class EvacuationItem : public ItemParallelJob::Item {
  public:
-  explicit EvacuationItem(MemoryChunk* chunk) : chunk_(chunk) {}
+  explicit EvacuationItem(MemoryChunk* chunk) : chunk_(chunk) {
+    set_numa_node(chunk->numa_node());
+  }
   ~EvacuationItem() override = default;
   MemoryChunk* chunk() const { return chunk_; }
 
@@ -3040,9 +3051,44 @@ void MarkCompactCollector::EvacuatePagesInParallel() {
                                  &page_parallel_job_semaphore_);
   intptr_t live_bytes = 0;
 
-  for (Page* page : old_space_evacuation_pages_) {
-    live_bytes += non_atomic_marking_state()->live_bytes(page);
-    evacuation_job.AddItem(new EvacuationItem(page));
+  {
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_EVACUATE_CANDIDATES);
+    const size_t budget = ComputeOldSpaceEvacuationBudget();
+    if (budget != std::numeric_limits<size_t>::max()) {
+      // Evacuate the pages with the least live bytes first.
+      std::sort(old_space_evacuation_pages_.begin(),
+                old_space_evacuation_pages_.end(), [this](Page* a, Page* b) {
+                  return non_atomic_marking_state()->live_bytes(a) <
+                         non_atomic_marking_state()->live_bytes(b);
+                });
+    }
+    size_t evacuated_bytes = 0;
+    DCHECK(postponed_evacuation_candidates_.empty());
+    std::vector<Page*> evacuated_pages;
+    for (Page* page : old_space_evacuation_pages_) {
+      const size_t live_bytes_on_page =
+          static_cast<size_t>(non_atomic_marking_state()->live_bytes(page));
+      if (evacuated_bytes + live_bytes_on_page > budget) {
+        // Keep the page in place. It stays an evacuation candidate until the
+        // other candidates are evacuated, see
+        // ProcessPostponedEvacuationCandidates.
+        postponed_evacuation_candidates_.push_back(page);
+        continue;
+      }
+      evacuated_bytes += live_bytes_on_page;
+      live_bytes += live_bytes_on_page;
+      evacuated_pages.push_back(page);
+      evacuation_job.AddItem(new EvacuationItem(page));
+    }
+    old_space_evacuation_pages_ = std::move(evacuated_pages);
+    if (FLAG_trace_evacuation && !postponed_evacuation_candidates_.empty()) {
+      PrintIsolate(isolate(),
+                   "%8.0f ms: evacuation: budget=%zuKB evacuated=%zuKB "
+                   "postponed=%zu\n",
+                   isolate()->time_millis_since_init(), budget / KB,
+                   evacuated_bytes / KB,
+                   postponed_evacuation_candidates_.size());
+    }
   }
 
   for (Page* page : new_space_evacuation_pages_) {
@@ -3082,7 +3128,10 @@ void MarkCompactCollector::EvacuatePagesInParallel() {
     }
   }
 
-  if (evacuation_job.NumberOfItems() == 0) return;
+  if (evacuation_job.NumberOfItems() == 0) {
+    ProcessPostponedEvacuationCandidates();
+    return;
+  }
 
   CreateAndExecuteEvacuationTasks<FullEvacuator>(this, &evacuation_job, nullptr,
                                                  live_bytes);
@@ -3094,7 +3143,27 @@ void MarkCompactCollector::EvacuatePagesInParallel() {
   // in the sweeping or old-to-new remembered set.
   sweeper()->MergeOldToNewRememberedSetsForSweptPages();
 
-  PostProcessEvacuationCandidates();
+  {
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_EVACUATE_CANDIDATES);
+    PostProcessEvacuationCandidates();
+  }
+  ProcessPostponedEvacuationCandidates();
+}
+
+size_t MarkCompactCollector::ComputeOldSpaceEvacuationBudget() {
+  const double pause_budget_ms = heap()->evacuation_pause_budget_ms();
+  if (pause_budget_ms <= 0 || FLAG_stress_compaction ||
+      FLAG_stress_compaction_random || FLAG_always_compact ||
+      heap()->ShouldReduceMemory()) {
+    return std::numeric_limits<size_t>::max();
+  }
+  const double compaction_speed =
+      heap()->tracer()->CompactionSpeedInBytesPerMillisecond();
+  // Without samples the default candidate selection limits are used.
+  if (compaction_speed == 0) return std::numeric_limits<size_t>::max();
+  // Evacuating a page also requires updating the pointers to its objects,
+  // which is accounted for by halving the compaction speed.
+  return static_cast<size_t>(pause_budget_ms * compaction_speed / 2);
 }
 
 class EvacuationWeakObjectRetainer : public WeakObjectRetainer {
@@ -3111,6 +3180,20 @@ class EvacuationWeakObjectRetainer : public WeakObjectRetainer {
   }
 };
 
+void MarkCompactCollector::ProcessPostponedEvacuationCandidates() {
+  if (postponed_evacuation_candidates_.empty()) return;
+  TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_EVACUATE_POSTPONED);
+  for (Page* page : postponed_evacuation_candidates_) {
+    DCHECK(page->IsEvacuationCandidate());
+    // None of the objects on the page moved, so only the slots that were
+    // skipped during marking because the page was a candidate have to be
+    // recorded. The candidate flag has to be cleared first, as slot recording
+    // is skipped for candidates.
+    page->ClearEvacuationCandidate();
+    RecordLiveSlotsOnPage(page);
+  }
+}
+
 void MarkCompactCollector::RecordLiveSlotsOnPage(Page* page) {
   EvacuateRecordOnlyVisitor visitor(heap());
   LiveObjectVisitor::VisitBlackObjectsNoFail(page, non_atomic_marking_state(),
@@ -3265,6 +3348,11 @@ void MarkCompactCollector::Evacuate() {
         p->ClearFlag(Page::COMPACTION_WAS_ABORTED);
       }
     }
+
+    for (Page* p : postponed_evacuation_candidates_) {
+      sweeper()->AddPage(p->owner_identity(), p, Sweeper::REGULAR);
+    }
+    postponed_evacuation_candidates_.clear();
   }
 
   {
@@ -3327,7 +3415,9 @@ class ToSpaceUpdatingItem : public UpdatingItem {
       : chunk_(chunk),
         start_(start),
         end_(end),
-        marking_state_(marking_state) {}
+        marking_state_(marking_state) {
+    set_numa_node(chunk->numa_node());
+  }
   ~ToSpaceUpdatingItem() override = default;
 
   void Process() override {
@@ -3381,7 +3471,9 @@ class RememberedSetUpdatingItem : public UpdatingItem {
       : heap_(heap),
         marking_state_(marking_state),
         chunk_(chunk),
-        updating_mode_(updating_mode) {}
+        updating_mode_(updating_mode) {
+    set_numa_node(chunk->numa_node());
+  }
   ~RememberedSetUpdatingItem() override = default;
 
   void Process() override {
@@ -4199,13 +4291,46 @@ class YoungGenerationMarkingVisitor final
   MinorMarkCompactCollector::MarkingState* marking_state_;
 };
 
-void MinorMarkCompactCollector::SetUp() {}
+class MinorMarkCompactCollector::ConcurrentMarkingObserver final
+    : public AllocationObserver {
+ public:
+  ConcurrentMarkingObserver(MinorMarkCompactCollector* collector,
+                            intptr_t step_size)
+      : AllocationObserver(step_size), collector_(collector) {}
+
+  void Step(int bytes_allocated, Address, size_t) override {
+    collector_->StartConcurrentMarkingIfNeeded();
+  }
+
+ private:
+  MinorMarkCompactCollector* const collector_;
+};
+
+void MinorMarkCompactCollector::SetUp() {
+  if (FLAG_minor_mc_concurrent_marking) {
+    const intptr_t kStepSize = 64 * KB;
+    concurrent_marking_observer_ =
+        std::make_unique<ConcurrentMarkingObserver>(this, kStepSize);
+    heap()->new_space()->AddAllocationObserver(
+        concurrent_marking_observer_.get());
+  }
+}
 
-void MinorMarkCompactCollector::TearDown() {}
+void MinorMarkCompactCollector::TearDown() {
+  if (concurrent_marking_observer_) {
+    // Pending concurrent marking tasks have already been cancelled by the
+    // isolate at this point.
+    is_concurrent_marking_ = false;
+    heap()->new_space()->RemoveAllocationObserver(
+        concurrent_marking_observer_.get());
+    concurrent_marking_observer_.reset();
+  }
+}
 
 MinorMarkCompactCollector::MinorMarkCompactCollector(Heap* heap)
     : MarkCompactCollectorBase(heap),
       worklist_(new MinorMarkCompactCollector::MarkingWorklist()),
+      on_hold_(new MinorMarkCompactCollector::MarkingWorklist()),
       main_marking_visitor_(new YoungGenerationMarkingVisitor(
           marking_state(), worklist_, kMainMarker)),
       page_parallel_job_semaphore_(0) {
@@ -4216,6 +4341,7 @@ MinorMarkCompactCollector::MinorMarkCompactCollector(Heap* heap)
 
 MinorMarkCompactCollector::~MinorMarkCompactCollector() {
   delete worklist_;
+  delete on_hold_;
   delete main_marking_visitor_;
 }
 
@@ -4621,14 +4747,18 @@ class MarkingItem : public ItemParallelJob::Item {
 
 class YoungGenerationMarkingTask : public ItemParallelJob::Task {
  public:
+  // With |seed_only| objects that are reachable from the items are only
+  // marked grey and pushed onto the global marking worklist.
   YoungGenerationMarkingTask(
       Isolate* isolate, MinorMarkCompactCollector* collector,
-      MinorMarkCompactCollector::MarkingWorklist* global_worklist, int task_id)
+      MinorMarkCompactCollector::MarkingWorklist* global_worklist, int task_id,
+      bool seed_only = false)
       : ItemParallelJob::Task(isolate),
         collector_(collector),
         marking_worklist_(global_worklist, task_id),
         marking_state_(collector->marking_state()),
-        visitor_(marking_state_, global_worklist, task_id) {
+        visitor_(marking_state_, global_worklist, task_id),
+        seed_only_(seed_only) {
     local_live_bytes_.reserve(isolate->heap()->new_space()->Capacity() /
                               Page::kPageSize);
   }
@@ -4650,6 +4780,11 @@ class YoungGenerationMarkingTask : public ItemParallelJob::Task {
     if (!Heap::InYoungGeneration(object)) return;
     HeapObject heap_object = HeapObject::cast(object);
     if (marking_state_->WhiteToGrey(heap_object)) {
+      if (seed_only_) {
+        // Marking deque overflow is unsupported for the young generation.
+        CHECK(marking_worklist_.Push(heap_object));
+        return;
+      }
       const int size = visitor_.Visit(heap_object);
       IncrementLiveBytes(heap_object, size);
     }
@@ -4664,11 +4799,15 @@ class YoungGenerationMarkingTask : public ItemParallelJob::Task {
       while ((item = GetItem<MarkingItem>()) != nullptr) {
         item->Process(this);
         item->MarkFinished();
-        EmptyLocalMarkingWorklist();
+        if (!seed_only_) EmptyLocalMarkingWorklist();
+      }
+      if (seed_only_) {
+        marking_worklist_.FlushToGlobal();
+      } else {
+        EmptyMarkingWorklist();
+        DCHECK(marking_worklist_.IsLocalEmpty());
+        FlushLiveBytes();
       }
-      EmptyMarkingWorklist();
-      DCHECK(marking_worklist_.IsLocalEmpty());
-      FlushLiveBytes();
     }
     if (FLAG_trace_minor_mc_parallel_marking) {
       PrintIsolate(collector_->isolate(), "marking[%p]: time=%f\n",
@@ -4706,12 +4845,15 @@ class YoungGenerationMarkingTask : public ItemParallelJob::Task {
   MinorMarkCompactCollector::MarkingState* marking_state_;
   YoungGenerationMarkingVisitor visitor_;
   std::unordered_map<Page*, intptr_t, Page::Hasher> local_live_bytes_;
+  const bool seed_only_;
 };
 
 class PageMarkingItem : public MarkingItem {
  public:
   explicit PageMarkingItem(MemoryChunk* chunk, std::atomic<int>* global_slots)
-      : chunk_(chunk), global_slots_(global_slots), slots_(0) {}
+      : chunk_(chunk), global_slots_(global_slots), slots_(0) {
+    set_numa_node(chunk->numa_node());
+  }
   ~PageMarkingItem() override { *global_slots_ = *global_slots_ + slots_; }
 
   void Process(YoungGenerationMarkingTask* task) override {
@@ -4783,7 +4925,7 @@ class PageMarkingItem : public MarkingItem {
 };
 
 void MinorMarkCompactCollector::MarkRootSetInParallel(
-    RootMarkingVisitor* root_visitor) {
+    RootMarkingVisitor* root_visitor, bool seed_only) {
   std::atomic<int> slots;
   {
     ItemParallelJob job(isolate()->cancelable_task_manager(),
@@ -4809,11 +4951,11 @@ void MinorMarkCompactCollector::MarkRootSetInParallel(
           static_cast<int>(heap()->new_space()->Capacity()) / Page::kPageSize;
       const int num_tasks = NumberOfParallelMarkingTasks(new_space_pages);
       for (int i = 0; i < num_tasks; i++) {
-        job.AddTask(
-            new YoungGenerationMarkingTask(isolate(), this, worklist(), i));
+        job.AddTask(new YoungGenerationMarkingTask(isolate(), this, worklist(),
+                                                   i, seed_only));
       }
       job.Run();
-      DCHECK(worklist()->IsEmpty());
+      DCHECK_IMPLIES(!seed_only, worklist()->IsEmpty());
     }
   }
   old_to_new_slots_ = slots;
@@ -4826,6 +4968,10 @@ void MinorMarkCompactCollector::MarkLiveObjects() {
 
   RootMarkingVisitor root_visitor(this);
 
+  if (is_concurrent_marking_) {
+    FinishConcurrentMarking();
+  }
+
   MarkRootSetInParallel(&root_visitor);
 
   // Mark rest on the main thread.
@@ -4861,6 +5007,315 @@ void MinorMarkCompactCollector::DrainMarkingWorklist() {
   DCHECK(marking_worklist.IsLocalEmpty());
 }
 
+// Visits young generation objects concurrently to the mutator. All slots of an
+// object are read before its map is validated again, so that an object that
+// changed its layout in the meantime is not marked using stale slot values.
+class MinorMarkCompactCollector::ConcurrentMarkingVisitor final
+    : public ObjectVisitor {
+ public:
+  ConcurrentMarkingVisitor(MarkingState* marking_state,
+                           MarkingWorklist* global_worklist, int task_id)
+      : worklist_(global_worklist, task_id), marking_state_(marking_state) {}
+
+  // Returns the size of the visited object or 0 if the map of the object
+  // changed during visitation.
+  int Visit(Map map, HeapObject object) {
+    slot_values_.clear();
+    const int size = object.SizeFromMap(map);
+    object.IterateBodyFast(map, size, this);
+    if (object.synchronized_map() != map) return 0;
+    for (MaybeObject value : slot_values_) {
+      HeapObject heap_object;
+      // Treat weak references as strong.
+      if (value.GetHeapObject(&heap_object) &&
+          Heap::InYoungGeneration(heap_object) &&
+          marking_state_->WhiteToGrey(heap_object)) {
+        // Marking deque overflow is unsupported for the young generation.
+        CHECK(worklist_.Push(heap_object));
+      }
+    }
+    return size;
+  }
+
+  void VisitPointers(HeapObject host, ObjectSlot start,
+                     ObjectSlot end) final {
+    for (ObjectSlot slot = start; slot < end; ++slot) {
+      slot_values_.push_back(MaybeObject(slot.Relaxed_Load().ptr()));
+    }
+  }
+
+  void VisitPointers(HeapObject host, MaybeObjectSlot start,
+                     MaybeObjectSlot end) final {
+    for (MaybeObjectSlot slot = start; slot < end; ++slot) {
+      slot_values_.push_back(slot.Relaxed_Load());
+    }
+  }
+
+  void VisitCodeTarget(Code host, RelocInfo* rinfo) final {
+    // Code objects are not expected in new space.
+    UNREACHABLE();
+  }
+
+  void VisitEmbeddedPointer(Code host, RelocInfo* rinfo) final {
+    // Code objects are not expected in new space.
+    UNREACHABLE();
+  }
+
+ private:
+  MarkingWorklist::View worklist_;
+  MarkingState* marking_state_;
+  std::vector<MaybeObject> slot_values_;
+};
+
+class MinorMarkCompactCollector::ConcurrentMarkingTask final
+    : public CancelableTask {
+ public:
+  ConcurrentMarkingTask(Isolate* isolate, MinorMarkCompactCollector* collector,
+                        int task_id)
+      : CancelableTask(isolate), collector_(collector), task_id_(task_id) {}
+
+  ~ConcurrentMarkingTask() override = default;
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override { collector_->RunConcurrentMarking(task_id_); }
+
+  MinorMarkCompactCollector* collector_;
+  int task_id_;
+  DISALLOW_COPY_AND_ASSIGN(ConcurrentMarkingTask);
+};
+
+void MinorMarkCompactCollector::StartConcurrentMarkingIfNeeded() {
+  if (!FLAG_minor_mc_concurrent_marking || is_concurrent_marking_) return;
+  if (heap()->gc_state() != Heap::NOT_IN_GC) return;
+  if (!heap()->deserialization_complete() || isolate()->serializer_enabled())
+    return;
+  // Marking of the full heap also marks the young generation.
+  if (!heap()->incremental_marking()->IsStopped()) return;
+  NewSpace* new_space = heap()->new_space();
+  if (new_space->Size() <
+      new_space->Capacity() * kConcurrentMarkingStartRatio) {
+    return;
+  }
+  StartConcurrentMarking();
+}
+
+void MinorMarkCompactCollector::StartConcurrentMarking() {
+  DCHECK(FLAG_minor_mc_concurrent_marking);
+  DCHECK(!is_concurrent_marking_);
+  DCHECK(heap()->incremental_marking()->IsStopped());
+  DCHECK(!heap()->IsTearingDown());
+  TRACE_GC(heap()->tracer(),
+           GCTracer::Scope::MINOR_MC_CONCURRENT_MARKING_START);
+  if (FLAG_trace_minor_mc_concurrent_marking) {
+    isolate()->PrintWithTimestamp(
+        "[MinorMC] Start concurrent marking: new space %zuKB / %zuKB\n",
+        heap()->new_space()->Size() / KB,
+        heap()->new_space()->Capacity() / KB);
+  }
+
+  // Pages that were moved within the new space still carry the marking bits
+  // of the previous GC.
+  heap()->mark_compact_collector()->sweeper()->EnsureIterabilityCompleted();
+  CleanupSweepToIteratePages();
+  DCHECK(worklist()->IsEmpty());
+  DCHECK(on_hold()->IsEmpty());
+  DCHECK(revisit_due_to_layout_change_.empty());
+
+  is_concurrent_marking_ = true;
+  SetYoungGenerationMarkingBarrier(true);
+
+  // Only seed the worklist here. Transitive marking happens on background
+  // threads.
+  RootMarkingVisitor root_visitor(this);
+  MarkRootSetInParallel(&root_visitor, true);
+
+  ScheduleConcurrentMarkingTasks();
+}
+
+void MinorMarkCompactCollector::AbortConcurrentMarking() {
+  if (!is_concurrent_marking_) return;
+  if (FLAG_trace_minor_mc_concurrent_marking) {
+    isolate()->PrintWithTimestamp("[MinorMC] Abort concurrent marking\n");
+  }
+  StopConcurrentMarkingTasks();
+  SetYoungGenerationMarkingBarrier(false);
+  is_concurrent_marking_ = false;
+
+  worklist()->Clear();
+  on_hold()->Clear();
+  revisit_due_to_layout_change_.clear();
+  for (Page* p : *heap()->new_space()) {
+    non_atomic_marking_state()->ClearLiveness(p);
+  }
+  for (LargePage* p : *heap()->new_lo_space()) {
+    non_atomic_marking_state()->ClearLiveness(p);
+  }
+}
+
+void MinorMarkCompactCollector::FinishConcurrentMarking() {
+  DCHECK(is_concurrent_marking_);
+  TRACE_GC(heap()->tracer(), GCTracer::Scope::MINOR_MC_MARK_FINISH_CONCURRENT);
+  StopConcurrentMarkingTasks();
+  SetYoungGenerationMarkingBarrier(false);
+  is_concurrent_marking_ = false;
+
+  // The visitor only pushes newly discovered objects; the live bytes of the
+  // revisited objects were accounted when they were first visited.
+  for (HeapObject object : revisit_due_to_layout_change_) {
+    main_marking_visitor()->Visit(object);
+  }
+  revisit_due_to_layout_change_.clear();
+
+  // Objects that were put on hold are visited again by the parallel markers
+  // together with the objects that were discovered by the write barrier.
+  on_hold()->FlushToGlobal(kMainMarker);
+  worklist()->FlushToGlobal(kMainMarker);
+  worklist()->MergeGlobalPool(on_hold());
+}
+
+void MinorMarkCompactCollector::SetYoungGenerationMarkingBarrier(
+    bool is_marking) {
+  for (Page* p : *heap()->new_space()) {
+    p->SetYoungGenerationPageFlags(is_marking);
+  }
+  for (LargePage* p : *heap()->new_lo_space()) {
+    p->SetYoungGenerationPageFlags(is_marking);
+  }
+  heap()->SetIsMarkingFlag(is_marking);
+}
+
+void MinorMarkCompactCollector::RecordWrite(HeapObject value) {
+  DCHECK(is_concurrent_marking_);
+  if (Heap::InYoungGeneration(value) && marking_state()->WhiteToGrey(value)) {
+    // Marking deque overflow is unsupported for the young generation.
+    CHECK(worklist()->Push(kMainMarker, value));
+  }
+}
+
+void MinorMarkCompactCollector::VisitObjectDueToLayoutChange(
+    HeapObject object) {
+  DCHECK(is_concurrent_marking_);
+  DCHECK(Heap::InYoungGeneration(object));
+  // Marking the object grey prevents concurrent markers from discovering it
+  // while its layout is changing. Objects that are already marked are either
+  // still on a worklist or were visited (and accounted) before; they only need
+  // to be scanned again.
+  if (marking_state()->WhiteToGrey(object)) {
+    CHECK(on_hold()->Push(kMainMarker, object));
+  } else {
+    revisit_due_to_layout_change_.push_back(object);
+  }
+}
+
+void MinorMarkCompactCollector::ScheduleConcurrentMarkingTasks() {
+  DCHECK(!heap()->IsTearingDown());
+  base::MutexGuard guard(&pending_lock_);
+  const int num_tasks =
+      Min(kMaxConcurrentMarkingTasks, Max(1, NumberOfAvailableCores() - 1));
+  concurrent_marking_preemption_request_ = false;
+  // Task id 0 is for the main thread.
+  for (int i = 1; i <= num_tasks; i++) {
+    if (is_pending_[i]) continue;
+    if (FLAG_trace_minor_mc_concurrent_marking) {
+      isolate()->PrintWithTimestamp(
+          "[MinorMC] Scheduling concurrent marking task %d\n", i);
+    }
+    is_pending_[i] = true;
+    ++pending_task_count_;
+    auto task = std::make_unique<ConcurrentMarkingTask>(isolate(), this, i);
+    cancelable_id_[i] = task->id();
+    V8::GetCurrentPlatform()->CallOnWorkerThread(std::move(task));
+  }
+}
+
+bool MinorMarkCompactCollector::StopConcurrentMarkingTasks() {
+  base::MutexGuard guard(&pending_lock_);
+  if (pending_task_count_ == 0) return false;
+  CancelableTaskManager* task_manager = isolate()->cancelable_task_manager();
+  for (int i = 1; i <= kMaxConcurrentMarkingTasks; i++) {
+    if (is_pending_[i] && task_manager->TryAbort(cancelable_id_[i]) ==
+                              TryAbortResult::kTaskAborted) {
+      is_pending_[i] = false;
+      --pending_task_count_;
+    }
+  }
+  concurrent_marking_preemption_request_ = true;
+  while (pending_task_count_ > 0) {
+    pending_condition_.Wait(&pending_lock_);
+  }
+  return true;
+}
+
+void MinorMarkCompactCollector::RunConcurrentMarking(int task_id) {
+  TRACE_BACKGROUND_GC(
+      heap()->tracer(),
+      GCTracer::BackgroundScope::MINOR_MC_BACKGROUND_CONCURRENT_MARKING);
+  const size_t kBytesUntilInterruptCheck = 64 * KB;
+  ConcurrentMarkingVisitor visitor(marking_state(), worklist(), task_id);
+  MarkingWorklist::View marking_worklist(worklist(), task_id);
+  MarkingWorklist::View on_hold_worklist(on_hold(), task_id);
+  std::unordered_map<MemoryChunk*, intptr_t, MemoryChunk::Hasher> live_bytes;
+  size_t marked_bytes = 0;
+  double time_ms;
+  {
+    TimedScope scope(&time_ms);
+    bool done = false;
+    while (!done) {
+      size_t current_marked_bytes = 0;
+      while (current_marked_bytes < kBytesUntilInterruptCheck) {
+        HeapObject object;
+        if (!marking_worklist.Pop(&object)) {
+          done = true;
+          break;
+        }
+        // The order of the two loads is important.
+        Address new_space_top = heap()->new_space()->original_top_acquire();
+        Address new_space_limit = heap()->new_space()->original_limit_relaxed();
+        Address new_large_object = heap()->new_lo_space()->pending_object();
+        Address addr = object.address();
+        if ((new_space_top <= addr && addr < new_space_limit) ||
+            addr == new_large_object) {
+          on_hold_worklist.Push(object);
+          continue;
+        }
+        Map map = object.synchronized_map();
+        const int size = visitor.Visit(map, object);
+        if (size == 0) {
+          on_hold_worklist.Push(object);
+          continue;
+        }
+        live_bytes[MemoryChunk::FromHeapObject(object)] += size;
+        current_marked_bytes += size;
+      }
+      marked_bytes += current_marked_bytes;
+      if (concurrent_marking_preemption_request_.load(
+              std::memory_order_relaxed)) {
+        TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.gc"),
+                     "MinorMarkCompactCollector::RunConcurrentMarking "
+                     "Preempted");
+        break;
+      }
+    }
+    marking_worklist.FlushToGlobal();
+    on_hold_worklist.FlushToGlobal();
+    for (auto pair : live_bytes) {
+      marking_state()->IncrementLiveBytes(pair.first, pair.second);
+    }
+  }
+  if (FLAG_trace_minor_mc_concurrent_marking) {
+    isolate()->PrintWithTimestamp(
+        "[MinorMC] Task %d concurrently marked %zuKB in %.2fms\n", task_id,
+        marked_bytes / KB, time_ms);
+  }
+  {
+    base::MutexGuard guard(&pending_lock_);
+    is_pending_[task_id] = false;
+    --pending_task_count_;
+    pending_condition_.NotifyAll();
+  }
+}
+
 void MinorMarkCompactCollector::Evacuate() {
   TRACE_GC(heap()->tracer(), GCTracer::Scope::MINOR_MC_EVACUATE);
   base::MutexGuard guard(heap()->relocation_mutex());
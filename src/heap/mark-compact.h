@@ -809,7 +809,13 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
   int CollectOldSpaceArrayBufferTrackerItems(ItemParallelJob* job);
 
   void ReleaseEvacuationCandidates();
+  // Returns the number of live bytes on evacuation candidates that can be
+  // evacuated within the pause budget of the heap.
+  size_t ComputeOldSpaceEvacuationBudget();
   void PostProcessEvacuationCandidates();
+  // Turns evacuation candidates that did not fit into the pause budget back
+  // into regular pages that are swept after evacuation.
+  void ProcessPostponedEvacuationCandidates();
   void ReportAbortedEvacuationCandidate(HeapObject failed_object,
                                         MemoryChunk* chunk);
 
@@ -857,6 +863,9 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
   std::vector<Page*> old_space_evacuation_pages_;
   std::vector<Page*> new_space_evacuation_pages_;
   std::vector<std::pair<HeapObject, Page*>> aborted_evacuation_candidates_;
+  // Candidates that stay in place because they do not fit into the evacuation
+  // pause budget.
+  std::vector<Page*> postponed_evacuation_candidates_;
 
   Sweeper* sweeper_;
 
@@ -912,21 +921,50 @@ class MinorMarkCompactCollector final : public MarkCompactCollectorBase {
                     FreeSpaceTreatmentMode free_space_mode);
   void CleanupSweepToIteratePages();
 
+  // Concurrent marking of the young generation (--minor-mc-concurrent-marking).
+  // Marking is started outside of a GC pause when the new space is about to
+  // fill up and is finalized by the next minor mark-compact. While marking is
+  // in progress the marking write barrier is active for young generation
+  // pages, so incremental marking of the full heap cannot run at the same
+  // time.
+  void StartConcurrentMarking();
+  void StartConcurrentMarkingIfNeeded();
+  // Stops the concurrent marking tasks and discards marking progress.
+  void AbortConcurrentMarking();
+  bool IsConcurrentMarking() const { return is_concurrent_marking_; }
+
+  // Marking write barrier while concurrent marking is active.
+  void RecordWrite(HeapObject value);
+  // Hands the object over to the main thread marker which revisits it during
+  // finalization.
+  void VisitObjectDueToLayoutChange(HeapObject object);
+
  private:
   using MarkingWorklist = Worklist<HeapObject, 64 /* segment size */>;
+  class ConcurrentMarkingObserver;
+  class ConcurrentMarkingTask;
+  class ConcurrentMarkingVisitor;
   class RootMarkingVisitor;
 
   static const int kNumMarkers = 8;
   static const int kMainMarker = 0;
+  // Task ids 1..kMaxConcurrentMarkingTasks are used by concurrent markers.
+  static const int kMaxConcurrentMarkingTasks = kNumMarkers - 1;
+
+  // Fraction of the new space capacity that has to be allocated before
+  // concurrent marking is started.
+  static constexpr double kConcurrentMarkingStartRatio = 0.5;
 
   inline MarkingWorklist* worklist() { return worklist_; }
+  inline MarkingWorklist* on_hold() { return on_hold_; }
 
   inline YoungGenerationMarkingVisitor* main_marking_visitor() {
     return main_marking_visitor_;
   }
 
   void MarkLiveObjects() override;
-  void MarkRootSetInParallel(RootMarkingVisitor* root_visitor);
+  void MarkRootSetInParallel(RootMarkingVisitor* root_visitor,
+                             bool seed_only = false);
   V8_INLINE void MarkRootObject(HeapObject obj);
   void DrainMarkingWorklist() override;
   void ClearNonLiveReferences() override;
@@ -946,7 +984,23 @@ class MinorMarkCompactCollector final : public MarkCompactCollectorBase {
 
   int NumberOfParallelMarkingTasks(int pages);
 
+  void ScheduleConcurrentMarkingTasks();
+  void RunConcurrentMarking(int task_id);
+  // Waits until all concurrent marking tasks stopped. Returns false if there
+  // were no pending tasks.
+  bool StopConcurrentMarkingTasks();
+  void FinishConcurrentMarking();
+  void SetYoungGenerationMarkingBarrier(bool is_marking);
+
   MarkingWorklist* worklist_;
+  // Objects that must not be visited by concurrent markers, e.g., objects
+  // that changed their layout or are in the current linear allocation area.
+  // They are visited on the main thread when marking is finalized.
+  MarkingWorklist* on_hold_;
+  // Objects that were already marked when their layout changed. They are
+  // rescanned for new references when marking is finalized, without
+  // accounting their live bytes again.
+  std::vector<HeapObject> revisit_due_to_layout_change_;
 
   YoungGenerationMarkingVisitor* main_marking_visitor_;
   base::Semaphore page_parallel_job_semaphore_;
@@ -956,6 +1010,16 @@ class MinorMarkCompactCollector final : public MarkCompactCollectorBase {
   MarkingState marking_state_;
   NonAtomicMarkingState non_atomic_marking_state_;
 
+  std::unique_ptr<ConcurrentMarkingObserver> concurrent_marking_observer_;
+  bool is_concurrent_marking_ = false;
+  std::atomic<bool> concurrent_marking_preemption_request_{false};
+  base::Mutex pending_lock_;
+  base::ConditionVariable pending_condition_;
+  int pending_task_count_ = 0;
+  CancelableTaskManager::Id
+      cancelable_id_[kMaxConcurrentMarkingTasks + 1] = {};
+  bool is_pending_[kMaxConcurrentMarkingTasks + 1] = {};
+
   friend class YoungGenerationMarkingTask;
   friend class YoungGenerationMarkingVisitor;
 };
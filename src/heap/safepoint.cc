@@ -0,0 +1,152 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/safepoint.h"
+
+#include "src/heap/heap.h"
+#include "src/heap/local-heap.h"
+
+namespace v8 {
+namespace internal {
+
+Safepoint::Safepoint() : local_heaps_head_(nullptr), active_(false) {}
+
+void Safepoint::StopThreads() {
+  local_heaps_mutex_.Lock();
+
+  barrier_.Arm();
+
+  for (LocalHeap* current = local_heaps_head_; current;
+       current = current->next_) {
+    current->RequestSafepoint();
+  }
+
+  for (LocalHeap* current = local_heaps_head_; current;
+       current = current->next_) {
+    base::MutexGuard guard(&current->state_mutex_);
+
+    while (current->state_ == LocalHeap::ThreadState::kRunning) {
+      current->state_change_.Wait(&current->state_mutex_);
+    }
+  }
+
+  active_ = true;
+}
+
+void Safepoint::ResumeThreads() {
+  active_ = false;
+
+  for (LocalHeap* current = local_heaps_head_; current;
+       current = current->next_) {
+    current->ClearSafepointRequested();
+  }
+
+  barrier_.Disarm();
+
+  local_heaps_mutex_.Unlock();
+}
+
+void Safepoint::EnterFromThread(LocalHeap* local_heap) {
+  {
+    base::MutexGuard guard(&local_heap->state_mutex_);
+    local_heap->state_ = LocalHeap::ThreadState::kSafepoint;
+    local_heap->state_change_.NotifyAll();
+  }
+
+  WaitUntilResumed(local_heap);
+}
+
+void Safepoint::WaitUntilResumed(LocalHeap* local_heap) {
+  while (true) {
+    barrier_.Wait();
+
+    // The main thread arms the barrier before it inspects the thread states.
+    // Checking the barrier again while holding the state mutex ensures that
+    // a subsequent safepoint either sees this thread as running or the thread
+    // blocks on the barrier again.
+    base::MutexGuard guard(&local_heap->state_mutex_);
+    if (!barrier_.IsArmed()) {
+      local_heap->state_ = LocalHeap::ThreadState::kRunning;
+      return;
+    }
+  }
+}
+
+void Safepoint::Barrier::Arm() {
+  base::MutexGuard guard(&mutex_);
+  CHECK(!armed_);
+  armed_ = true;
+}
+
+void Safepoint::Barrier::Disarm() {
+  base::MutexGuard guard(&mutex_);
+  CHECK(armed_);
+  armed_ = false;
+  cond_.NotifyAll();
+}
+
+void Safepoint::Barrier::Wait() {
+  base::MutexGuard guard(&mutex_);
+  while (armed_) {
+    cond_.Wait(&mutex_);
+  }
+}
+
+bool Safepoint::Barrier::IsArmed() {
+  base::MutexGuard guard(&mutex_);
+  return armed_;
+}
+
+void Safepoint::AddLocalHeap(LocalHeap* local_heap) {
+  base::MutexGuard guard(&local_heaps_mutex_);
+  if (local_heaps_head_) local_heaps_head_->prev_ = local_heap;
+  local_heap->prev_ = nullptr;
+  local_heap->next_ = local_heaps_head_;
+  local_heaps_head_ = local_heap;
+}
+
+void Safepoint::RemoveLocalHeap(LocalHeap* local_heap) {
+  base::MutexGuard guard(&local_heaps_mutex_);
+  if (local_heap->next_) local_heap->next_->prev_ = local_heap->prev_;
+  if (local_heap->prev_)
+    local_heap->prev_->next_ = local_heap->next_;
+  else
+    local_heaps_head_ = local_heap->next_;
+}
+
+LocalHeap* Safepoint::NextLocalHeap(LocalHeap* local_heap) {
+  return local_heap->next_;
+}
+
+bool Safepoint::ContainsLocalHeap(LocalHeap* local_heap) {
+  base::MutexGuard guard(&local_heaps_mutex_);
+  LocalHeap* current = local_heaps_head_;
+
+  while (current) {
+    if (current == local_heap) return true;
+    current = current->next_;
+  }
+
+  return false;
+}
+
+bool Safepoint::ContainsAnyLocalHeap() {
+  base::MutexGuard guard(&local_heaps_mutex_);
+  return local_heaps_head_ != nullptr;
+}
+
+SafepointScope::SafepointScope(Heap* heap)
+    : safepoint_(heap->safepoint()), stopped_threads_(false) {
+  if (!safepoint_->IsActive()) {
+    safepoint_->StopThreads();
+    stopped_threads_ = true;
+  }
+}
+
+SafepointScope::~SafepointScope() {
+  if (stopped_threads_) safepoint_->ResumeThreads();
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,99 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_SAFEPOINT_H_
+#define V8_HEAP_SAFEPOINT_H_
+
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+class LocalHeap;
+
+// Stops all background threads that allocate through a LocalHeap. While the
+// safepoint is active, every registered LocalHeap is either parked or blocked
+// in LocalHeap::Safepoint(), so the main thread may freely inspect and modify
+// their linear allocation areas and the spaces they allocate from.
+class Safepoint {
+ public:
+  Safepoint();
+
+  // Blocks the calling background thread until the safepoint is over.
+  void EnterFromThread(LocalHeap* local_heap);
+
+  V8_EXPORT_PRIVATE bool ContainsLocalHeap(LocalHeap* local_heap);
+  V8_EXPORT_PRIVATE bool ContainsAnyLocalHeap();
+
+  // Iterates all registered local heaps. Only valid while the safepoint is
+  // active, i.e. between StopThreads() and ResumeThreads().
+  template <typename Callback>
+  void IterateLocalHeaps(Callback callback) {
+    for (LocalHeap* current = local_heaps_head_; current;
+         current = NextLocalHeap(current)) {
+      callback(current);
+    }
+  }
+
+  bool IsActive() const { return active_; }
+
+ private:
+  class Barrier {
+   public:
+    Barrier() : armed_(false) {}
+
+    void Arm();
+    void Disarm();
+    void Wait();
+    bool IsArmed();
+
+   private:
+    base::Mutex mutex_;
+    base::ConditionVariable cond_;
+    bool armed_;
+  };
+
+  void StopThreads();
+  void ResumeThreads();
+
+  // Blocks until no safepoint is active anymore and marks the local heap as
+  // running again.
+  void WaitUntilResumed(LocalHeap* local_heap);
+
+  void AddLocalHeap(LocalHeap* local_heap);
+  void RemoveLocalHeap(LocalHeap* local_heap);
+
+  static LocalHeap* NextLocalHeap(LocalHeap* local_heap);
+
+  Barrier barrier_;
+
+  // Guards the list of local heaps. Held for the whole duration of an active
+  // safepoint, so no local heap can be added or removed meanwhile.
+  base::Mutex local_heaps_mutex_;
+  LocalHeap* local_heaps_head_;
+
+  bool active_;
+
+  friend class LocalHeap;
+  friend class SafepointScope;
+};
+
+// Stops all background threads for the lifetime of the scope. Nested scopes on
+// the main thread are no-ops.
+class SafepointScope {
+ public:
+  V8_EXPORT_PRIVATE explicit SafepointScope(Heap* heap);
+  V8_EXPORT_PRIVATE ~SafepointScope();
+
+ private:
+  Safepoint* safepoint_;
+  bool stopped_threads_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_SAFEPOINT_H_
@@ -25,7 +25,9 @@ namespace internal {
 
 class PageScavengingItem final : public ItemParallelJob::Item {
  public:
-  explicit PageScavengingItem(MemoryChunk* chunk) : chunk_(chunk) {}
+  explicit PageScavengingItem(MemoryChunk* chunk) : chunk_(chunk) {
+    set_numa_node(chunk->numa_node());
+  }
   ~PageScavengingItem() override = default;
 
   void Process(Scavenger* scavenger) { scavenger->ScavengePage(chunk_); }
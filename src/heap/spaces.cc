@@ -20,6 +20,7 @@
 #include "src/heap/heap-controller.h"
 #include "src/heap/incremental-marking-inl.h"
 #include "src/heap/invalidated-slots-inl.h"
+#include "src/heap/local-heap.h"
 #include "src/heap/mark-compact.h"
 #include "src/heap/read-only-heap.h"
 #include "src/heap/remembered-set.h"
@@ -316,6 +317,14 @@ void MemoryAllocator::Unmapper::CancelAndWaitForPendingTasks() {
 }
 
 void MemoryAllocator::Unmapper::PrepareForGC() {
+  if (FLAG_concurrent_large_object_sweeping && FLAG_concurrent_sweeping &&
+      !heap_->IsTearingDown()) {
+    // Dead large pages are queued by the sweeper tasks after the previous
+    // GC has finished. Unmap them on a background task instead of in this
+    // pause.
+    FreeQueuedChunks();
+    return;
+  }
   // Free non-regular chunks because they cannot be re-used.
   PerformFreeMemoryOnQueuedNonRegularChunks();
 }
@@ -750,6 +759,8 @@ MemoryChunk* MemoryChunk::Initialize(Heap* heap, Address base, size_t size,
     chunk->code_object_registry_ = nullptr;
   }
 
+  chunk->numa_node_ = base::OS::kNoNumaNode;
+
   return chunk;
 }
 
@@ -772,7 +783,8 @@ Page* SemiSpace::InitializePage(MemoryChunk* chunk) {
   bool in_to_space = (id() != kFromSpace);
   chunk->SetFlag(in_to_space ? MemoryChunk::TO_PAGE : MemoryChunk::FROM_PAGE);
   Page* page = static_cast<Page*>(chunk);
-  page->SetYoungGenerationPageFlags(heap()->incremental_marking()->IsMarking());
+  page->SetYoungGenerationPageFlags(heap()->incremental_marking()->IsMarking() ||
+                                   heap()->IsMinorMCConcurrentMarking());
   page->AllocateLocalTracker();
   page->list_node().Initialize();
 #ifdef ENABLE_MINOR_MC
@@ -893,6 +905,7 @@ MemoryChunk* MemoryAllocator::AllocateChunk(size_t reserve_area_size,
   VirtualMemory reservation;
   Address area_start = kNullAddress;
   Address area_end = kNullAddress;
+  int numa_node = base::OS::kNoNumaNode;
   void* address_hint =
       AlignedAddress(heap->GetRandomMmapAddr(), MemoryChunk::kAlignment);
 
@@ -942,6 +955,7 @@ MemoryChunk* MemoryAllocator::AllocateChunk(size_t reserve_area_size,
     if (base == kNullAddress) return nullptr;
     // Update executable memory size.
     size_executable_ += reservation.size();
+    numa_node = BindToCurrentNumaNode(base, chunk_size);
 
     if (Heap::ShouldZapGarbage()) {
       ZapBlock(base, MemoryChunkLayout::CodePageGuardStartOffset(), kZapValue);
@@ -958,11 +972,15 @@ MemoryChunk* MemoryAllocator::AllocateChunk(size_t reserve_area_size,
     size_t commit_size = ::RoundUp(
         MemoryChunkLayout::ObjectStartOffsetInDataPage() + commit_area_size,
         GetCommitPageSize());
-    base =
-        AllocateAlignedMemory(chunk_size, commit_size, MemoryChunk::kAlignment,
-                              executable, address_hint, &reservation);
+    size_t alignment = MemoryChunk::kAlignment;
+    HugePageGroup* group = HugePageGroupFor(owner, chunk_size);
+    if (group != nullptr) address_hint = HugePageGroupHint(group, &alignment);
+    base = AllocateAlignedMemory(chunk_size, commit_size, alignment, executable,
+                                 address_hint, &reservation);
 
     if (base == kNullAddress) return nullptr;
+    if (group != nullptr) AddToHugePageGroup(group, base, chunk_size);
+    numa_node = BindToCurrentNumaNode(base, chunk_size);
 
     if (Heap::ShouldZapGarbage()) {
       ZapBlock(
@@ -1002,11 +1020,69 @@ MemoryChunk* MemoryAllocator::AllocateChunk(size_t reserve_area_size,
   MemoryChunk* chunk =
       MemoryChunk::Initialize(heap, base, chunk_size, area_start, area_end,
                               executable, owner, std::move(reservation));
+  chunk->numa_node_ = numa_node;
 
   if (chunk->executable()) RegisterExecutableMemoryChunk(chunk);
   return chunk;
 }
 
+int MemoryAllocator::BindToCurrentNumaNode(Address base, size_t size) {
+  if (!FLAG_numa_aware_heap) return base::OS::kNoNumaNode;
+  int node = base::OS::GetCurrentNumaNode();
+  if (node == base::OS::kNoNumaNode ||
+      !base::OS::SetNumaPreferredNode(reinterpret_cast<void*>(base), size,
+                                      node)) {
+    return base::OS::kNoNumaNode;
+  }
+  isolate_->counters()->gc_numa_bound_chunks()->Increment();
+  return node;
+}
+
+MemoryAllocator::HugePageGroup* MemoryAllocator::HugePageGroupFor(
+    Space* owner, size_t chunk_size) {
+  if (!FLAG_transparent_huge_pages || owner == nullptr) return nullptr;
+  // Large object pages get their own reservation.
+  if (chunk_size != MemoryChunk::kPageSize) return nullptr;
+  AllocationSpace identity = owner->identity();
+  // Executable pages are not grouped: permission changes on code pages would
+  // split the huge pages again.
+  if (identity == OLD_SPACE) return &huge_page_groups_[0];
+  if (identity == MAP_SPACE) return &huge_page_groups_[1];
+  return nullptr;
+}
+
+void* MemoryAllocator::HugePageGroupHint(HugePageGroup* group,
+                                         size_t* alignment) {
+  base::MutexGuard guard(&huge_page_groups_mutex_);
+  if (group->next == kNullAddress) {
+    // Start a new block. The first page is aligned to the huge page size, so
+    // that the following pages of the space fill up the whole block.
+    *alignment = base::OS::kHugePageSize;
+    return nullptr;
+  }
+  return reinterpret_cast<void*>(group->next);
+}
+
+void MemoryAllocator::AddToHugePageGroup(HugePageGroup* group, Address base,
+                                         size_t size) {
+  {
+    base::MutexGuard guard(&huge_page_groups_mutex_);
+    if (base == group->next || IsAligned(base, base::OS::kHugePageSize)) {
+      group->next = base + size;
+      if (IsAligned(group->next, base::OS::kHugePageSize)) {
+        group->next = kNullAddress;
+      }
+    } else {
+      // The page allocator did not honor the hint, e.g. because the memory
+      // was taken in the meantime. Start a new block with the next page.
+      group->next = kNullAddress;
+    }
+  }
+  if (base::OS::AdviseHugePages(reinterpret_cast<void*>(base), size)) {
+    isolate_->counters()->gc_huge_page_chunks()->Increment();
+  }
+}
+
 void MemoryChunk::SetOldGenerationPageFlags(bool is_marking) {
   if (is_marking) {
     SetFlag(MemoryChunk::POINTERS_TO_HERE_ARE_INTERESTING);
@@ -1126,6 +1202,18 @@ void Page::CreateBlackArea(Address start, Address end) {
   marking_state->IncrementLiveBytes(this, static_cast<intptr_t>(end - start));
 }
 
+void Page::CreateBlackAreaBackground(Address start, Address end) {
+  DCHECK(heap()->incremental_marking()->black_allocation());
+  DCHECK_EQ(Page::FromAddress(start), this);
+  DCHECK_NE(start, end);
+  DCHECK_EQ(Page::FromAddress(end - 1), this);
+  IncrementalMarking::AtomicMarkingState* marking_state =
+      heap()->incremental_marking()->atomic_marking_state();
+  marking_state->bitmap(this)->SetRange(AddressToMarkbitIndex(start),
+                                        AddressToMarkbitIndex(end));
+  marking_state->IncrementLiveBytes(this, static_cast<intptr_t>(end - start));
+}
+
 void Page::DestroyBlackArea(Address start, Address end) {
   DCHECK(heap()->incremental_marking()->black_allocation());
   DCHECK_EQ(Page::FromAddress(start), this);
@@ -1233,6 +1321,10 @@ void MemoryAllocator::Free(MemoryChunk* chunk) {
       // The chunks added to this queue will be freed by a concurrent thread.
       unmapper()->AddMemoryChunkSafe(chunk);
       break;
+    case kPreFree:
+      // The caller is responsible for queuing the chunk on the unmapper.
+      PreFreeMemory(chunk);
+      break;
   }
 }
 
@@ -1248,6 +1340,9 @@ template EXPORT_TEMPLATE_DEFINE(V8_EXPORT_PRIVATE) void MemoryAllocator::Free<
 template EXPORT_TEMPLATE_DEFINE(V8_EXPORT_PRIVATE) void MemoryAllocator::Free<
     MemoryAllocator::kPooledAndQueue>(MemoryChunk* chunk);
 
+template EXPORT_TEMPLATE_DEFINE(V8_EXPORT_PRIVATE) void MemoryAllocator::Free<
+    MemoryAllocator::kPreFree>(MemoryChunk* chunk);
+
 template <MemoryAllocator::AllocationMode alloc_mode, typename SpaceType>
 Page* MemoryAllocator::AllocatePage(size_t size, SpaceType* owner,
                                     Executability executable) {
@@ -1298,11 +1393,15 @@ MemoryChunk* MemoryAllocator::AllocatePagePooled(SpaceType* owner) {
   DCHECK_NE(CODE_SPACE, owner->identity());
   VirtualMemory reservation(data_page_allocator(), start, size);
   if (!CommitMemory(&reservation)) return nullptr;
+  // Pooled pages were uncommitted, so they may be placed on a different node
+  // when they are touched again.
+  int numa_node = BindToCurrentNumaNode(start, size);
   if (Heap::ShouldZapGarbage()) {
     ZapBlock(start, size, kZapValue);
   }
   MemoryChunk::Initialize(isolate_->heap(), start, size, area_start, area_end,
                           NOT_EXECUTABLE, owner, std::move(reservation));
+  chunk->numa_node_ = numa_node;
   size_ += size;
   return chunk;
 }
@@ -1657,6 +1756,10 @@ void PagedSpace::RefillFreeList() {
   size_t added = 0;
 
   {
+    base::Optional<base::RecursiveMutexGuard> optional_allocation_guard;
+    if (SupportsConcurrentAllocation()) {
+      optional_allocation_guard.emplace(&allocation_mutex_);
+    }
     Page* p = nullptr;
     while ((p = collector->sweeper()->GetSweptPageSafe(this)) != nullptr) {
       // We regularly sweep NEVER_ALLOCATE_ON_PAGE pages. We drop the freelist
@@ -1877,6 +1980,10 @@ void PagedSpace::DecreaseLimit(Address new_limit) {
   DCHECK_LE(top(), new_limit);
   DCHECK_GE(old_limit, new_limit);
   if (new_limit != old_limit) {
+    base::Optional<base::RecursiveMutexGuard> optional_allocation_guard;
+    if (SupportsConcurrentAllocation()) {
+      optional_allocation_guard.emplace(&allocation_mutex_);
+    }
     SetTopAndLimit(top(), new_limit);
     Free(new_limit, old_limit - new_limit,
          SpaceAccountingMode::kSpaceAccounted);
@@ -1975,6 +2082,11 @@ void PagedSpace::FreeLinearAllocationArea() {
     heap()->UnprotectAndRegisterMemoryChunk(
         MemoryChunk::FromAddress(current_top));
   }
+
+  base::Optional<base::RecursiveMutexGuard> optional_allocation_guard;
+  if (SupportsConcurrentAllocation()) {
+    optional_allocation_guard.emplace(&allocation_mutex_);
+  }
   Free(current_top, current_limit - current_top,
        SpaceAccountingMode::kSpaceAccounted);
 }
@@ -2272,12 +2384,18 @@ void NewSpace::TearDown() {
 void NewSpace::Flip() { SemiSpace::Swap(&from_space_, &to_space_); }
 
 
-void NewSpace::Grow() {
-  // Double the semispace size but only up to maximum capacity.
+void NewSpace::Grow() { GrowBy(FLAG_semi_space_growth_factor); }
+
+void NewSpace::GrowBy(double factor) {
+  // Grow the semispace size but only up to maximum capacity.
   DCHECK(TotalCapacity() < MaximumCapacity());
+  // Adaptive growing factors may ask for no growth at all.
+  if (factor <= 1.0) return;
   size_t new_capacity =
       Min(MaximumCapacity(),
-          static_cast<size_t>(FLAG_semi_space_growth_factor) * TotalCapacity());
+          ::RoundDown(static_cast<size_t>(factor * TotalCapacity()),
+                      Page::kPageSize));
+  if (new_capacity <= TotalCapacity()) return;
   if (to_space_.GrowTo(new_capacity)) {
     // Only grow from space if we managed to grow to-space.
     if (!from_space_.GrowTo(new_capacity)) {
@@ -3716,9 +3834,142 @@ bool PagedSpace::SlowRefillLinearAllocationArea(int size_in_bytes,
   VMState<GC> state(heap()->isolate());
   RuntimeCallTimerScope runtime_timer(
       heap()->isolate(), RuntimeCallCounterId::kGC_Custom_SlowAllocateRaw);
+  base::Optional<base::RecursiveMutexGuard> optional_allocation_guard;
+  if (SupportsConcurrentAllocation()) {
+    optional_allocation_guard.emplace(&allocation_mutex_);
+  }
   return RawSlowRefillLinearAllocationArea(size_in_bytes, origin);
 }
 
+base::Optional<std::pair<Address, size_t>>
+PagedSpace::SlowGetLinearAllocationAreaBackground(LocalHeap* local_heap,
+                                                  size_t min_size_in_bytes,
+                                                  size_t max_size_in_bytes,
+                                                  AllocationAlignment alignment,
+                                                  AllocationOrigin origin) {
+  DCHECK(SupportsConcurrentAllocation());
+  // The main thread may hold the allocation mutex while it waits for all
+  // background threads to reach a safepoint, e.g. when an allocation step
+  // starts black allocation. Background threads therefore never block on the
+  // mutex but keep checking for safepoint requests instead.
+  while (!allocation_mutex_.TryLock()) {
+    local_heap->Safepoint();
+  }
+  auto result = RawSlowGetLinearAllocationAreaBackground(
+      local_heap, min_size_in_bytes, max_size_in_bytes, alignment, origin);
+  allocation_mutex_.Unlock();
+  return result;
+}
+
+base::Optional<std::pair<Address, size_t>>
+PagedSpace::RawSlowGetLinearAllocationAreaBackground(
+    LocalHeap* local_heap, size_t min_size_in_bytes, size_t max_size_in_bytes,
+    AllocationAlignment alignment, AllocationOrigin origin) {
+  DCHECK_LE(min_size_in_bytes, max_size_in_bytes);
+
+  auto result = TryAllocationFromFreeListBackground(
+      min_size_in_bytes, max_size_in_bytes, alignment, origin);
+  if (result) return result;
+
+  MarkCompactCollector* collector = heap()->mark_compact_collector();
+  // Sweeping is still in progress.
+  if (collector->sweeping_in_progress()) {
+    // First try to refill the free-list, concurrent sweeper threads
+    // may have freed some objects in the meantime.
+    RefillFreeList();
+
+    // Retry the free list allocation.
+    result = TryAllocationFromFreeListBackground(
+        min_size_in_bytes, max_size_in_bytes, alignment, origin);
+    if (result) return result;
+
+    // Now contribute to sweeping from the background thread and then try to
+    // allocate again.
+    const int kMaxPagesToSweep = 1;
+    int max_freed = collector->sweeper()->ParallelSweepSpace(
+        identity(), static_cast<int>(min_size_in_bytes), kMaxPagesToSweep);
+    RefillFreeList();
+
+    if (static_cast<size_t>(max_freed) >= min_size_in_bytes) {
+      result = TryAllocationFromFreeListBackground(
+          min_size_in_bytes, max_size_in_bytes, alignment, origin);
+      if (result) return result;
+    }
+  }
+
+  // Background threads never grow the old generation beyond its allocation
+  // limit. Reaching the limit is left to the main thread, which then starts
+  // incremental marking or collects garbage.
+  if (heap()->OldGenerationSpaceAvailable() > 0) {
+    result = ExpandBackground(local_heap, max_size_in_bytes);
+    if (result) return result;
+  }
+
+  // The main thread has to either finish sweeping or collect garbage before
+  // this allocation can succeed.
+  return {};
+}
+
+base::Optional<std::pair<Address, size_t>>
+PagedSpace::TryAllocationFromFreeListBackground(size_t min_size_in_bytes,
+                                                size_t max_size_in_bytes,
+                                                AllocationAlignment alignment,
+                                                AllocationOrigin origin) {
+  DCHECK_LE(min_size_in_bytes, max_size_in_bytes);
+  DCHECK_EQ(identity(), OLD_SPACE);
+
+  size_t new_node_size = 0;
+  FreeSpace new_node =
+      free_list_->Allocate(min_size_in_bytes, &new_node_size, origin);
+  if (new_node.is_null()) return {};
+  DCHECK_GE(new_node_size, min_size_in_bytes);
+
+  // The old-space-step might have finished sweeping and restarted marking.
+  // Verify that it did not turn the page of the new node into an evacuation
+  // candidate.
+  DCHECK(!MarkCompactCollector::IsOnEvacuationCandidate(new_node));
+
+  // Memory in the linear allocation area is counted as allocated.  We may free
+  // a little of this again immediately - see below.
+  Page* page = Page::FromHeapObject(new_node);
+  IncreaseAllocatedBytes(new_node_size, page);
+
+  size_t used_size_in_bytes = Min(new_node_size, max_size_in_bytes);
+
+  Address start = new_node.address();
+  Address end = new_node.address() + new_node_size;
+  Address limit = new_node.address() + used_size_in_bytes;
+  DCHECK_LE(limit, end);
+  DCHECK_LE(min_size_in_bytes, limit - start);
+  if (limit != end) {
+    Free(limit, end - limit, SpaceAccountingMode::kSpaceAccounted);
+  }
+
+  return std::make_pair(start, used_size_in_bytes);
+}
+
+base::Optional<std::pair<Address, size_t>> PagedSpace::ExpandBackground(
+    LocalHeap* local_heap, size_t size_in_bytes) {
+  DCHECK_EQ(identity(), OLD_SPACE);
+  // Pages are added to the space under the space mutex, just like Expand()
+  // does for compaction spaces.
+  base::MutexGuard guard(mutex());
+
+  const int size = AreaSize();
+  if (!heap()->CanExpandOldGeneration(size)) return {};
+
+  Page* page =
+      heap()->memory_allocator()->AllocatePage(size, this, executable());
+  if (page == nullptr) return {};
+  AddPage(page);
+
+  Address object_start = page->area_start();
+  CHECK_LE(size_in_bytes, page->area_size());
+  Free(page->area_start() + size_in_bytes, page->area_size() - size_in_bytes,
+       SpaceAccountingMode::kSpaceAccounted);
+  return std::make_pair(object_start, size_in_bytes);
+}
+
 bool CompactionSpace::SlowRefillLinearAllocationArea(int size_in_bytes,
                                                      AllocationOrigin origin) {
   return RawSlowRefillLinearAllocationArea(size_in_bytes, origin);
@@ -4107,6 +4358,13 @@ void OldLargeObjectSpace::ClearMarkingStateOfLiveObjects() {
   }
 }
 
+void OldLargeObjectSpace::FreeUnmarkedObjectsConcurrently(Sweeper* sweeper) {
+  RemoveUnmarkedObjects([this, sweeper](LargePage* page) {
+    heap()->memory_allocator()->Free<MemoryAllocator::kPreFree>(page);
+    sweeper->AddLargePage(page);
+  });
+}
+
 void CodeLargeObjectSpace::InsertChunkMapEntries(LargePage* page) {
   for (Address current = reinterpret_cast<Address>(page);
        current < reinterpret_cast<Address>(page) + page->size();
@@ -4152,7 +4410,8 @@ void LargeObjectSpace::RemovePage(LargePage* page, size_t object_size) {
   memory_chunk_list_.Remove(page);
 }
 
-void LargeObjectSpace::FreeUnmarkedObjects() {
+template <typename FreePageCallback>
+void LargeObjectSpace::RemoveUnmarkedObjects(FreePageCallback free_page) {
   LargePage* current = first_page();
   IncrementalMarking::NonAtomicMarkingState* marking_state =
       heap()->incremental_marking()->non_atomic_marking_state();
@@ -4163,9 +4422,9 @@ void LargeObjectSpace::FreeUnmarkedObjects() {
     LargePage* next_current = current->next_page();
     HeapObject object = current->GetObject();
     DCHECK(!marking_state->IsGrey(object));
-    size_t size = static_cast<size_t>(object.Size());
     if (marking_state->IsBlack(object)) {
       Address free_start;
+      size_t size = static_cast<size_t>(object.Size());
       surviving_object_size += size;
       if ((free_start = current->GetAddressToShrink(object.address(), size)) !=
           0) {
@@ -4180,15 +4439,22 @@ void LargeObjectSpace::FreeUnmarkedObjects() {
         AccountUncommitted(bytes_to_free);
       }
     } else {
-      RemovePage(current, size);
-      heap()->memory_allocator()->Free<MemoryAllocator::kPreFreeAndQueue>(
-          current);
+      // The size of dead objects is not needed as objects_size_ is recomputed
+      // below, which saves touching the object.
+      RemovePage(current, 0);
+      free_page(current);
     }
     current = next_current;
   }
   objects_size_ = surviving_object_size;
 }
 
+void LargeObjectSpace::FreeUnmarkedObjects() {
+  RemoveUnmarkedObjects([this](LargePage* page) {
+    heap()->memory_allocator()->Free<MemoryAllocator::kPreFreeAndQueue>(page);
+  });
+}
+
 bool LargeObjectSpace::Contains(HeapObject object) {
   MemoryChunk* chunk = MemoryChunk::FromHeapObject(object);
 
@@ -4347,7 +4613,8 @@ AllocationResult NewLargeObjectSpace::AllocateRaw(int object_size) {
   capacity_ = Max(capacity_, SizeOfObjects());
 
   HeapObject result = page->GetObject();
-  page->SetYoungGenerationPageFlags(heap()->incremental_marking()->IsMarking());
+  page->SetYoungGenerationPageFlags(heap()->incremental_marking()->IsMarking() ||
+                                   heap()->IsMinorMCConcurrentMarking());
   page->SetFlag(MemoryChunk::TO_PAGE);
   pending_object_.store(result.address(), std::memory_order_relaxed);
 #ifdef ENABLE_MINOR_MC
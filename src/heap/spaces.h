@@ -10,6 +10,7 @@
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "src/base/atomic-utils.h"
@@ -17,6 +18,7 @@
 #include "src/base/export-template.h"
 #include "src/base/iterator.h"
 #include "src/base/list.h"
+#include "src/base/optional.h"
 #include "src/base/platform/mutex.h"
 #include "src/common/globals.h"
 #include "src/flags/flags.h"
@@ -39,6 +41,7 @@ namespace internal {
 namespace heap {
 class HeapTester;
 class TestCodePageAllocatorScope;
+class TestDataPageAllocatorScope;
 }  // namespace heap
 
 class AllocationObserver;
@@ -49,6 +52,7 @@ class Isolate;
 class LargeObjectSpace;
 class LinearAllocationArea;
 class LocalArrayBufferTracker;
+class LocalHeap;
 class LocalSpace;
 class MemoryAllocator;
 class MemoryChunk;
@@ -58,6 +62,7 @@ class PagedSpace;
 class SemiSpace;
 class SlotsBuffer;
 class SlotSet;
+class Sweeper;
 class TypedSlotSet;
 class Space;
 
@@ -621,8 +626,9 @@ class MemoryChunk : public BasicMemoryChunk {
       + kSystemPointerSize      // FreeListCategory** categories__
       + kSystemPointerSize      // LocalArrayBufferTracker* local_tracker_
       + kIntptrSize  // std::atomic<intptr_t> young_generation_live_byte_count_
-      + kSystemPointerSize   // Bitmap* young_generation_bitmap_
-      + kSystemPointerSize;  // CodeObjectRegistry* code_object_registry_
+      + kSystemPointerSize  // Bitmap* young_generation_bitmap_
+      + kSystemPointerSize  // CodeObjectRegistry* code_object_registry_
+      + kIntptrSize;        // int numa_node_ (padded)
 
   // Page size in bytes.  This must be a multiple of the OS page size.
   static const int kPageSize = 1 << kPageSizeBits;
@@ -867,6 +873,11 @@ class MemoryChunk : public BasicMemoryChunk {
 
   CodeObjectRegistry* GetCodeObjectRegistry() { return code_object_registry_; }
 
+  // NUMA node the memory of this chunk is bound to, or
+  // base::OS::kNoNumaNode if the chunk was allocated without
+  // --numa-aware-heap.
+  int numa_node() const { return numa_node_; }
+
   FreeList* free_list() { return owner()->free_list(); }
 
  protected:
@@ -964,6 +975,8 @@ class MemoryChunk : public BasicMemoryChunk {
 
   CodeObjectRegistry* code_object_registry_;
 
+  int numa_node_;
+
  private:
   void InitializeReservedMemory() { reservation_.Reset(); }
 
@@ -975,6 +988,7 @@ class MemoryChunk : public BasicMemoryChunk {
   friend class MinorMarkingState;
   friend class MinorNonAtomicMarkingState;
   friend class PagedSpace;
+  friend class Sweeper;
 };
 
 STATIC_ASSERT(sizeof(std::atomic<intptr_t>) == kSystemPointerSize);
@@ -1092,6 +1106,7 @@ class Page : public MemoryChunk {
   size_t ShrinkToHighWaterMark();
 
   V8_EXPORT_PRIVATE void CreateBlackArea(Address start, Address end);
+  V8_EXPORT_PRIVATE void CreateBlackAreaBackground(Address start, Address end);
   void DestroyBlackArea(Address start, Address end);
 
   void InitializeFreeListCategories();
@@ -1290,6 +1305,7 @@ class MemoryAllocator {
     kAlreadyPooled,
     kPreFreeAndQueue,
     kPooledAndQueue,
+    kPreFree,
   };
 
   V8_EXPORT_PRIVATE static intptr_t GetCommitPageSize();
@@ -1432,6 +1448,31 @@ class MemoryAllocator {
   template <typename SpaceType>
   MemoryChunk* AllocatePagePooled(SpaceType* owner);
 
+  // Binds the memory of a new chunk to the NUMA node of the allocating thread
+  // if --numa-aware-heap is enabled. Returns the node or
+  // base::OS::kNoNumaNode if the memory was not bound.
+  int BindToCurrentNumaNode(Address base, size_t size);
+
+  // With --transparent-huge-pages, regular pages of old and map space are
+  // placed next to each other in base::OS::kHugePageSize-aligned blocks,
+  // so that the pages of a space can share transparent huge pages. A group
+  // remembers where the next page of its space should go.
+  struct HugePageGroup {
+    Address next = kNullAddress;
+  };
+
+  // Returns the group of |owner| if a chunk of |chunk_size| should be grouped
+  // and nullptr otherwise.
+  HugePageGroup* HugePageGroupFor(Space* owner, size_t chunk_size);
+
+  // Returns the address hint for the next page of |group| and updates
+  // |alignment| if a new block has to be started.
+  void* HugePageGroupHint(HugePageGroup* group, size_t* alignment);
+
+  // Records that the page at |base| was allocated for |group| and advises the
+  // kernel to back it with huge pages.
+  void AddToHugePageGroup(HugePageGroup* group, Address base, size_t size);
+
   // Initializes pages in a chunk. Returns the first page address.
   // This function and GetChunkId() are provided for the mark-compact
   // collector to rebuild page headers in the from space, which is
@@ -1527,7 +1568,12 @@ class MemoryAllocator {
   // Data structure to remember allocated executable memory chunks.
   std::unordered_set<MemoryChunk*> executable_memory_;
 
+  base::Mutex huge_page_groups_mutex_;
+  // Groups of old and map space.
+  HugePageGroup huge_page_groups_[2];
+
   friend class heap::TestCodePageAllocatorScope;
+  friend class heap::TestDataPageAllocatorScope;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(MemoryAllocator);
 };
@@ -1554,6 +1600,9 @@ extern template EXPORT_TEMPLATE_DECLARE(
 extern template EXPORT_TEMPLATE_DECLARE(
     V8_EXPORT_PRIVATE) void MemoryAllocator::
     Free<MemoryAllocator::kPooledAndQueue>(MemoryChunk* chunk);
+extern template EXPORT_TEMPLATE_DECLARE(
+    V8_EXPORT_PRIVATE) void MemoryAllocator::
+    Free<MemoryAllocator::kPreFree>(MemoryChunk* chunk);
 
 // -----------------------------------------------------------------------------
 // Interface for heap object iterator to be implemented by all object space
@@ -2349,6 +2398,17 @@ class V8_EXPORT_PRIVATE PagedSpace
       int size_in_bytes, AllocationAlignment alignment,
       AllocationOrigin origin = AllocationOrigin::kRuntime);
 
+  // Allocate the requested number of bytes in the space from a background
+  // thread. Returns the start address and size of a linear allocation area
+  // of at least |min_size_in_bytes| and at most |max_size_in_bytes| bytes, or
+  // an empty optional if the main thread has to collect garbage first.
+  V8_WARN_UNUSED_RESULT base::Optional<std::pair<Address, size_t>>
+  SlowGetLinearAllocationAreaBackground(LocalHeap* local_heap,
+                                        size_t min_size_in_bytes,
+                                        size_t max_size_in_bytes,
+                                        AllocationAlignment alignment,
+                                        AllocationOrigin origin);
+
   size_t Free(Address start, size_t size_in_bytes, SpaceAccountingMode mode) {
     if (size_in_bytes == 0) return 0;
     heap()->CreateFillerObjectAt(start, static_cast<int>(size_in_bytes),
@@ -2509,6 +2569,13 @@ class V8_EXPORT_PRIVATE PagedSpace
     return identity() == OLD_SPACE && !is_local_space();
   }
 
+  // Background threads allocate directly from the free list of the main old
+  // space when --local-heaps is enabled. Main thread accesses to the free
+  // list then have to hold the allocation mutex as well.
+  bool SupportsConcurrentAllocation() {
+    return FLAG_local_heaps && identity() == OLD_SPACE && !is_local_space();
+  }
+
  protected:
   // PagedSpaces that should be included in snapshots have different, i.e.,
   // smaller, initial pages.
@@ -2525,6 +2592,28 @@ class V8_EXPORT_PRIVATE PagedSpace
   // size limit has been hit.
   bool Expand();
 
+  // Expands the space by a single page from a background thread and returns
+  // an allocation area of |size_in_bytes| at the start of the new page.
+  base::Optional<std::pair<Address, size_t>> ExpandBackground(
+      LocalHeap* local_heap, size_t size_in_bytes);
+
+  // Implementation of SlowGetLinearAllocationAreaBackground. The caller has to
+  // hold the allocation mutex.
+  base::Optional<std::pair<Address, size_t>>
+  RawSlowGetLinearAllocationAreaBackground(LocalHeap* local_heap,
+                                           size_t min_size_in_bytes,
+                                           size_t max_size_in_bytes,
+                                           AllocationAlignment alignment,
+                                           AllocationOrigin origin);
+
+  // Tries to take a linear allocation area for a background thread from the
+  // free list. The caller has to hold the allocation mutex.
+  base::Optional<std::pair<Address, size_t>>
+  TryAllocationFromFreeListBackground(size_t min_size_in_bytes,
+                                      size_t max_size_in_bytes,
+                                      AllocationAlignment alignment,
+                                      AllocationOrigin origin);
+
   // Sets up a linear allocation area that fits the given number of bytes.
   // Returns false if there is not enough space and the caller has to retry
   // after collecting garbage.
@@ -2578,6 +2667,11 @@ class V8_EXPORT_PRIVATE PagedSpace
   // Mutex guarding any concurrent access to the space.
   base::Mutex space_mutex_;
 
+  // Mutex guarding the free list against concurrent allocation from
+  // background threads. Recursive since free list refills from the sweeper
+  // may happen while the main thread is already in the allocation slow path.
+  base::RecursiveMutex allocation_mutex_;
+
   friend class IncrementalMarking;
   friend class MarkCompactCollector;
 
@@ -2806,6 +2900,10 @@ class V8_EXPORT_PRIVATE NewSpace
   // Grow the capacity of the semispaces.  Assumes that they are not at
   // their maximum capacity.
   void Grow();
+  // Same as above, but grows by |factor| instead of
+  // --semi-space-growth-factor. The new capacity is rounded down to pages.
+  // Does nothing for factors of at most 1.
+  void GrowBy(double factor);
 
   // Shrink the capacity of the semispaces.
   void Shrink();
@@ -3280,6 +3378,11 @@ class LargeObjectSpace : public Space {
 
   LargePage* AllocateLargePage(int object_size, Executability executable);
 
+  // Removes the pages of unmarked objects from the space and shrinks the pages
+  // of marked objects. Removed pages are passed to |free_page|.
+  template <typename FreePageCallback>
+  void RemoveUnmarkedObjects(FreePageCallback free_page);
+
   size_t size_;          // allocated bytes
   int page_count_;       // number of chunks
   size_t objects_size_;  // size of objects
@@ -3300,6 +3403,10 @@ class OldLargeObjectSpace : public LargeObjectSpace {
   // Clears the marking state of live objects.
   void ClearMarkingStateOfLiveObjects();
 
+  // Like FreeUnmarkedObjects() but leaves releasing the pages of unmarked
+  // objects to the sweeper tasks.
+  void FreeUnmarkedObjectsConcurrently(Sweeper* sweeper);
+
   void PromoteNewLargeObject(LargePage* page);
 
   V8_EXPORT_PRIVATE void MergeOffThreadSpace(OffThreadLargeObjectSpace* other);
@@ -20,6 +20,7 @@ Sweeper::Sweeper(Heap* heap, MajorNonAtomicMarkingState* marking_state)
       marking_state_(marking_state),
       num_tasks_(0),
       pending_sweeper_tasks_semaphore_(0),
+      released_large_pages_(false),
       incremental_sweeper_pending_(false),
       sweeping_in_progress_(false),
       num_sweeping_tasks_(0),
@@ -94,18 +95,26 @@ class Sweeper::SweeperTask final : public CancelableTask {
 
  private:
   void RunInternal() final {
-    TRACE_BACKGROUND_GC(tracer_,
-                        GCTracer::BackgroundScope::MC_BACKGROUND_SWEEPING);
-    DCHECK(IsValidSweepingSpace(space_to_start_));
-    const int offset = space_to_start_ - FIRST_GROWABLE_PAGED_SPACE;
-    for (int i = 0; i < kNumberOfSweepingSpaces; i++) {
-      const AllocationSpace space_id = static_cast<AllocationSpace>(
-          FIRST_GROWABLE_PAGED_SPACE +
-          ((i + offset) % kNumberOfSweepingSpaces));
-      // Do not sweep code space concurrently.
-      if (space_id == CODE_SPACE) continue;
-      DCHECK(IsValidSweepingSpace(space_id));
-      sweeper_->SweepSpaceFromTask(space_id);
+    {
+      TRACE_BACKGROUND_GC(
+          tracer_,
+          GCTracer::BackgroundScope::MC_BACKGROUND_LARGE_OBJECT_SWEEPING);
+      sweeper_->ReleaseLargePagesFromTask();
+    }
+    {
+      TRACE_BACKGROUND_GC(tracer_,
+                          GCTracer::BackgroundScope::MC_BACKGROUND_SWEEPING);
+      DCHECK(IsValidSweepingSpace(space_to_start_));
+      const int offset = space_to_start_ - FIRST_GROWABLE_PAGED_SPACE;
+      for (int i = 0; i < kNumberOfSweepingSpaces; i++) {
+        const AllocationSpace space_id = static_cast<AllocationSpace>(
+            FIRST_GROWABLE_PAGED_SPACE +
+            ((i + offset) % kNumberOfSweepingSpaces));
+        // Do not sweep code space concurrently.
+        if (space_id == CODE_SPACE) continue;
+        DCHECK(IsValidSweepingSpace(space_id));
+        sweeper_->SweepSpaceFromTask(space_id);
+      }
     }
     (*num_sweeping_tasks_)--;
     pending_sweeper_tasks_->Signal();
@@ -248,12 +257,21 @@ void Sweeper::EnsureCompleted() {
   // here.
   ForAllSweepingSpaces(
       [this](AllocationSpace space) { ParallelSweepSpace(space, 0); });
+  LargePage* large_page = nullptr;
+  while ((large_page = GetLargePageSafe()) != nullptr) {
+    ReleaseLargePage(large_page);
+  }
 
   AbortAndWaitForTasks();
 
   ForAllSweepingSpaces([this](AllocationSpace space) {
     CHECK(sweeping_list_[GetSweepSpaceIndex(space)].empty());
   });
+  CHECK(large_pages_.empty());
+  if (released_large_pages_) {
+    heap_->memory_allocator()->unmapper()->FreeQueuedChunks();
+    released_large_pages_ = false;
+  }
   sweeping_in_progress_ = false;
 }
 
@@ -408,6 +426,36 @@ int Sweeper::RawSweep(
       p->free_list()->GuaranteedAllocatable(max_freed_bytes));
 }
 
+void Sweeper::AddLargePage(LargePage* page) {
+  DCHECK(sweeping_in_progress_);
+  DCHECK(page->IsFlagSet(MemoryChunk::PRE_FREED));
+  base::MutexGuard guard(&mutex_);
+  large_pages_.push_back(page);
+  released_large_pages_ = true;
+}
+
+LargePage* Sweeper::GetLargePageSafe() {
+  base::MutexGuard guard(&mutex_);
+  if (large_pages_.empty()) return nullptr;
+  LargePage* page = large_pages_.back();
+  large_pages_.pop_back();
+  return page;
+}
+
+void Sweeper::ReleaseLargePage(LargePage* page) {
+  // The page is not reachable from its space anymore, so no other thread
+  // accesses its remembered sets and bitmaps.
+  page->ReleaseAllAllocatedMemory();
+  heap_->memory_allocator()->unmapper()->AddMemoryChunkSafe(page);
+}
+
+void Sweeper::ReleaseLargePagesFromTask() {
+  LargePage* page = nullptr;
+  while (!stop_sweeper_tasks_ && ((page = GetLargePageSafe()) != nullptr)) {
+    ReleaseLargePage(page);
+  }
+}
+
 void Sweeper::SweepSpaceFromTask(AllocationSpace identity) {
   Page* page = nullptr;
   while (!stop_sweeper_tasks_ &&
@@ -15,6 +15,7 @@
 namespace v8 {
 namespace internal {
 
+class LargePage;
 class MajorNonAtomicMarkingState;
 class Page;
 class PagedSpace;
@@ -26,6 +27,7 @@ class Sweeper {
   using IterabilityList = std::vector<Page*>;
   using SweepingList = std::vector<Page*>;
   using SweptList = std::vector<Page*>;
+  using LargePageList = std::vector<LargePage*>;
 
   // Pauses the sweeper tasks or completes sweeping.
   class PauseOrCompleteScope final {
@@ -79,6 +81,11 @@ class Sweeper {
 
   void AddPage(AllocationSpace space, Page* page, AddPageMode mode);
 
+  // Adds a dead large page that was already removed from its space. Its
+  // remaining memory is released by the sweeper tasks or, at the latest, in
+  // EnsureCompleted().
+  void AddLargePage(LargePage* page);
+
   int ParallelSweepSpace(
       AllocationSpace identity, int required_freed_bytes, int max_pages = 0,
       FreeSpaceMayContainInvalidatedSlots invalidated_slots_in_free_space =
@@ -134,11 +141,17 @@ class Sweeper {
     ForAllSweepingSpaces([this, &is_done](AllocationSpace space) {
       if (!sweeping_list_[GetSweepSpaceIndex(space)].empty()) is_done = false;
     });
-    return is_done;
+    return is_done && large_pages_.empty();
   }
 
   void SweepSpaceFromTask(AllocationSpace identity);
 
+  // Releases the side tables of dead large pages and queues the pages on the
+  // unmapper.
+  void ReleaseLargePagesFromTask();
+  void ReleaseLargePage(LargePage* page);
+  LargePage* GetLargePageSafe();
+
   // Sweeps incrementally one page from the given space. Returns true if
   // there are no more pages to sweep in the given space.
   bool SweepSpaceIncrementallyFromTask(AllocationSpace identity);
@@ -175,6 +188,10 @@ class Sweeper {
   base::Mutex mutex_;
   SweptList swept_list_[kNumberOfSweepingSpaces];
   SweepingList sweeping_list_[kNumberOfSweepingSpaces];
+  LargePageList large_pages_;
+  // Set when dead large pages were added in the current cycle, so that the
+  // unmapper is triggered once they have all been released.
+  bool released_large_pages_;
   bool incremental_sweeper_pending_;
   bool sweeping_in_progress_;
   // Counter is actively maintained by the concurrent tasks to avoid querying
@@ -155,6 +155,9 @@ void IsolateAllocator::CommitPagesForIsolate(Address heap_reservation_address) {
   page_allocator_instance_ = std::make_unique<base::BoundedPageAllocator>(
       platform_page_allocator, isolate_root, kPtrComprHeapReservationSize,
       page_size);
+  // Heap pages are grouped into huge page blocks through address hints.
+  page_allocator_instance_->set_honor_address_hints(
+      FLAG_transparent_huge_pages);
   page_allocator_ = page_allocator_instance_.get();
 
   Address isolate_address = isolate_root - Isolate::isolate_root_bias();
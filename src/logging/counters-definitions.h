@@ -28,6 +28,8 @@ namespace internal {
   HR(gc_finalize_sweep, V8.GCFinalizeMC.Sweep, 0, 10000, 101)                  \
   HR(gc_scavenger_scavenge_main, V8.GCScavenger.ScavengeMain, 0, 10000, 101)   \
   HR(gc_scavenger_scavenge_roots, V8.GCScavenger.ScavengeRoots, 0, 10000, 101) \
+  HR(gc_minor_mc_mark, V8.GCMinorMC.Mark, 0, 10000, 101)                       \
+  HR(gc_minor_mc_evacuate, V8.GCMinorMC.Evacuate, 0, 10000, 101)               \
   HR(gc_mark_compactor, V8.GCMarkCompactor, 0, 10000, 101)                     \
   HR(gc_marking_sum, V8.GCMarkingSum, 0, 10000, 101)                           \
   /* Range and bucket matches BlinkGC.MainThreadMarkingThroughput. */          \
@@ -149,6 +151,7 @@ namespace internal {
   HT(gc_scavenger, V8.GCScavenger, 10000, MILLISECOND)                         \
   HT(gc_scavenger_background, V8.GCScavengerBackground, 10000, MILLISECOND)    \
   HT(gc_scavenger_foreground, V8.GCScavengerForeground, 10000, MILLISECOND)    \
+  HT(gc_minor_mc, V8.GCMinorMC, 10000, MILLISECOND)                            \
   /* TurboFan timers. */                                                       \
   HT(turbofan_optimize_prepare, V8.TurboFanOptimizePrepare, 1000000,           \
      MICROSECOND)                                                              \
@@ -334,12 +337,24 @@ namespace internal {
   /* Total count of functions compiled using the baseline compiler. */         \
   SC(total_baseline_compile_count, V8.TotalBaselineCompileCount)
 
-#define STATS_COUNTER_TS_LIST(SC)                                    \
-  SC(wasm_generated_code_size, V8.WasmGeneratedCodeBytes)            \
-  SC(wasm_reloc_size, V8.WasmRelocBytes)                             \
-  SC(wasm_lazily_compiled_functions, V8.WasmLazilyCompiledFunctions) \
-  SC(liftoff_compiled_functions, V8.LiftoffCompiledFunctions)        \
-  SC(liftoff_unsupported_functions, V8.LiftoffUnsupportedFunctions)
+#define STATS_COUNTER_TS_LIST(SC)                                     \
+  SC(wasm_generated_code_size, V8.WasmGeneratedCodeBytes)             \
+  SC(wasm_reloc_size, V8.WasmRelocBytes)                              \
+  SC(wasm_lazily_compiled_functions, V8.WasmLazilyCompiledFunctions)  \
+  SC(wasm_lazily_deserialized_functions,                              \
+     V8.WasmLazilyDeserializedFunctions)                              \
+  SC(liftoff_compiled_functions, V8.LiftoffCompiledFunctions)         \
+  SC(liftoff_unsupported_functions, V8.LiftoffUnsupportedFunctions)   \
+  /* Top tier compilations requested by hot Liftoff code. */          \
+  SC(wasm_tier_up_requests, V8.WasmTierUpRequests)                    \
+  /* Heap chunks bound to a NUMA node with --numa-aware-heap. */      \
+  SC(gc_numa_bound_chunks, V8.GCNumaBoundChunks)                      \
+  /* Parallel GC work items processed on the node of their memory. */ \
+  SC(gc_numa_local_items, V8.GCNumaLocalItems)                        \
+  /* Parallel GC work items processed on a different node. */         \
+  SC(gc_numa_remote_items, V8.GCNumaRemoteItems)                      \
+  /* Heap chunks advised to use transparent huge pages. */            \
+  SC(gc_huge_page_chunks, V8.GCHugePageChunks)
 
 // List of counters that can be incremented from generated code. We need them in
 // a separate list to be able to relocate them.
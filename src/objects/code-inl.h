@@ -682,6 +682,15 @@ void BytecodeArray::set_bytecode_age(BytecodeArray::Age age) {
   RELAXED_WRITE_INT8_FIELD(*this, kBytecodeAgeOffset, static_cast<int8_t>(age));
 }
 
+bool BytecodeArray::was_optimized() const {
+  return WasOptimizedField::decode(ReadField<uint8_t>(kFlagsOffset));
+}
+
+void BytecodeArray::set_was_optimized(bool value) {
+  uint8_t flags = ReadField<uint8_t>(kFlagsOffset);
+  WriteField<uint8_t>(kFlagsOffset, WasOptimizedField::update(flags, value));
+}
+
 int32_t BytecodeArray::parameter_count() const {
   // Parameter count is stored as the size on stack of the parameters to allow
   // it to be used directly by generated code.
@@ -774,6 +774,13 @@ class BytecodeArray : public FixedArrayBase {
   inline Age bytecode_age() const;
   inline void set_bytecode_age(Age age);
 
+  // Whether TurboFan code was installed for a closure of this bytecode since
+  // its last eager deoptimization. The bit is preserved by the code cache and
+  // serves as a tier-up hint after deserialization (see
+  // --code-cache-optimization-hints).
+  inline bool was_optimized() const;
+  inline void set_was_optimized(bool value);
+
   // Accessors for the constant pool.
   DECL_ACCESSORS(constant_pool, FixedArray)
 
@@ -842,6 +849,13 @@ class BytecodeArray : public FixedArrayBase {
   STATIC_ASSERT(BytecodeArray::kBytecodeAgeOffset ==
                 kOsrNestingLevelOffset + kCharSize);
 
+  // Flags layout.  base::BitField<type, shift, size>.
+#define BYTECODE_ARRAY_FLAGS_BIT_FIELDS(V, _) V(WasOptimizedField, bool, 1, _)
+  DEFINE_BIT_FIELDS(BYTECODE_ARRAY_FLAGS_BIT_FIELDS)
+#undef BYTECODE_ARRAY_FLAGS_BIT_FIELDS
+  static_assert(WasOptimizedField::kLastUsedBit < 8,
+                "BytecodeArray::flags field exhausted");
+
   // Maximal memory consumption for a single BytecodeArray.
   static const int kMaxSize = 512 * MB;
   // Maximal length of a single BytecodeArray.
@@ -109,11 +109,20 @@ INT32_ACCESSORS(FeedbackVector, length, kLengthOffset)
 INT32_ACCESSORS(FeedbackVector, invocation_count, kInvocationCountOffset)
 INT32_ACCESSORS(FeedbackVector, profiler_ticks, kProfilerTicksOffset)
 
-void FeedbackVector::clear_padding() {
-  if (FIELD_SIZE(kPaddingOffset) == 0) return;
-  DCHECK_EQ(4, FIELD_SIZE(kPaddingOffset));
-  memset(reinterpret_cast<void*>(address() + kPaddingOffset), 0,
-         FIELD_SIZE(kPaddingOffset));
+uint32_t FeedbackVector::flags() const {
+  return ReadField<uint32_t>(kFlagsOffset);
+}
+
+void FeedbackVector::set_flags(uint32_t flags) {
+  WriteField<uint32_t>(kFlagsOffset, flags);
+}
+
+OptimizationTier FeedbackVector::optimization_tier() const {
+  return OptimizationTierBits::decode(flags());
+}
+
+void FeedbackVector::set_optimization_tier(OptimizationTier tier) {
+  set_flags(OptimizationTierBits::update(flags(), tier));
 }
 
 bool FeedbackVector::is_empty() const { return length() == 0; }
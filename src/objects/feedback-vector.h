@@ -174,6 +174,7 @@ class ClosureFeedbackCellArray : public FixedArray {
 //  - invocation count
 //  - runtime profiler ticks
 //  - optimized code cell (weak cell or Smi marker)
+//  - flags (currently only the optimization tier)
 // followed by an array of feedback slots, of length determined by the feedback
 // metadata.
 class FeedbackVector : public HeapObject {
@@ -209,8 +210,14 @@ class FeedbackVector : public HeapObject {
   // runtime profiler.
   DECL_INT32_ACCESSORS(profiler_ticks)
 
-  // Initialize the padding if necessary.
-  inline void clear_padding();
+  // [flags]: Bit field, see OptimizationTierBits below.
+  DECL_PRIMITIVE_ACCESSORS(flags, uint32_t)
+
+  // The highest tier the function has been optimized for. Unlike the optimized
+  // code slot this survives deoptimization, so the compiler can skip the mid
+  // tier for functions that have already been through it.
+  inline OptimizationTier optimization_tier() const;
+  inline void set_optimization_tier(OptimizationTier tier);
 
   inline void clear_invocation_count();
 
@@ -314,6 +321,8 @@ class FeedbackVector : public HeapObject {
   DEFINE_FIELD_OFFSET_CONSTANTS(HeapObject::kHeaderSize,
                                 TORQUE_GENERATED_FEEDBACK_VECTOR_FIELDS)
 
+  using OptimizationTierBits = base::BitField<OptimizationTier, 0, 2>;
+
   static_assert(kSize % kObjectAlignment == 0,
                 "Header must be padded for alignment");
   static const int kFeedbackSlotsOffset = kHeaderSize;
@@ -4,13 +4,18 @@
 
 #include "src/profiler/heap-snapshot-generator.h"
 
+#include <functional>
 #include <utility>
 
 #include "src/api/api-inl.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/semaphore.h"
 #include "src/codegen/assembler-inl.h"
 #include "src/debug/debug.h"
 #include "src/handles/global-handles.h"
 #include "src/heap/combined-heap.h"
+#include "src/init/v8.h"
 #include "src/numbers/conversions.h"
 #include "src/objects/allocation-site-inl.h"
 #include "src/objects/api-callbacks.h"
@@ -35,6 +40,7 @@
 #include "src/profiler/allocation-tracker.h"
 #include "src/profiler/heap-profiler.h"
 #include "src/profiler/heap-snapshot-generator-inl.h"
+#include "src/tasks/cancelable-task.h"
 #include "src/utils/vector.h"
 
 namespace v8 {
@@ -2124,6 +2130,10 @@ class OutputStreamWriter {
   void AddSubstring(const char* s, int n) {
     if (n <= 0) return;
     DCHECK_LE(n, strlen(s));
+    AddBytes(s, n);
+  }
+  // Like AddSubstring, but the data may contain \0 characters.
+  void AddBytes(const char* s, int n) {
     const char* s_end = s + n;
     while (s < s_end) {
       int s_chunk_size =
@@ -2186,6 +2196,157 @@ class OutputStreamWriter {
   bool aborted_;
 };
 
+namespace {
+
+// Formats a section of the snapshot, i.e. the nodes or the edges, in shards of
+// consecutive items on worker threads. The main thread writes the shards to
+// the output stream strictly in order as soon as they are formatted and helps
+// formatting whenever the next shard is not claimed yet. Workers stay within
+// a bounded window ahead of the writer, so only a few formatted shards are
+// alive at any time regardless of the snapshot size.
+class ParallelSectionSerializer {
+ public:
+  // Formats the item with the given index into |buffer| starting at
+  // |buffer_pos| and returns the position after the last written character.
+  using FormatItemCallback =
+      std::function<int(size_t, const Vector<char>&, int)>;
+
+  static const size_t kItemsPerShard = 16 * KB;
+
+  ParallelSectionSerializer(Isolate* isolate, size_t item_count,
+                            int max_item_length, FormatItemCallback format_item)
+      : isolate_(isolate),
+        item_count_(item_count),
+        max_item_length_(max_item_length),
+        format_item_(std::move(format_item)),
+        shards_((item_count + kItemsPerShard - 1) / kItemsPerShard),
+        pending_tasks_(0) {}
+
+  void Run(OutputStreamWriter* writer);
+
+ private:
+  class Task : public CancelableTask {
+   public:
+    Task(Isolate* isolate, ParallelSectionSerializer* serializer)
+        : CancelableTask(isolate), serializer_(serializer) {}
+
+    void RunInternal() override {
+      serializer_->FormatShardsOnWorkerThread();
+      serializer_->pending_tasks_.Signal();
+    }
+
+   private:
+    ParallelSectionSerializer* serializer_;
+  };
+
+  struct Shard {
+    std::unique_ptr<char[]> buffer;
+    int length = 0;
+    bool formatted = false;
+  };
+
+  void FormatShard(size_t index);
+  void FormatShardsOnWorkerThread();
+
+  Isolate* isolate_;
+  const size_t item_count_;
+  const int max_item_length_;
+  FormatItemCallback format_item_;
+  std::vector<Shard> shards_;
+  size_t max_shards_in_flight_ = 1;
+  base::Semaphore pending_tasks_;
+
+  base::Mutex mutex_;
+  base::ConditionVariable cond_;
+  // The fields below are guarded by |mutex_|.
+  size_t next_shard_ = 0;
+  size_t written_shards_ = 0;
+  bool aborted_ = false;
+};
+
+void ParallelSectionSerializer::FormatShard(size_t index) {
+  size_t start = index * kItemsPerShard;
+  size_t end = Min(start + kItemsPerShard, item_count_);
+  size_t size = (end - start) * max_item_length_ + 1;
+  DCHECK_GE(kMaxInt, size);
+  Shard& shard = shards_[index];
+  shard.buffer.reset(new char[size]);
+  Vector<char> buffer(shard.buffer.get(), size);
+  int buffer_pos = 0;
+  for (size_t i = start; i < end; i++) {
+    buffer_pos = format_item_(i, buffer, buffer_pos);
+  }
+  buffer[buffer_pos] = '\0';
+  shard.length = buffer_pos;
+}
+
+void ParallelSectionSerializer::FormatShardsOnWorkerThread() {
+  while (true) {
+    size_t index;
+    {
+      base::MutexGuard guard(&mutex_);
+      while (!aborted_ && next_shard_ < shards_.size() &&
+             next_shard_ >= written_shards_ + max_shards_in_flight_) {
+        cond_.Wait(&mutex_);
+      }
+      if (aborted_ || next_shard_ == shards_.size()) return;
+      index = next_shard_++;
+    }
+    FormatShard(index);
+    {
+      base::MutexGuard guard(&mutex_);
+      shards_[index].formatted = true;
+    }
+    cond_.NotifyAll();
+  }
+}
+
+void ParallelSectionSerializer::Run(OutputStreamWriter* writer) {
+  const size_t num_tasks = Min(
+      static_cast<size_t>(V8::GetCurrentPlatform()->NumberOfWorkerThreads()),
+      shards_.size() > 0 ? shards_.size() - 1 : 0);
+  max_shards_in_flight_ = 2 * (num_tasks + 1);
+  std::vector<CancelableTaskManager::Id> task_ids;
+  for (size_t i = 0; i < num_tasks; i++) {
+    auto task = std::make_unique<Task>(isolate_, this);
+    task_ids.push_back(task->id());
+    V8::GetCurrentPlatform()->CallOnWorkerThread(std::move(task));
+  }
+
+  for (size_t index = 0; index < shards_.size(); index++) {
+    bool claimed = false;
+    {
+      base::MutexGuard guard(&mutex_);
+      if (next_shard_ == index) {
+        next_shard_++;
+        claimed = true;
+      } else {
+        while (!shards_[index].formatted) cond_.Wait(&mutex_);
+      }
+    }
+    if (claimed) FormatShard(index);
+    Shard& shard = shards_[index];
+    writer->AddSubstring(shard.buffer.get(), shard.length);
+    shard.buffer.reset();
+    {
+      base::MutexGuard guard(&mutex_);
+      written_shards_ = index + 1;
+      aborted_ = writer->aborted();
+    }
+    cond_.NotifyAll();
+    if (writer->aborted()) break;
+  }
+
+  for (CancelableTaskManager::Id id : task_ids) {
+    if (isolate_->cancelable_task_manager()->TryAbort(id) !=
+        TryAbortResult::kTaskAborted) {
+      pending_tasks_.Wait();
+    }
+  }
+}
+
+}  // namespace
+
 
 // type, name|index, to_node.
 const int HeapSnapshotJSONSerializer::kEdgeFieldsCount = 3;
@@ -2258,6 +2419,13 @@ int HeapSnapshotJSONSerializer::GetStringId(const char* s) {
   return static_cast<int>(reinterpret_cast<intptr_t>(cache_entry->value));
 }
 
+int HeapSnapshotJSONSerializer::FindStringId(const char* s) const {
+  base::HashMap::Entry* cache_entry =
+      strings_.Lookup(const_cast<char*>(s), StringHash(s));
+  DCHECK_NOT_NULL(cache_entry);
+  return static_cast<int>(reinterpret_cast<intptr_t>(cache_entry->value));
+}
+
 
 namespace {
 
@@ -2302,31 +2470,68 @@ static int utoa(T value, const Vector<char>& buffer, int buffer_pos) {
 }
 
 
-void HeapSnapshotJSONSerializer::SerializeEdge(HeapGraphEdge* edge,
-                                               bool first_edge) {
-  // The buffer needs space for 3 unsigned ints, 3 commas, \n and \0
-  static const int kBufferSize =
-      MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned * 3 + 3 + 2;  // NOLINT
-  EmbeddedVector<char, kBufferSize> buffer;
-  int edge_name_or_index = edge->type() == HeapGraphEdge::kElement
-      || edge->type() == HeapGraphEdge::kHidden
-      ? edge->index() : GetStringId(edge->name());
-  int buffer_pos = 0;
+// The buffer needs space for 3 unsigned ints, 3 commas, \n and \0
+static const int kEdgeBufferSize =
+    MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned * 3 + 3 + 2;  // NOLINT
+
+// The buffer needs space for 4 unsigned ints, 1 size_t, 5 commas, \n and \0
+static const int kNodeBufferSize =
+    5 * MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned  // NOLINT
+    + MaxDecimalDigitsIn<sizeof(size_t)>::kUnsigned      // NOLINT
+    + 6 + 1 + 1;
+
+int HeapSnapshotJSONSerializer::FormatEdge(HeapGraphEdge* edge,
+                                           bool first_edge, int name_or_index,
+                                           const Vector<char>& buffer,
+                                           int buffer_pos) {
   if (!first_edge) {
     buffer[buffer_pos++] = ',';
   }
   buffer_pos = utoa(edge->type(), buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(edge_name_or_index, buffer, buffer_pos);
+  buffer_pos = utoa(name_or_index, buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
   buffer_pos = utoa(to_node_index(edge->to()), buffer, buffer_pos);
   buffer[buffer_pos++] = '\n';
+  return buffer_pos;
+}
+
+void HeapSnapshotJSONSerializer::SerializeEdge(HeapGraphEdge* edge,
+                                               bool first_edge) {
+  EmbeddedVector<char, kEdgeBufferSize> buffer;
+  int edge_name_or_index = edge->type() == HeapGraphEdge::kElement
+      || edge->type() == HeapGraphEdge::kHidden
+      ? edge->index() : GetStringId(edge->name());
+  int buffer_pos = FormatEdge(edge, first_edge, edge_name_or_index, buffer, 0);
   buffer[buffer_pos++] = '\0';
   writer_->AddString(buffer.begin());
 }
 
 void HeapSnapshotJSONSerializer::SerializeEdges() {
   std::vector<HeapGraphEdge*>& edges = snapshot_->children();
+  if (FLAG_parallel_heap_snapshot_serialization) {
+    // Assign the string ids up front in the same order as the sequential
+    // path below, so that both produce identical output.
+    for (HeapGraphEdge* edge : edges) {
+      if (edge->type() != HeapGraphEdge::kElement &&
+          edge->type() != HeapGraphEdge::kHidden) {
+        GetStringId(edge->name());
+      }
+    }
+    ParallelSectionSerializer serializer(
+        snapshot_->profiler()->isolate(), edges.size(), kEdgeBufferSize - 1,
+        [this, &edges](size_t i, const Vector<char>& buffer, int buffer_pos) {
+          HeapGraphEdge* edge = edges[i];
+          bool indexed = edge->type() == HeapGraphEdge::kElement ||
+                         edge->type() == HeapGraphEdge::kHidden;
+          int edge_name_or_index =
+              indexed ? edge->index() : FindStringId(edge->name());
+          return FormatEdge(edge, i == 0, edge_name_or_index, buffer,
+                            buffer_pos);
+        });
+    serializer.Run(writer_);
+    return;
+  }
   for (size_t i = 0; i < edges.size(); ++i) {
     DCHECK(i == 0 ||
            edges[i - 1]->from()->index() <= edges[i]->from()->index());
@@ -2335,20 +2540,15 @@ void HeapSnapshotJSONSerializer::SerializeEdges() {
   }
 }
 
-void HeapSnapshotJSONSerializer::SerializeNode(const HeapEntry* entry) {
-  // The buffer needs space for 4 unsigned ints, 1 size_t, 5 commas, \n and \0
-  static const int kBufferSize =
-      5 * MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned  // NOLINT
-      + MaxDecimalDigitsIn<sizeof(size_t)>::kUnsigned  // NOLINT
-      + 6 + 1 + 1;
-  EmbeddedVector<char, kBufferSize> buffer;
-  int buffer_pos = 0;
+int HeapSnapshotJSONSerializer::FormatNode(const HeapEntry* entry, int name_id,
+                                           const Vector<char>& buffer,
+                                           int buffer_pos) {
   if (to_node_index(entry) != 0) {
     buffer[buffer_pos++] = ',';
   }
   buffer_pos = utoa(entry->type(), buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(GetStringId(entry->name()), buffer, buffer_pos);
+  buffer_pos = utoa(name_id, buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
   buffer_pos = utoa(entry->id(), buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
@@ -2358,12 +2558,31 @@ void HeapSnapshotJSONSerializer::SerializeNode(const HeapEntry* entry) {
   buffer[buffer_pos++] = ',';
   buffer_pos = utoa(entry->trace_node_id(), buffer, buffer_pos);
   buffer[buffer_pos++] = '\n';
+  return buffer_pos;
+}
+
+void HeapSnapshotJSONSerializer::SerializeNode(const HeapEntry* entry) {
+  EmbeddedVector<char, kNodeBufferSize> buffer;
+  int buffer_pos =
+      FormatNode(entry, GetStringId(entry->name()), buffer, 0);
   buffer[buffer_pos++] = '\0';
   writer_->AddString(buffer.begin());
 }
 
 void HeapSnapshotJSONSerializer::SerializeNodes() {
   const std::deque<HeapEntry>& entries = snapshot_->entries();
+  if (FLAG_parallel_heap_snapshot_serialization) {
+    for (const HeapEntry& entry : entries) GetStringId(entry.name());
+    ParallelSectionSerializer serializer(
+        snapshot_->profiler()->isolate(), entries.size(), kNodeBufferSize - 1,
+        [this, &entries](size_t i, const Vector<char>& buffer, int buffer_pos) {
+          const HeapEntry* entry = &entries[i];
+          return FormatNode(entry, FindStringId(entry->name()), buffer,
+                            buffer_pos);
+        });
+    serializer.Run(writer_);
+    return;
+  }
   for (const HeapEntry& entry : entries) {
     SerializeNode(&entry);
     if (writer_->aborted()) return;
@@ -2680,5 +2899,170 @@ void HeapSnapshotJSONSerializer::SerializeLocations() {
   }
 }
 
+const char HeapSnapshotBinarySerializer::kMagic[4] = {'V', '8', 'H', 'S'};
+
+void HeapSnapshotBinarySerializer::Serialize(v8::OutputStream* stream) {
+  if (AllocationTracker* allocation_tracker =
+          snapshot_->profiler()->allocation_tracker()) {
+    allocation_tracker->PrepareForSerialization();
+  }
+  DCHECK_NULL(writer_);
+  writer_ = new OutputStreamWriter(stream);
+  SerializeImpl();
+  delete writer_;
+  writer_ = nullptr;
+}
+
+void HeapSnapshotBinarySerializer::SerializeImpl() {
+  DCHECK_EQ(0, snapshot_->root()->index());
+  writer_->AddBytes(kMagic, sizeof(kMagic));
+  WriteVarint(kVersion);
+  AllocationTracker* tracker = snapshot_->profiler()->allocation_tracker();
+  WriteVarint(snapshot_->entries().size());
+  WriteVarint(snapshot_->edges().size());
+  WriteVarint(tracker ? tracker->function_info_list().size() : 0);
+  SerializeNodes();
+  if (writer_->aborted()) return;
+  SerializeEdges();
+  if (writer_->aborted()) return;
+  SerializeTraceNodeInfos();
+  if (writer_->aborted()) return;
+  SerializeTraceTree();
+  if (writer_->aborted()) return;
+  SerializeSamples();
+  if (writer_->aborted()) return;
+  SerializeLocations();
+  if (writer_->aborted()) return;
+  SerializeStrings();
+  if (writer_->aborted()) return;
+  writer_->Finalize();
+}
+
+int HeapSnapshotBinarySerializer::GetStringId(const char* s) {
+  uint32_t hash = StringHasher::HashSequentialString(
+      s, static_cast<int>(strlen(s)), kZeroHashSeed);
+  base::HashMap::Entry* cache_entry =
+      strings_.LookupOrInsert(const_cast<char*>(s), hash);
+  if (cache_entry->value == nullptr) {
+    cache_entry->value = reinterpret_cast<void*>(next_string_id_++);
+  }
+  return static_cast<int>(reinterpret_cast<intptr_t>(cache_entry->value));
+}
+
+void HeapSnapshotBinarySerializer::WriteVarint(uint64_t value) {
+  // Up to 10 bytes of 7 bits each are needed for a 64-bit value.
+  char buffer[10];
+  int length = 0;
+  do {
+    uint8_t byte = value & 0x7F;
+    value >>= 7;
+    if (value != 0) byte |= 0x80;
+    buffer[length++] = static_cast<char>(byte);
+  } while (value != 0);
+  writer_->AddBytes(buffer, length);
+}
+
+void HeapSnapshotBinarySerializer::SerializeNodes() {
+  for (const HeapEntry& entry : snapshot_->entries()) {
+    WriteVarint(entry.type());
+    WriteVarint(GetStringId(entry.name()));
+    WriteVarint(entry.id());
+    WriteVarint(entry.self_size());
+    WriteVarint(entry.children_count());
+    WriteVarint(entry.trace_node_id());
+    if (writer_->aborted()) return;
+  }
+}
+
+void HeapSnapshotBinarySerializer::SerializeEdges() {
+  for (HeapGraphEdge* edge : snapshot_->children()) {
+    WriteVarint(edge->type());
+    if (edge->type() == HeapGraphEdge::kElement ||
+        edge->type() == HeapGraphEdge::kHidden) {
+      WriteVarint(edge->index());
+    } else {
+      WriteVarint(GetStringId(edge->name()));
+    }
+    WriteVarint(edge->to()->index());
+    if (writer_->aborted()) return;
+  }
+}
+
+void HeapSnapshotBinarySerializer::SerializeTraceNodeInfos() {
+  AllocationTracker* tracker = snapshot_->profiler()->allocation_tracker();
+  if (!tracker) return;
+  for (AllocationTracker::FunctionInfo* info : tracker->function_info_list()) {
+    WriteVarint(info->function_id);
+    WriteVarint(GetStringId(info->name));
+    WriteVarint(GetStringId(info->script_name));
+    // The cast is safe because script id is a non-negative Smi.
+    WriteVarint(static_cast<unsigned>(info->script_id));
+    // 0-based positions are converted to 1-based ones, 0 means unknown.
+    WriteVarint(info->line == -1 ? 0 : info->line + 1);
+    WriteVarint(info->column == -1 ? 0 : info->column + 1);
+  }
+}
+
+void HeapSnapshotBinarySerializer::SerializeTraceTree() {
+  AllocationTracker* tracker = snapshot_->profiler()->allocation_tracker();
+  WriteVarint(tracker ? 1 : 0);
+  if (!tracker) return;
+  SerializeTraceNode(tracker->trace_tree()->root());
+}
+
+void HeapSnapshotBinarySerializer::SerializeTraceNode(
+    AllocationTraceNode* node) {
+  WriteVarint(node->id());
+  WriteVarint(node->function_info_index());
+  WriteVarint(node->allocation_count());
+  WriteVarint(node->allocation_size());
+  WriteVarint(node->children().size());
+  for (AllocationTraceNode* child : node->children()) {
+    SerializeTraceNode(child);
+  }
+}
+
+void HeapSnapshotBinarySerializer::SerializeSamples() {
+  const std::vector<HeapObjectsMap::TimeInterval>& samples =
+      snapshot_->profiler()->heap_object_map()->samples();
+  WriteVarint(samples.size());
+  if (samples.empty()) return;
+  base::TimeTicks start_time = samples[0].timestamp;
+  for (const HeapObjectsMap::TimeInterval& sample : samples) {
+    base::TimeDelta time_delta = sample.timestamp - start_time;
+    WriteVarint(time_delta.InMicroseconds());
+    WriteVarint(sample.last_assigned_id());
+  }
+}
+
+void HeapSnapshotBinarySerializer::SerializeLocations() {
+  const std::vector<SourceLocation>& locations = snapshot_->locations();
+  WriteVarint(locations.size());
+  for (const SourceLocation& location : locations) {
+    WriteVarint(location.entry_index);
+    WriteVarint(static_cast<unsigned>(location.scriptId));
+    WriteVarint(static_cast<unsigned>(location.line));
+    WriteVarint(static_cast<unsigned>(location.col));
+  }
+}
+
+void HeapSnapshotBinarySerializer::SerializeStrings() {
+  ScopedVector<const char*> sorted_strings(strings_.occupancy() + 1);
+  for (base::HashMap::Entry* entry = strings_.Start(); entry != nullptr;
+       entry = strings_.Next(entry)) {
+    int index = static_cast<int>(reinterpret_cast<uintptr_t>(entry->value));
+    sorted_strings[index] = reinterpret_cast<const char*>(entry->key);
+  }
+  // Id 0 is reserved, the table starts with the string with id 1.
+  WriteVarint(sorted_strings.length() - 1);
+  for (int i = 1; i < sorted_strings.length(); ++i) {
+    size_t length = strlen(sorted_strings[i]);
+    DCHECK_GE(kMaxInt, length);
+    WriteVarint(length);
+    writer_->AddBytes(sorted_strings[i], static_cast<int>(length));
+    if (writer_->aborted()) return;
+  }
+}
+
 }  // namespace internal
 }  // namespace v8
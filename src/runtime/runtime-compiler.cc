@@ -175,9 +175,12 @@ RUNTIME_FUNCTION(Runtime_NotifyDeoptimized) {
   JavaScriptFrame* top_frame = top_it.frame();
   isolate->set_context(Context::cast(top_frame->context()));
 
-  // Invalidate the underlying optimized code on non-lazy deopts.
+  // Invalidate the underlying optimized code on non-lazy deopts. The
+  // function no longer counts as optimized for tier-up hints either, so the
+  // regular heuristics decide when to optimize it again.
   if (type != DeoptimizeKind::kLazy) {
     Deoptimizer::DeoptimizeFunction(*function, *optimized_code);
+    function->shared().GetBytecodeArray().set_was_optimized(false);
   }
 
   return ReadOnlyRoots(isolate).undefined_value();
@@ -333,6 +333,22 @@ RUNTIME_FUNCTION(Runtime_BytecodeBudgetInterrupt) {
   }
 }
 
+RUNTIME_FUNCTION(Runtime_BytecodeBudgetInterruptFromCode) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(1, args.length());
+  CONVERT_ARG_HANDLE_CHECKED(FeedbackCell, feedback_cell, 0);
+  // Only mid-tier optimized code updates the budget, and optimized code always
+  // has a feedback vector.
+  DCHECK(feedback_cell->value().IsFeedbackVector());
+  feedback_cell->set_interrupt_budget(FLAG_interrupt_budget);
+  {
+    SealHandleScope shs(isolate);
+    isolate->counters()->runtime_profiler_ticks()->Increment();
+    isolate->runtime_profiler()->MarkCandidatesForOptimization();
+    return ReadOnlyRoots(isolate).undefined_value();
+  }
+}
+
 RUNTIME_FUNCTION(Runtime_AllocateInYoungGeneration) {
   HandleScope scope(isolate);
   DCHECK_EQ(2, args.length());
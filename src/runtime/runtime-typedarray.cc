@@ -74,6 +74,90 @@ bool CompareNum(T x, T y) {
   return false;
 }
 
+// Below this length std::sort is faster than the extra passes and the
+// temporary buffer of a radix sort.
+constexpr size_t kRadixSortMinLength = 256;
+
+// The radix sort needs a temporary buffer as large as the array. Above this
+// size the array is sorted in place by std::sort instead, so that sorting a
+// huge typed array does not double its memory footprint.
+constexpr size_t kRadixSortMaxBufferSize = 4 * MB;
+
+// Maps integers to unsigned keys that sort in the same order.
+template <typename T>
+typename std::make_unsigned<T>::type SortKey(T value) {
+  using U = typename std::make_unsigned<T>::type;
+  constexpr U kSignBias =
+      std::is_signed<T>::value ? U{1} << (sizeof(T) * kBitsPerByte - 1) : 0;
+  return static_cast<U>(static_cast<U>(value) ^ kSignBias);
+}
+
+// Sorts 8-bit elements by counting the occurrences of each value.
+template <typename T>
+void CountingSort(T* data, size_t length) {
+  size_t counts[256] = {0};
+  for (size_t i = 0; i < length; i++) counts[SortKey(data[i])]++;
+  T* out = data;
+  for (int key = 0; key < 256; key++) {
+    // Undo the sign bias of SortKey, which is its own inverse.
+    T value = static_cast<T>(SortKey(static_cast<T>(key)));
+    out = std::fill_n(out, counts[key], value);
+  }
+}
+
+// Least significant digit radix sort with 8-bit digits for 16- and 32-bit
+// elements. Every pass is stable, so the result is sorted by all digits.
+template <typename T>
+void RadixSort(T* data, size_t length) {
+  std::vector<T> buffer(length);
+  T* from = data;
+  T* to = buffer.data();
+  for (size_t shift = 0; shift < sizeof(T) * kBitsPerByte; shift += 8) {
+    size_t offsets[257] = {0};
+    for (size_t i = 0; i < length; i++) {
+      offsets[((SortKey(from[i]) >> shift) & 0xFF) + 1]++;
+    }
+    for (int digit = 0; digit < 256; digit++) {
+      offsets[digit + 1] += offsets[digit];
+    }
+    for (size_t i = 0; i < length; i++) {
+      to[offsets[(SortKey(from[i]) >> shift) & 0xFF]++] = from[i];
+    }
+    std::swap(from, to);
+  }
+  // An even number of passes leaves the result in {data}.
+  DCHECK_EQ(data, from);
+}
+
+// Sorts integer elements of up to 32 bits without comparing them. Returns
+// false for all other element types and for lengths outside the radix sort
+// range, which have to be sorted by std::sort.
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && sizeof(T) == 1,
+                        bool>::type
+TrySortWithoutComparisons(T* data, size_t length) {
+  CountingSort(data, length);
+  return true;
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && sizeof(T) != 1 &&
+                            sizeof(T) <= 4,
+                        bool>::type
+TrySortWithoutComparisons(T* data, size_t length) {
+  if (length < kRadixSortMinLength) return false;
+  if (length > kRadixSortMaxBufferSize / sizeof(T)) return false;
+  RadixSort(data, length);
+  return true;
+}
+
+template <typename T>
+typename std::enable_if<!std::is_integral<T>::value || (sizeof(T) > 4),
+                        bool>::type
+TrySortWithoutComparisons(T* data, size_t length) {
+  return false;
+}
+
 }  // namespace
 
 RUNTIME_FUNCTION(Runtime_TypedArraySortFast) {
@@ -127,7 +211,7 @@ RUNTIME_FUNCTION(Runtime_TypedArraySortFast) {
       } else {                                                             \
         std::sort(data, data + length, CompareNum<ctype>);                 \
       }                                                                    \
-    } else {                                                               \
+    } else if (!TrySortWithoutComparisons(data, length)) {                 \
       if (COMPRESS_POINTERS_BOOL && alignof(ctype) > kTaggedSize) {        \
         /* TODO(ishell, v8:8875): See UnalignedSlot<T> for details. */     \
         std::sort(UnalignedSlot<ctype>(data),                              \
@@ -318,6 +318,23 @@ RUNTIME_FUNCTION(Runtime_WasmStackGuard) {
   return isolate->stack_guard()->HandleInterrupts();
 }
 
+RUNTIME_FUNCTION(Runtime_WasmTriggerTierUp) {
+  SealHandleScope shs(isolate);
+  DCHECK_EQ(0, args.length());
+
+  ClearThreadInWasmScope wasm_flag;
+
+  // The Liftoff code that used up its tiering budget is the caller.
+  StackFrameIterator it(isolate, isolate->thread_local_top());
+  DCHECK_EQ(StackFrame::EXIT, it.frame()->type());
+  it.Advance();
+  WasmCompiledFrame* frame = WasmCompiledFrame::cast(it.frame());
+  wasm::TriggerTierUp(isolate, frame->wasm_code()->native_module(),
+                      frame->function_index());
+
+  return ReadOnlyRoots(isolate).undefined_value();
+}
+
 RUNTIME_FUNCTION(Runtime_WasmCompileLazy) {
   HandleScope scope(isolate);
   DCHECK_EQ(2, args.length());
@@ -219,6 +219,7 @@ namespace internal {
   F(GetTemplateObject, 3, 1)                         \
   F(IncrementUseCounter, 1, 1)                       \
   F(BytecodeBudgetInterrupt, 1, 1)                   \
+  F(BytecodeBudgetInterruptFromCode, 1, 1)           \
   F(NewReferenceError, 2, 1)                         \
   F(NewSyntaxError, 2, 1)                            \
   F(NewTypeError, 2, 1)                              \
@@ -559,6 +560,7 @@ namespace internal {
   F(WasmStackGuard, 0, 1)               \
   F(WasmThrowCreate, 2, 1)              \
   F(WasmThrowTypeError, 0, 1)           \
+  F(WasmTriggerTierUp, 0, 1)            \
   F(WasmRefFunc, 1, 1)                  \
   F(WasmFunctionTableGet, 3, 1)         \
   F(WasmFunctionTableSet, 4, 1)         \
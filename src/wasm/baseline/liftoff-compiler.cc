@@ -4,6 +4,8 @@
 
 #include "src/wasm/baseline/liftoff-compiler.h"
 
+#include <algorithm>
+
 #include "src/base/optional.h"
 #include "src/codegen/assembler-inl.h"
 // TODO(clemensb): Remove dependences on compiler stuff.
@@ -241,15 +243,20 @@ class LiftoffCompiler {
     static OutOfLineCode StackCheck(WasmCodePosition pos, LiftoffRegList regs) {
       return {{}, {}, WasmCode::kWasmStackGuard, pos, regs, 0};
     }
+    static OutOfLineCode TierUpCheck(WasmCodePosition pos,
+                                     LiftoffRegList regs) {
+      return {{}, {}, WasmCode::kWasmTriggerTierUp, pos, regs, 0};
+    }
   };
 
   LiftoffCompiler(compiler::CallDescriptor* call_descriptor,
                   CompilationEnv* env, Zone* compilation_zone,
-                  std::unique_ptr<AssemblerBuffer> buffer)
+                  std::unique_ptr<AssemblerBuffer> buffer, int func_index)
       : asm_(std::move(buffer)),
         descriptor_(
             GetLoweredCallDescriptor(compilation_zone, call_descriptor)),
         env_(env),
+        func_index_(func_index),
         compilation_zone_(compilation_zone),
         safepoint_table_builder_(compilation_zone_) {}
 
@@ -420,6 +427,27 @@ class LiftoffCompiler {
     __ bind(ool.continuation.get());
   }
 
+  // Decrements the tiering budget of this function, and calls the runtime to
+  // request top tier compilation once it drops below zero.
+  void TierUpCheck(WasmCodePosition position) {
+    if (!env_->dynamic_tiering || !env_->runtime_exception_support) return;
+    out_of_line_code_.push_back(
+        OutOfLineCode::TierUpCheck(position, __ cache_state()->used_registers));
+    OutOfLineCode& ool = out_of_line_code_.back();
+    LiftoffRegList pinned;
+    Register budget_array = pinned.set(__ GetUnusedRegister(kGpReg)).gp();
+    LiftoffRegister budget = pinned.set(__ GetUnusedRegister(kGpReg, pinned));
+    LOAD_INSTANCE_FIELD(budget_array, TieringBudgetArray, kSystemPointerSize);
+    uint32_t offset =
+        (func_index_ - env_->module->num_imported_functions) * kUInt32Size;
+    __ Load(budget, budget_array, no_reg, offset, LoadType::kI32Load, pinned);
+    __ emit_i32_add(budget.gp(), budget.gp(), -1);
+    __ Store(budget_array, no_reg, offset, budget, StoreType::kI32Store,
+             pinned);
+    __ emit_cond_jump(kSignedLessThan, ool.label.get(), kWasmI32, budget.gp());
+    __ bind(ool.continuation.get());
+  }
+
   bool SpillLocalsInitially(FullDecoder* decoder, uint32_t num_params) {
     int actual_locals = __ num_locals() - num_params;
     DCHECK_LE(0, actual_locals);
@@ -498,13 +526,16 @@ class LiftoffCompiler {
     // The function-prologue stack check is associated with position 0, which
     // is never a position of any instruction in the function.
     StackCheck(0);
+    TierUpCheck(0);
 
     DCHECK_EQ(__ num_locals(), __ cache_state()->stack_height());
   }
 
   void GenerateOutOfLineCode(OutOfLineCode* ool) {
     __ bind(ool->label.get());
-    const bool is_stack_check = ool->stub == WasmCode::kWasmStackGuard;
+    // Stack checks and tier up checks return to the function.
+    const bool is_stack_check = ool->stub == WasmCode::kWasmStackGuard ||
+                                ool->stub == WasmCode::kWasmTriggerTierUp;
     const bool is_mem_out_of_bounds =
         ool->stub == WasmCode::kThrowWasmTrapMemOutOfBounds;
 
@@ -585,12 +616,15 @@ class LiftoffCompiler {
 
     // Loop labels bind at the beginning of the block.
     __ bind(loop->label.get());
+    // Locals can be changed on the back edge.
+    bounds_checked_locals_.clear();
 
     // Save the current cache state for the merge when jumping to this loop.
     loop->label_state.Split(*__ cache_state());
 
     // Execute a stack check in the loop header.
     StackCheck(decoder->position());
+    TierUpCheck(decoder->position());
   }
 
   void Try(FullDecoder* decoder, Control* block) {
@@ -619,9 +653,11 @@ class LiftoffCompiler {
 
     // Store the state (after popping the value) for executing the else branch.
     if_block->else_state->state.Split(*__ cache_state());
+    bounds_checked_locals_.clear();
   }
 
   void FallThruTo(FullDecoder* decoder, Control* c) {
+    bounds_checked_locals_.clear();
     if (c->end_merge.reached) {
       __ MergeFullStackWith(c->label_state, *__ cache_state());
     } else {
@@ -665,6 +701,7 @@ class LiftoffCompiler {
 
   void PopControl(FullDecoder* decoder, Control* c) {
     if (c->is_loop()) return;  // A loop just falls through.
+    bounds_checked_locals_.clear();
     if (c->is_onearmed_if()) {
       // Special handling for one-armed ifs.
       FinishOneArmedIf(decoder, c);
@@ -1388,6 +1425,7 @@ class LiftoffCompiler {
         break;
     }
     if (!is_tee) __ cache_state()->stack_state.pop_back();
+    ForgetBoundsChecks(local_index);
   }
 
   void LocalSet(FullDecoder* decoder, const Value& value,
@@ -1610,6 +1648,7 @@ class LiftoffCompiler {
     }
     __ bind(c->else_state->label.get());
     __ cache_state()->Steal(c->else_state->state);
+    bounds_checked_locals_.clear();
   }
 
   Label* AddOutOfLineTrap(WasmCodePosition position,
@@ -1657,6 +1696,12 @@ class LiftoffCompiler {
 
     uint64_t end_offset = uint64_t{offset} + access_size - 1u;
 
+    if (FLAG_wasm_bounds_check_elimination &&
+        HasDominatingBoundsCheck(index, end_offset)) {
+      __ emit_i32_to_intptr(index, index);
+      return false;
+    }
+
     // If the end offset is larger than the smallest memory, dynamically check
     // the end offset against the actual memory size, which is not known at
     // compile time. Otherwise, only one check is required (see below).
@@ -1687,9 +1732,50 @@ class LiftoffCompiler {
     __ emit_cond_jump(kUnsignedGreaterEqual, trap_label,
                       LiftoffAssembler::kWasmIntPtr, index,
                       effective_size_reg.gp());
+    if (FLAG_wasm_bounds_check_elimination) {
+      RecordBoundsCheck(index, end_offset);
+    }
     return false;
   }
 
+  // Whether {index + end_offset} is known to be in bounds because {index} is
+  // the current value of a local that was checked with at least that end
+  // offset. A local and {index} hold the same value if the local still lives
+  // in the register of {index}. Memory never shrinks, so the check stays valid
+  // across calls and memory.grow.
+  bool HasDominatingBoundsCheck(Register index, uint64_t end_offset) {
+    for (const BoundsCheckedLocal& checked : bounds_checked_locals_) {
+      const auto& slot = __ cache_state()->stack_state[checked.local_index];
+      if (slot.is_reg() && slot.reg() == LiftoffRegister(index) &&
+          checked.end_offset >= end_offset) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void RecordBoundsCheck(Register index, uint64_t end_offset) {
+    // Only a register that is still used (by a local) can be matched later.
+    if (!__ cache_state()->is_used(LiftoffRegister(index))) return;
+    for (uint32_t local_index = 0; local_index < __ num_locals();
+         ++local_index) {
+      const auto& slot = __ cache_state()->stack_state[local_index];
+      if (!slot.is_reg() || slot.reg() != LiftoffRegister(index)) continue;
+      ForgetBoundsChecks(local_index);
+      bounds_checked_locals_.push_back({local_index, end_offset});
+    }
+  }
+
+  void ForgetBoundsChecks(uint32_t local_index) {
+    bounds_checked_locals_.erase(
+        std::remove_if(bounds_checked_locals_.begin(),
+                       bounds_checked_locals_.end(),
+                       [local_index](const BoundsCheckedLocal& checked) {
+                         return checked.local_index == local_index;
+                       }),
+        bounds_checked_locals_.end());
+  }
+
   void TraceMemoryOperation(bool is_store, MachineRepresentation rep,
                             Register index, uint32_t offset,
                             WasmCodePosition position) {
@@ -2169,6 +2255,7 @@ class LiftoffCompiler {
 
   compiler::CallDescriptor* const descriptor_;
   CompilationEnv* const env_;
+  const int func_index_;
   // TODO(clemensb): Provide a DebugSideTableBuilder here.
   DebugSideTableBuilder* const debug_sidetable_builder_ = nullptr;
   LiftoffBailoutReason bailout_reason_ = kSuccess;
@@ -2183,6 +2270,14 @@ class LiftoffCompiler {
   // The pc offset of the instructions to reserve the stack frame. Needed to
   // patch the actually needed stack size in the end.
   uint32_t pc_offset_stack_frame_construction_ = 0;
+  // Explicit memory bounds checks on the current straight-line path, see
+  // {HasDominatingBoundsCheck}. Cleared at every merge and loop header, and
+  // per local when it is written.
+  struct BoundsCheckedLocal {
+    uint32_t local_index;
+    uint64_t end_offset;
+  };
+  std::vector<BoundsCheckedLocal> bounds_checked_locals_;
 
   bool has_outstanding_op() const {
     return outstanding_op_ != kNoOutstandingOp;
@@ -2234,7 +2329,8 @@ WasmCompilationResult ExecuteLiftoffCompilation(AccountingAllocator* allocator,
       wasm::WasmInstructionBuffer::New(128 + code_size_estimate * 4 / 3);
   WasmFullDecoder<Decoder::kValidate, LiftoffCompiler> decoder(
       &zone, module, env->enabled_features, detected, func_body,
-      call_descriptor, env, &zone, instruction_buffer->CreateView());
+      call_descriptor, env, &zone, instruction_buffer->CreateView(),
+      func_index);
   decoder.Decode();
   liftoff_compile_time_scope.reset();
   LiftoffCompiler* compiler = &decoder.interface();
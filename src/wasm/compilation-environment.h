@@ -32,6 +32,11 @@ enum UseTrapHandler : bool { kUseTrapHandler = true, kNoTrapHandler = false };
 
 enum LowerSimd : bool { kLowerSimd = true, kNoLowerSimd = false };
 
+enum DynamicTiering : bool {
+  kDynamicTiering = true,
+  kNoDynamicTiering = false
+};
+
 // The {CompilationEnv} encapsulates the module data that is used during
 // compilation. CompilationEnvs are shareable across multiple compilations.
 struct CompilationEnv {
@@ -60,11 +65,16 @@ struct CompilationEnv {
 
   const LowerSimd lower_simd;
 
+  // If set, baseline code counts down a per-function tiering budget and
+  // requests top tier compilation once it is used up.
+  const DynamicTiering dynamic_tiering;
+
   constexpr CompilationEnv(const WasmModule* module,
                            UseTrapHandler use_trap_handler,
                            RuntimeExceptionSupport runtime_exception_support,
                            const WasmFeatures& enabled_features,
-                           LowerSimd lower_simd = kNoLowerSimd)
+                           LowerSimd lower_simd = kNoLowerSimd,
+                           DynamicTiering dynamic_tiering = kNoDynamicTiering)
       : module(module),
         use_trap_handler(use_trap_handler),
         runtime_exception_support(runtime_exception_support),
@@ -75,7 +85,8 @@ struct CompilationEnv {
                              : kV8MaxWasmMemoryPages) *
                         uint64_t{kWasmPageSize}),
         enabled_features(enabled_features),
-        lower_simd(lower_simd) {}
+        lower_simd(lower_simd),
+        dynamic_tiering(dynamic_tiering) {}
 };
 
 // The wire bytes are either owned by the StreamingDecoder, or (after streaming)
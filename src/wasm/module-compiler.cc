@@ -9,6 +9,7 @@
 
 #include "src/api/api.h"
 #include "src/asmjs/asm-js.h"
+#include "src/base/atomicops.h"
 #include "src/base/enum-set.h"
 #include "src/base/optional.h"
 #include "src/base/platform/mutex.h"
@@ -705,6 +706,15 @@ ExecutionTierPair GetRequestedExecutionTiers(
   UNREACHABLE();
 }
 
+// With dynamic tiering, top tier compilation of a function that starts out in
+// Liftoff is only requested once the function becomes hot (see
+// {TriggerTierUp}).
+bool DelaysTopTier(NativeModule* native_module, ExecutionTierPair tiers) {
+  return native_module->dynamic_tiering() &&
+         tiers.baseline_tier == ExecutionTier::kLiftoff &&
+         tiers.baseline_tier < tiers.top_tier;
+}
+
 // The {CompilationUnitBuilder} builds compilation units and stores them in an
 // internal buffer. The buffer is moved into the working queue of the
 // {CompilationStateImpl} when {Commit} is called.
@@ -724,7 +734,8 @@ class CompilationUnitBuilder {
         native_module_->module(), compilation_state()->compile_mode(),
         native_module_->enabled_features(), func_index);
     baseline_units_.emplace_back(func_index, tiers.baseline_tier);
-    if (tiers.baseline_tier != tiers.top_tier) {
+    if (tiers.baseline_tier != tiers.top_tier &&
+        !DelaysTopTier(native_module_, tiers)) {
       tiering_units_.emplace_back(func_index, tiers.top_tier);
     }
   }
@@ -822,34 +833,141 @@ enum OnlyLazyFunctions : bool {
   kOnlyLazyFunctions = true,
 };
 
-void ValidateSequentially(
-    const WasmModule* module, NativeModule* native_module, Counters* counters,
-    AccountingAllocator* allocator, ErrorThrower* thrower, bool lazy_module,
-    OnlyLazyFunctions only_lazy_functions = kAllFunctions) {
-  DCHECK(!thrower->error());
-  uint32_t start = module->num_imported_functions;
-  uint32_t end = start + module->num_declared_functions;
-  auto enabled_features = native_module->enabled_features();
-  for (uint32_t func_index = start; func_index < end; func_index++) {
-    // Skip non-lazy functions if requested.
-    if (only_lazy_functions) {
-      CompileStrategy strategy =
-          GetCompileStrategy(module, enabled_features, func_index, lazy_module);
-      if (strategy != CompileStrategy::kLazy &&
-          strategy != CompileStrategy::kLazyBaselineEagerTopTier) {
-        continue;
+// Validates function bodies on the main thread and on background tasks, see
+// {ValidateFunctions}. Functions are handed out in order of their index, and
+// only the error of the failing function with the lowest index is kept, so
+// that the reported error does not depend on scheduling.
+class FunctionValidator {
+ public:
+  FunctionValidator(const WasmModule* module, const ModuleWireBytes& wire_bytes,
+                    const WasmFeatures& enabled_features, Counters* counters,
+                    AccountingAllocator* allocator, bool lazy_module,
+                    OnlyLazyFunctions only_lazy_functions)
+      : module_(module),
+        wire_bytes_(wire_bytes),
+        enabled_features_(enabled_features),
+        counters_(counters),
+        allocator_(allocator),
+        lazy_module_(lazy_module),
+        only_lazy_functions_(only_lazy_functions),
+        end_(module->num_imported_functions + module->num_declared_functions),
+        next_function_(module->num_imported_functions),
+        first_error_function_(end_) {}
+
+  // Validates functions until none are left, or only functions after an
+  // already failed one.
+  void Run() {
+    while (true) {
+      uint32_t func_index =
+          next_function_.fetch_add(1, std::memory_order_relaxed);
+      if (func_index >= first_error_function_.load(std::memory_order_relaxed)) {
+        return;
       }
+      // Skip non-lazy functions if requested.
+      if (only_lazy_functions_) {
+        CompileStrategy strategy = GetCompileStrategy(
+            module_, enabled_features_, func_index, lazy_module_);
+        if (strategy != CompileStrategy::kLazy &&
+            strategy != CompileStrategy::kLazyBaselineEagerTopTier) {
+          continue;
+        }
+      }
+
+      const WasmFunction* func = &module_->functions[func_index];
+      Vector<const uint8_t> code = wire_bytes_.GetFunctionBytes(func);
+      DecodeResult result =
+          ValidateSingleFunction(module_, func_index, code, counters_,
+                                 allocator_, enabled_features_);
+      if (result.failed()) SetError(func_index, result.error());
     }
+  }
 
-    ModuleWireBytes wire_bytes{native_module->wire_bytes()};
-    const WasmFunction* func = &module->functions[func_index];
-    Vector<const uint8_t> code = wire_bytes.GetFunctionBytes(func);
-    DecodeResult result = ValidateSingleFunction(
-        module, func_index, code, counters, allocator, enabled_features);
-    if (result.failed()) {
-      SetCompileError(thrower, wire_bytes, func, module, result.error());
+  bool failed() const {
+    return first_error_function_.load(std::memory_order_relaxed) != end_;
+  }
+
+  // The error of the first invalid function, as reported by its decoder.
+  const WasmError& error() const {
+    DCHECK(failed());
+    return error_;
+  }
+
+  void ReportError(ErrorThrower* thrower) {
+    uint32_t func_index = first_error_function_.load(std::memory_order_relaxed);
+    if (func_index == end_) return;
+    SetCompileError(thrower, wire_bytes_, &module_->functions[func_index],
+                    module_, error_);
+  }
+
+ private:
+  void SetError(uint32_t func_index, const WasmError& error) {
+    base::MutexGuard guard(&mutex_);
+    if (func_index >= first_error_function_.load(std::memory_order_relaxed)) {
+      return;
     }
+    error_ = error;
+    first_error_function_.store(func_index, std::memory_order_relaxed);
+  }
+
+  const WasmModule* const module_;
+  const ModuleWireBytes wire_bytes_;
+  const WasmFeatures enabled_features_;
+  Counters* const counters_;
+  AccountingAllocator* const allocator_;
+  const bool lazy_module_;
+  const OnlyLazyFunctions only_lazy_functions_;
+  const uint32_t end_;
+  std::atomic<uint32_t> next_function_;
+  // Only written while holding {mutex_}, which also protects {error_}.
+  std::atomic<uint32_t> first_error_function_;
+  base::Mutex mutex_;
+  WasmError error_;
+
+  DISALLOW_COPY_AND_ASSIGN(FunctionValidator);
+};
+
+class ValidateFunctionsTask final : public CancelableTask {
+ public:
+  ValidateFunctionsTask(CancelableTaskManager* task_manager,
+                        FunctionValidator* validator)
+      : CancelableTask(task_manager), validator_(validator) {}
+
+  void RunInternal() override { validator_->Run(); }
+
+ private:
+  FunctionValidator* const validator_;
+};
+
+// Runs {validator} on the calling thread and on background tasks, the same way
+// as compilation units are fanned out to background tasks. Can be called on
+// the main thread and on a background thread.
+void RunFunctionValidator(FunctionValidator* validator) {
+  CancelableTaskManager task_manager;
+  const int max_background_tasks = GetMaxBackgroundTasks();
+  for (int i = 0; i < max_background_tasks; ++i) {
+    auto task =
+        std::make_unique<ValidateFunctionsTask>(&task_manager, validator);
+    V8::GetCurrentPlatform()->CallOnWorkerThread(std::move(task));
   }
+
+  // Work in the calling thread too.
+  validator->Run();
+  task_manager.CancelAndWait();
+}
+
+// Validates the function bodies of {module} in parallel. Sets an error on
+// {thrower} for the first invalid function.
+void ValidateFunctions(
+    const WasmModule* module, NativeModule* native_module, Counters* counters,
+    AccountingAllocator* allocator, ErrorThrower* thrower, bool lazy_module,
+    OnlyLazyFunctions only_lazy_functions = kAllFunctions) {
+  DCHECK(!thrower->error());
+  FunctionValidator validator(
+      module, ModuleWireBytes(native_module->wire_bytes()),
+      native_module->enabled_features(), counters, allocator, lazy_module,
+      only_lazy_functions);
+  RunFunctionValidator(&validator);
+  validator.ReportError(thrower);
 }
 
 bool IsLazyModule(const WasmModule* module) {
@@ -872,6 +990,18 @@ bool CompileLazy(Isolate* isolate, NativeModule* native_module,
   base::ElapsedTimer compilation_timer;
   compilation_timer.Start();
 
+  // Functions of a lazily deserialized module are copied from the serialized
+  // data instead of being compiled.
+  {
+    WasmCodeRefScope code_ref_scope;
+    if (WasmCode* code = DeserializeLazyFunction(native_module, func_index)) {
+      TRACE_LAZY("Deserialized wasm-function#%d.\n", func_index);
+      if (WasmCode::ShouldBeLogged(isolate)) code->LogCode(isolate);
+      counters->wasm_lazily_deserialized_functions()->Increment();
+      return true;
+    }
+  }
+
   TRACE_LAZY("Compiling wasm-function#%d.\n", func_index);
 
   CompilationStateImpl* compilation_state =
@@ -922,7 +1052,8 @@ bool CompileLazy(Isolate* isolate, NativeModule* native_module,
   const bool lazy_module = IsLazyModule(module);
   if (GetCompileStrategy(module, enabled_features, func_index, lazy_module) ==
           CompileStrategy::kLazy &&
-      tiers.baseline_tier < tiers.top_tier) {
+      tiers.baseline_tier < tiers.top_tier &&
+      !DelaysTopTier(native_module, tiers)) {
     WasmCompilationUnit tiering_unit{func_index, tiers.top_tier};
     compilation_state->AddTopTierCompilationUnit(tiering_unit);
   }
@@ -930,6 +1061,36 @@ bool CompileLazy(Isolate* isolate, NativeModule* native_module,
   return true;
 }
 
+void TriggerTierUp(Isolate* isolate, NativeModule* native_module,
+                   int func_index) {
+  const WasmModule* module = native_module->module();
+  DCHECK(native_module->dynamic_tiering());
+  DCHECK_LE(native_module->num_imported_functions(), func_index);
+  DCHECK_LT(func_index, native_module->num_functions());
+
+  // The Liftoff code keeps running until the top tier code is published.
+  // Move the budget out of reach so that it does not request the same
+  // compilation again in the meantime. Liftoff code on other threads updates
+  // the same slot without synchronization, hence the atomic store.
+  uint32_t slot_index = func_index - module->num_imported_functions;
+  base::Relaxed_Store(reinterpret_cast<base::Atomic32*>(
+                          &native_module->tiering_budget_array()[slot_index]),
+                      kMaxInt);
+
+  CompilationStateImpl* compilation_state =
+      Impl(native_module->compilation_state());
+  ExecutionTierPair tiers = GetRequestedExecutionTiers(
+      module, compilation_state->compile_mode(),
+      native_module->enabled_features(), func_index);
+  if (!DelaysTopTier(native_module, tiers)) return;
+
+  TRACE_EVENT1(TRACE_DISABLED_BY_DEFAULT("v8.wasm"), "TriggerTierUp",
+               "func_index", func_index);
+  isolate->counters()->wasm_tier_up_requests()->Increment();
+  WasmCompilationUnit tiering_unit{func_index, tiers.top_tier};
+  compilation_state->AddTopTierCompilationUnit(tiering_unit);
+}
+
 namespace {
 
 void RecordStats(const Code code, Counters* counters) {
@@ -1184,7 +1345,9 @@ void InitializeCompilationUnits(Isolate* isolate, NativeModule* native_module) {
     if (strategy == CompileStrategy::kLazy) {
       native_module->UseLazyStub(func_index);
     } else if (strategy == CompileStrategy::kLazyBaselineEagerTopTier) {
-      builder.AddTopTierUnit(func_index);
+      // With dynamic tiering, the top tier is only compiled once the lazily
+      // compiled baseline code is hot, see {TriggerTierUp}.
+      if (!native_module->dynamic_tiering()) builder.AddTopTierUnit(func_index);
       native_module->UseLazyStub(func_index);
     } else {
       DCHECK_EQ(strategy, CompileStrategy::kEager);
@@ -1262,10 +1425,12 @@ void CompileNativeModule(Isolate* isolate, ErrorThrower* thrower,
                                lazy_module)) {
     // Validate wasm modules for lazy compilation if requested. Never validate
     // asm.js modules as these are valid by construction (additionally a CHECK
-    // will catch this during lazy compilation).
-    ValidateSequentially(wasm_module, native_module, isolate->counters(),
-                         isolate->allocator(), thrower, lazy_module,
-                         kOnlyLazyFunctions);
+    // will catch this during lazy compilation). This happens before any
+    // compilation unit is scheduled, so an invalid module leaves no background
+    // compilation behind.
+    ValidateFunctions(wasm_module, native_module, isolate->counters(),
+                      isolate->allocator(), thrower, lazy_module,
+                      kOnlyLazyFunctions);
     // On error: Return and leave the module in an unexecutable state.
     if (thrower->error()) return;
   }
@@ -1318,8 +1483,8 @@ void CompileNativeModule(Isolate* isolate, ErrorThrower* thrower,
 
   if (compilation_state->failed()) {
     DCHECK_IMPLIES(lazy_module, !FLAG_wasm_lazy_validation);
-    ValidateSequentially(wasm_module, native_module, isolate->counters(),
-                         isolate->allocator(), thrower, lazy_module);
+    ValidateFunctions(wasm_module, native_module, isolate->counters(),
+                      isolate->allocator(), thrower, lazy_module);
     CHECK(thrower->error());
   }
 }
@@ -1411,6 +1576,7 @@ AsyncCompileJob::AsyncCompileJob(
 }
 
 void AsyncCompileJob::Start() {
+  if (StartLookUpCachedModule()) return;
   DoAsync<DecodeModule>(isolate_->counters());  // --
 }
 
@@ -1525,6 +1691,29 @@ void AsyncCompileJob::PrepareRuntimeObjects() {
   module_object_ = isolate_->global_handles()->Create(*module_object);
 }
 
+bool AsyncCompileJob::StartLookUpCachedModule() {
+  // Only modules compiled with the isolate's features are written to the code
+  // cache directory, see {WasmEngine::MaybeGetCachedModule}.
+  const bool use_code_cache_dir =
+      FLAG_wasm_code_cache_dir != nullptr &&
+      enabled_features_ == WasmFeatures::FromIsolate(isolate_);
+  if (!FLAG_wasm_native_module_cache && !use_code_cache_dir) return false;
+  DoAsync<LookUpCachedModule>(isolate_->counters(), use_code_cache_dir);
+  return true;
+}
+
+// This function assumes that it is executed in a HandleScope, and that a
+// context is set on the isolate.
+void AsyncCompileJob::FinishStreamingCompile() {
+  DCHECK_NOT_NULL(stream_);
+  if (!DecrementAndCheckFinisherCount()) return;
+  if (native_module_->compilation_state()->failed()) {
+    AsyncCompileFailed();
+  } else {
+    FinishCompile();
+  }
+}
+
 // This function assumes that it is executed in a HandleScope, and that a
 // context is set on the isolate.
 void AsyncCompileJob::FinishCompile() {
@@ -1571,6 +1760,10 @@ void AsyncCompileJob::FinishCompile() {
   // We can only update the feature counts once the entire compile is done.
   compilation_state->PublishDetectedFeatures(isolate_);
 
+  // Later compilations of the same bytes, also in other isolates, can reuse
+  // this module.
+  isolate_->wasm_engine()->UpdateNativeModuleCache(native_module_);
+
   FinishModule();
 }
 
@@ -1587,9 +1780,9 @@ void AsyncCompileJob::AsyncCompileFailed() {
   ErrorThrower thrower(isolate_, api_method_name_);
   DCHECK_EQ(native_module_->module()->origin, kWasmOrigin);
   const bool lazy_module = wasm_lazy_compilation_;
-  ValidateSequentially(native_module_->module(), native_module_.get(),
-                       isolate_->counters(), isolate_->allocator(), &thrower,
-                       lazy_module);
+  ValidateFunctions(native_module_->module(), native_module_.get(),
+                    isolate_->counters(), isolate_->allocator(), &thrower,
+                    lazy_module);
   DCHECK(thrower.error());
   // {job} keeps the {this} pointer alive.
   std::shared_ptr<AsyncCompileJob> job =
@@ -1794,30 +1987,12 @@ class AsyncCompileJob::DecodeModule : public AsyncCompileJob::CompileStep {
         DCHECK_EQ(module->origin, kWasmOrigin);
         const bool lazy_module = job->wasm_lazy_compilation_;
         if (MayCompriseLazyFunctions(module, enabled_features, lazy_module)) {
-          auto allocator = job->isolate()->wasm_engine()->allocator();
-          int start = module->num_imported_functions;
-          int end = start + module->num_declared_functions;
-
-          for (int func_index = start; func_index < end; func_index++) {
-            const WasmFunction* func = &module->functions[func_index];
-            Vector<const uint8_t> code =
-                job->wire_bytes_.GetFunctionBytes(func);
-
-            CompileStrategy strategy = GetCompileStrategy(
-                module, enabled_features, func_index, lazy_module);
-            bool validate_lazily_compiled_function =
-                strategy == CompileStrategy::kLazy ||
-                strategy == CompileStrategy::kLazyBaselineEagerTopTier;
-            if (validate_lazily_compiled_function) {
-              DecodeResult function_result =
-                  ValidateSingleFunction(module, func_index, code, counters_,
-                                         allocator, enabled_features);
-              if (function_result.failed()) {
-                result = ModuleResult(function_result.error());
-                break;
-              }
-            }
-          }
+          FunctionValidator validator(
+              module, job->wire_bytes_, enabled_features, counters_,
+              job->isolate()->wasm_engine()->allocator(), lazy_module,
+              kOnlyLazyFunctions);
+          RunFunctionValidator(&validator);
+          if (validator.failed()) result = ModuleResult(validator.error());
         }
       }
     }
@@ -1857,6 +2032,174 @@ class AsyncCompileJob::DecodeFail : public CompileStep {
   }
 };
 
+//==========================================================================
+// Step 0 (async): Look up the module in the caches of the engine.
+//==========================================================================
+class AsyncCompileJob::LookUpCachedModule : public CompileStep {
+ public:
+  LookUpCachedModule(Counters* counters, bool use_code_cache_dir)
+      : counters_(counters), use_code_cache_dir_(use_code_cache_dir) {}
+
+  void RunInBackground(AsyncCompileJob* job) override {
+    TRACE_COMPILE("(0) Looking up cached module...\n");
+    TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.wasm"),
+                 "AsyncCompileJob::LookUpCachedModule");
+    WasmEngine* engine = job->isolate_->wasm_engine();
+    Vector<const uint8_t> wire_bytes = job->wire_bytes_.module_bytes();
+    if (std::shared_ptr<NativeModule> native_module =
+            engine->GetCachedNativeModule(job->enabled_features_,
+                                          wire_bytes)) {
+      const bool kDeserialized = false;
+      job->DoSync<UseCachedModule>(std::move(native_module), kDeserialized);
+      return;
+    }
+    if (use_code_cache_dir_) {
+      OwnedVector<uint8_t> serialized_module =
+          WasmEngine::ReadCodeCacheFile(wire_bytes);
+      if (!serialized_module.empty() &&
+          IsSupportedVersion(serialized_module.as_vector())) {
+        ModuleResult result = DecodeWasmModule(
+            job->enabled_features_, wire_bytes.begin(), wire_bytes.end(),
+            false, kWasmOrigin, counters_, engine->allocator());
+        if (result.ok()) {
+          job->DoSync<PrepareDeserialization>(std::move(result).value(),
+                                              std::move(serialized_module),
+                                              counters_);
+          return;
+        }
+      }
+    }
+    CompileModule(job, counters_);
+  }
+
+  // Continues with regular compilation of a module that was not found in the
+  // caches.
+  static void CompileModule(AsyncCompileJob* job, Counters* counters) {
+    if (job->stream_) {
+      // Streaming compilation already started while the bytes were received.
+      job->DoSync<FinishStreaming>();
+    } else {
+      // Decode right away, background tasks cannot spawn other tasks of the
+      // job (see {CompileTask}).
+      DecodeModule decode_module(counters);
+      decode_module.RunInBackground(job);
+    }
+  }
+
+ private:
+  Counters* const counters_;
+  const bool use_code_cache_dir_;
+};
+
+//==========================================================================
+// Step 0a (sync): Create the native module for deserialized code.
+//==========================================================================
+class AsyncCompileJob::PrepareDeserialization : public CompileStep {
+ public:
+  PrepareDeserialization(std::shared_ptr<const WasmModule> module,
+                         OwnedVector<uint8_t> serialized_module,
+                         Counters* counters)
+      : module_(std::move(module)),
+        serialized_module_(std::move(serialized_module)),
+        counters_(counters) {}
+
+ private:
+  std::shared_ptr<const WasmModule> module_;
+  OwnedVector<uint8_t> serialized_module_;
+  Counters* const counters_;
+
+  void RunInForeground(AsyncCompileJob* job) override {
+    TRACE_COMPILE("(0a) Prepare deserialization...\n");
+    const bool kIncludeLiftoff = false;
+    size_t code_size_estimate = WasmCodeManager::EstimateNativeModuleCodeSize(
+        module_.get(), kIncludeLiftoff);
+    std::shared_ptr<NativeModule> native_module =
+        job->isolate_->wasm_engine()->NewNativeModule(
+            job->isolate_, job->enabled_features_, std::move(module_),
+            code_size_estimate);
+    // The job keeps its own wire bytes, in case the module has to be compiled
+    // after all.
+    native_module->SetWireBytes(
+        OwnedVector<uint8_t>::Of(job->wire_bytes_.module_bytes()));
+    job->DoAsync<DeserializeModule>(std::move(native_module),
+                                    std::move(serialized_module_), counters_);
+  }
+};
+
+//==========================================================================
+// Step 0b (async): Deserialize the code from the code cache directory.
+//==========================================================================
+class AsyncCompileJob::DeserializeModule : public CompileStep {
+ public:
+  DeserializeModule(std::shared_ptr<NativeModule> native_module,
+                    OwnedVector<uint8_t> serialized_module, Counters* counters)
+      : native_module_(std::move(native_module)),
+        serialized_module_(std::move(serialized_module)),
+        counters_(counters) {}
+
+  void RunInBackground(AsyncCompileJob* job) override {
+    TRACE_COMPILE("(0b) Deserializing module...\n");
+    TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.wasm"),
+                 "AsyncCompileJob::DeserializeModule");
+    if (DeserializeNativeModuleCode(native_module_.get(),
+                                    serialized_module_.as_vector())) {
+      const bool kDeserialized = true;
+      job->DoSync<UseCachedModule>(std::move(native_module_), kDeserialized);
+      return;
+    }
+    LookUpCachedModule::CompileModule(job, counters_);
+  }
+
+ private:
+  std::shared_ptr<NativeModule> native_module_;
+  OwnedVector<uint8_t> serialized_module_;
+  Counters* const counters_;
+};
+
+//==========================================================================
+// Step 0c (sync): Finish with the module found in the caches.
+//==========================================================================
+class AsyncCompileJob::UseCachedModule : public CompileStep {
+ public:
+  UseCachedModule(std::shared_ptr<NativeModule> native_module,
+                  bool deserialized)
+      : native_module_(std::move(native_module)), deserialized_(deserialized) {}
+
+ private:
+  std::shared_ptr<NativeModule> native_module_;
+  const bool deserialized_;
+
+  void RunInForeground(AsyncCompileJob* job) override {
+    TRACE_COMPILE("(0c) Use cached module...\n");
+    if (job->native_module_) {
+      // Drop the compilation started during streaming. This also removes the
+      // compilation callbacks, such that they do not finish the job.
+      DCHECK_NOT_NULL(job->stream_);
+      Impl(job->native_module_->compilation_state())->AbortCompilation();
+    }
+    Isolate* isolate = job->isolate_;
+    Handle<WasmModuleObject> module_object =
+        isolate->wasm_engine()->ImportNativeModule(isolate, native_module_);
+    // Log the code within the deserialized module for profiling.
+    if (deserialized_) native_module_->LogWasmCodes(isolate);
+    job->module_object_ = isolate->global_handles()->Create(*module_object);
+    job->native_module_ = std::move(native_module_);
+    job->wire_bytes_ = ModuleWireBytes(job->native_module_->wire_bytes());
+    job->FinishCompile();
+  }
+};
+
+//==========================================================================
+// Step 0d (sync): Finish streaming compilation of a module not in the caches.
+//==========================================================================
+class AsyncCompileJob::FinishStreaming : public CompileStep {
+ private:
+  void RunInForeground(AsyncCompileJob* job) override {
+    TRACE_COMPILE("(0d) Finish streaming...\n");
+    job->FinishStreamingCompile();
+  }
+};
+
 //==========================================================================
 // Step 2 (sync): Create heap-allocated data and start compile.
 //==========================================================================
@@ -2130,7 +2473,9 @@ bool AsyncStreamingProcessor::ProcessFunctionBody(Vector<const uint8_t> bytes,
   if (strategy == CompileStrategy::kLazy) {
     native_module->UseLazyStub(func_index);
   } else if (strategy == CompileStrategy::kLazyBaselineEagerTopTier) {
-    compilation_unit_builder_->AddTopTierUnit(func_index);
+    if (!native_module->dynamic_tiering()) {
+      compilation_unit_builder_->AddTopTierUnit(func_index);
+    }
     native_module->UseLazyStub(func_index);
   } else {
     DCHECK_EQ(strategy, CompileStrategy::kEager);
@@ -2171,23 +2516,20 @@ void AsyncStreamingProcessor::OnFinishedStream(OwnedVector<uint8_t> bytes) {
   auto* histogram = job_->isolate_->counters()->wasm_wasm_module_size_bytes();
   histogram->AddSample(static_cast<int>(bytes.size()));
 
-  bool needs_finish = job_->DecrementAndCheckFinisherCount();
   if (job_->native_module_ == nullptr) {
     // We are processing a WebAssembly module without code section. Create the
     // runtime objects now (would otherwise happen in {PrepareAndStartCompile}).
     constexpr size_t kCodeSizeEstimate = 0;
     job_->CreateNativeModule(std::move(result).value(), kCodeSizeEstimate);
-    DCHECK(needs_finish);
   }
   job_->wire_bytes_ = ModuleWireBytes(bytes.as_vector());
   job_->native_module_->SetWireBytes(std::move(bytes));
-  if (needs_finish) {
-    if (job_->native_module_->compilation_state()->failed()) {
-      job_->AsyncCompileFailed();
-    } else {
-      job_->FinishCompile();
-    }
-  }
+
+  // The wire bytes are only complete now, so this is the first point at which
+  // the caches can be consulted. Compilation continues in the background
+  // meanwhile, and is only dropped if the module is found.
+  if (job_->StartLookUpCachedModule()) return;
+  job_->FinishStreamingCompile();
 }
 
 // Report an error detected in the StreamingDecoder.
@@ -2275,11 +2617,21 @@ void CompilationStateImpl::InitializeCompilationProgress(bool lazy_module,
     CompileStrategy strategy =
         GetCompileStrategy(module, enabled_features, func_index, lazy_module);
 
+    // With dynamic tiering, functions that are lazily compiled to the
+    // baseline tier only tier up once they are hot, even if the top tier was
+    // hinted to be compiled eagerly (see {InitializeCompilationUnits}).
     bool required_for_baseline = strategy == CompileStrategy::kEager;
-    bool required_for_top_tier = strategy != CompileStrategy::kLazy;
-    DCHECK_EQ(required_for_top_tier,
-              strategy == CompileStrategy::kEager ||
-                  strategy == CompileStrategy::kLazyBaselineEagerTopTier);
+    bool required_for_top_tier =
+        strategy == CompileStrategy::kEager ||
+        (strategy == CompileStrategy::kLazyBaselineEagerTopTier &&
+         !native_module_->dynamic_tiering());
+
+    // Top tier compilation is not scheduled upfront if it is delayed until the
+    // function is hot, so it cannot be waited for either.
+    if (strategy == CompileStrategy::kEager &&
+        DelaysTopTier(native_module_, requested_tiers)) {
+      requested_tiers.top_tier = requested_tiers.baseline_tier;
+    }
 
     // Count functions to complete baseline and top tier compilation.
     if (required_for_baseline) outstanding_baseline_units_++;
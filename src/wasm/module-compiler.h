@@ -66,6 +66,10 @@ V8_EXPORT_PRIVATE Handle<Script> CreateWasmScript(
 // also lazy.
 bool CompileLazy(Isolate*, NativeModule*, int func_index);
 
+// Triggered by the WasmTriggerTierUp builtin once Liftoff code of the given
+// function used up its tiering budget. Schedules top tier compilation.
+void TriggerTierUp(Isolate*, NativeModule*, int func_index);
+
 int GetMaxBackgroundTasks();
 
 template <typename Key, typename Hash>
@@ -127,6 +131,11 @@ class AsyncCompileJob {
   class CompilationStateCallback;
 
   // States of the AsyncCompileJob.
+  class LookUpCachedModule;      // Step 0  (async)
+  class PrepareDeserialization;  // Step 0a (sync)
+  class DeserializeModule;       // Step 0b (async)
+  class UseCachedModule;         // Step 0c (sync)
+  class FinishStreaming;         // Step 0d (sync)
   class DecodeModule;            // Step 1  (async)
   class DecodeFail;              // Step 1b (sync)
   class PrepareAndStartCompile;  // Step 2  (sync)
@@ -147,6 +156,13 @@ class AsyncCompileJob {
                           size_t code_size_estimate);
   void PrepareRuntimeObjects();
 
+  // Starts looking up {wire_bytes_} in the caches of the engine if they might
+  // hold the module. Returns false if they cannot.
+  bool StartLookUpCachedModule();
+  // Finishes streaming compilation once all bytes were received and the
+  // module was not found in the caches.
+  void FinishStreamingCompile();
+
   void FinishCompile();
 
   void DecodeFailed(const WasmError&);
@@ -4,6 +4,7 @@
 
 #include "src/wasm/wasm-code-manager.h"
 
+#include <algorithm>
 #include <iomanip>
 
 #include "src/base/iterator.h"
@@ -29,6 +30,7 @@
 #include "src/wasm/wasm-module.h"
 #include "src/wasm/wasm-objects-inl.h"
 #include "src/wasm/wasm-objects.h"
+#include "src/wasm/wasm-serialization.h"
 
 #if defined(V8_OS_WIN64)
 #include "src/diagnostics/unwinding-info-win64.h"
@@ -739,7 +741,11 @@ NativeModule::NativeModule(WasmEngine* engine, const WasmFeatures& enabled,
           new WasmImportWrapperCache())),
       engine_(engine),
       use_trap_handler_(trap_handler::IsTrapHandlerEnabled() ? kUseTrapHandler
-                                                             : kNoTrapHandler) {
+                                                             : kNoTrapHandler),
+      dynamic_tiering_(FLAG_wasm_dynamic_tiering && FLAG_wasm_tier_up &&
+                               module_->origin == kWasmOrigin
+                           ? kDynamicTiering
+                           : kNoDynamicTiering) {
   // We receive a pointer to an empty {std::shared_ptr}, and install ourselve
   // there.
   DCHECK_NOT_NULL(shared_this);
@@ -752,6 +758,9 @@ NativeModule::NativeModule(WasmEngine* engine, const WasmFeatures& enabled,
     code_table_ =
         std::make_unique<WasmCode*[]>(module_->num_declared_functions);
   }
+  if (dynamic_tiering_) {
+    InitializeTieringBudgets(module_->num_declared_functions);
+  }
   code_allocator_.Init(this);
 }
 
@@ -764,6 +773,7 @@ void NativeModule::ReserveCodeTableForTesting(uint32_t max_functions) {
            module_->num_declared_functions * sizeof(WasmCode*));
   }
   code_table_ = std::move(new_table);
+  if (dynamic_tiering_) InitializeTieringBudgets(max_functions);
 
   base::AddressRegion single_code_space_region;
   {
@@ -793,10 +803,17 @@ void NativeModule::LogWasmCodes(Isolate* isolate) {
 }
 
 CompilationEnv NativeModule::CreateCompilationEnv() const {
-  return {module(), use_trap_handler_, kRuntimeExceptionSupport,
-          enabled_features_};
+  return {module(),         use_trap_handler_, kRuntimeExceptionSupport,
+          enabled_features_, kNoLowerSimd,     dynamic_tiering_};
+}
+
+void NativeModule::InitializeTieringBudgets(uint32_t num_functions) {
+  tiering_budgets_ = std::make_unique<uint32_t[]>(num_functions);
+  std::fill_n(tiering_budgets_.get(), num_functions,
+              static_cast<uint32_t>(FLAG_wasm_tiering_budget));
 }
 
+
 WasmCode* NativeModule::AddCodeForTesting(Handle<Code> code) {
   // For off-heap builtins, we create a copy of the off-heap instruction stream
   // instead of the on-heap code object containing the trampoline. Ensure that
@@ -1081,7 +1098,7 @@ WasmCode* NativeModule::PublishCodeLocked(std::unique_ptr<WasmCode> code) {
   return result;
 }
 
-WasmCode* NativeModule::AddDeserializedCode(
+std::unique_ptr<WasmCode> NativeModule::AddDeserializedCode(
     uint32_t index, Vector<const byte> instructions, uint32_t stack_slots,
     uint32_t tagged_parameter_slots, size_t safepoint_table_offset,
     size_t handler_table_offset, size_t constant_pool_offset,
@@ -1104,7 +1121,7 @@ WasmCode* NativeModule::AddDeserializedCode(
   // Note: we do not flush the i-cache here, since the code needs to be
   // relocated anyway. The caller is responsible for flushing the i-cache later.
 
-  return PublishCode(std::move(code));
+  return code;
 }
 
 std::vector<WasmCode*> NativeModule::SnapshotCodeTable() const {
@@ -1327,6 +1344,12 @@ void NativeModule::SetWireBytes(OwnedVector<const uint8_t> wire_bytes) {
   }
 }
 
+void NativeModule::SetLazilyDeserializedCode(
+    std::unique_ptr<LazilyDeserializedCode> code) {
+  DCHECK_NULL(lazily_deserialized_code_);
+  lazily_deserialized_code_ = std::move(code);
+}
+
 WasmCode* NativeModule::Lookup(Address pc) const {
   base::MutexGuard lock(&allocation_mutex_);
   auto iter = owned_code_.upper_bound(pc);
@@ -35,6 +35,7 @@ class Isolate;
 
 namespace wasm {
 
+struct LazilyDeserializedCode;
 class NativeModule;
 class WasmCodeManager;
 struct WasmCompilationResult;
@@ -397,7 +398,9 @@ class V8_EXPORT_PRIVATE NativeModule final {
   // Hold the {allocation_mutex_} when calling {PublishCodeLocked}.
   WasmCode* PublishCodeLocked(std::unique_ptr<WasmCode>);
 
-  WasmCode* AddDeserializedCode(
+  // The returned code still needs to be relocated, and then published via
+  // {PublishCode}.
+  std::unique_ptr<WasmCode> AddDeserializedCode(
       uint32_t index, Vector<const byte> instructions, uint32_t stack_slots,
       uint32_t tagged_parameter_slots, size_t safepoint_table_offset,
       size_t handler_table_offset, size_t constant_pool_offset,
@@ -486,6 +489,16 @@ class V8_EXPORT_PRIVATE NativeModule final {
     return module_->num_imported_functions;
   }
   UseTrapHandler use_trap_handler() const { return use_trap_handler_; }
+  DynamicTiering dynamic_tiering() const { return dynamic_tiering_; }
+  // Remaining budget per declared function before Liftoff code requests tier
+  // up, or nullptr if {dynamic_tiering()} is off. Shared by all instances.
+  uint32_t* tiering_budget_array() const { return tiering_budgets_.get(); }
+  // Serialized code of functions that were not materialized yet, or nullptr
+  // if the module was not deserialized with {--wasm-lazy-deserialization}.
+  LazilyDeserializedCode* lazily_deserialized_code() const {
+    return lazily_deserialized_code_.get();
+  }
+  void SetLazilyDeserializedCode(std::unique_ptr<LazilyDeserializedCode>);
   void set_lazy_compile_frozen(bool frozen) { lazy_compile_frozen_ = frozen; }
   bool lazy_compile_frozen() const { return lazy_compile_frozen_; }
   Vector<const uint8_t> wire_bytes() const { return wire_bytes_->as_vector(); }
@@ -578,6 +591,8 @@ class V8_EXPORT_PRIVATE NativeModule final {
   void AddCodeSpace(base::AddressRegion,
                     const WasmCodeAllocator::OptionalLock&);
 
+  void InitializeTieringBudgets(uint32_t num_functions);
+
   // Hold the {allocation_mutex_} when calling this method.
   bool has_interpreter_redirection(uint32_t func_index) {
     DCHECK_LT(func_index, num_functions());
@@ -634,6 +649,14 @@ class V8_EXPORT_PRIVATE NativeModule final {
   // hence needs to be destructed first when this native module dies.
   std::unique_ptr<CompilationState> compilation_state_;
 
+  // Tiering budget per declared function, updated by Liftoff code without
+  // synchronization. Lost updates only delay tier up.
+  std::unique_ptr<uint32_t[]> tiering_budgets_;
+
+  // Keeps the serialized code of a lazily deserialized module alive, see
+  // {DeserializeNativeModule}.
+  std::unique_ptr<LazilyDeserializedCode> lazily_deserialized_code_;
+
   // A cache of the import wrappers, keyed on the kind and signature.
   std::unique_ptr<WasmImportWrapperCache> import_wrapper_cache_;
 
@@ -666,6 +689,7 @@ class V8_EXPORT_PRIVATE NativeModule final {
   WasmEngine* const engine_;
   int modification_scope_depth_ = 0;
   UseTrapHandler use_trap_handler_ = kNoTrapHandler;
+  DynamicTiering dynamic_tiering_ = kNoDynamicTiering;
   bool lazy_compile_frozen_ = false;
 
   DISALLOW_COPY_AND_ASSIGN(NativeModule);
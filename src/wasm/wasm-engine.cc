@@ -4,6 +4,10 @@
 
 #include "src/wasm/wasm-engine.h"
 
+#include <cstdio>
+
+#include "src/base/functional.h"
+#include "src/base/memory.h"
 #include "src/base/platform/time.h"
 #include "src/diagnostics/code-tracer.h"
 #include "src/diagnostics/compilation-statistics.h"
@@ -20,6 +24,7 @@
 #include "src/wasm/module-instantiate.h"
 #include "src/wasm/streaming-decoder.h"
 #include "src/wasm/wasm-objects-inl.h"
+#include "src/wasm/wasm-serialization.h"
 
 namespace v8 {
 namespace internal {
@@ -209,6 +214,11 @@ struct WasmEngine::NativeModuleInfo {
   // Number of code GCs triggered because code in this native module became
   // potentially dead.
   int8_t num_code_gcs_triggered = 0;
+
+  // Whether this native module is in {native_module_cache_}, and under which
+  // key.
+  bool cached = false;
+  size_t wire_bytes_hash = 0;
 };
 
 WasmEngine::WasmEngine() : code_manager_(FLAG_wasm_max_code_space * MB) {}
@@ -286,6 +296,11 @@ Handle<WasmModuleObject> WasmEngine::FinalizeTranslatedAsmJs(
 MaybeHandle<WasmModuleObject> WasmEngine::SyncCompile(
     Isolate* isolate, const WasmFeatures& enabled, ErrorThrower* thrower,
     const ModuleWireBytes& bytes) {
+  Handle<WasmModuleObject> cached_module;
+  if (MaybeGetCachedModule(isolate, enabled, bytes).ToHandle(&cached_module)) {
+    return cached_module;
+  }
+
   ModuleResult result =
       DecodeWasmModule(enabled, bytes.start(), bytes.end(), false, kWasmOrigin,
                        isolate->counters(), allocator());
@@ -301,6 +316,7 @@ MaybeHandle<WasmModuleObject> WasmEngine::SyncCompile(
       CompileToNativeModule(isolate, enabled, thrower,
                             std::move(result).value(), bytes, &export_wrappers);
   if (!native_module) return {};
+  UpdateNativeModuleCache(native_module);
 
   Handle<Script> script =
       CreateWasmScript(isolate, bytes, native_module->module()->source_map_url,
@@ -463,6 +479,170 @@ Handle<WasmModuleObject> WasmEngine::ImportNativeModule(
   return module_object;
 }
 
+namespace {
+
+// Cache files start with the size of the wire bytes, followed by the wire
+// bytes themselves, a checksum of the serialized module and the serialized
+// module. The wire bytes are compared on load, since the file name only
+// contains their hash. The checksum only catches truncated or corrupted
+// files; the code itself is not verified, which is why the cache directory
+// has to be trusted.
+uint64_t CodeCacheChecksum(Vector<const uint8_t> serialized_module) {
+  return base::hash_range(serialized_module.begin(), serialized_module.end());
+}
+
+void WriteCodeCache(NativeModule* native_module) {
+  Vector<const uint8_t> wire_bytes = native_module->wire_bytes();
+  if (wire_bytes.empty()) return;
+  WasmSerializer serializer(native_module);
+  size_t header_size = sizeof(uint64_t) + wire_bytes.size() + sizeof(uint64_t);
+  std::vector<uint8_t> data(header_size +
+                            serializer.GetSerializedNativeModuleSize());
+  base::WriteUnalignedValue<uint64_t>(reinterpret_cast<Address>(data.data()),
+                                      wire_bytes.size());
+  memcpy(data.data() + sizeof(uint64_t), wire_bytes.begin(),
+         wire_bytes.size());
+  Vector<uint8_t> serialized_module =
+      VectorOf(data.data() + header_size, data.size() - header_size);
+  if (!serializer.SerializeNativeModule(serialized_module)) return;
+  base::WriteUnalignedValue<uint64_t>(
+      reinterpret_cast<Address>(data.data() + header_size - sizeof(uint64_t)),
+      CodeCacheChecksum(serialized_module));
+
+  // Write to a temporary file first, such that concurrent readers never see
+  // a partially written cache file.
+  std::string file_name = WasmEngine::GetCodeCacheFileName(wire_bytes);
+  std::string temp_file_name =
+      file_name + "." + std::to_string(base::OS::GetCurrentProcessId()) + "." +
+      std::to_string(base::OS::GetCurrentThreadId());
+  bool verbose = false;
+  if (WriteBytes(temp_file_name.c_str(), data.data(),
+                 static_cast<int>(data.size()),
+                 verbose) != static_cast<int>(data.size()) ||
+      std::rename(temp_file_name.c_str(), file_name.c_str()) != 0) {
+    std::remove(temp_file_name.c_str());
+  }
+}
+
+class WriteCodeCacheTask : public CancelableTask {
+ public:
+  WriteCodeCacheTask(CancelableTaskManager* manager,
+                     std::weak_ptr<NativeModule> native_module)
+      : CancelableTask(manager), native_module_(std::move(native_module)) {}
+
+  void RunInternal() override {
+    if (std::shared_ptr<NativeModule> native_module = native_module_.lock()) {
+      WriteCodeCache(native_module.get());
+    }
+  }
+
+ private:
+  const std::weak_ptr<NativeModule> native_module_;
+};
+
+}  // namespace
+
+// static
+std::string WasmEngine::GetCodeCacheFileName(Vector<const uint8_t> wire_bytes) {
+  DCHECK_NOT_NULL(FLAG_wasm_code_cache_dir);
+  std::string path = FLAG_wasm_code_cache_dir;
+  if (path.size() && !base::OS::isDirectorySeparator(path[path.size() - 1])) {
+    path += base::OS::DirectorySeparator();
+  }
+  size_t hash = base::hash_range(wire_bytes.begin(), wire_bytes.end());
+  EmbeddedVector<char, 32> buf;
+  SNPrintF(buf, "%016zx.wasm-cache", hash);
+  return path + buf.begin();
+}
+
+// static
+OwnedVector<uint8_t> WasmEngine::ReadCodeCacheFile(
+    Vector<const uint8_t> wire_bytes) {
+  bool exists = false;
+  std::string data =
+      ReadFile(GetCodeCacheFileName(wire_bytes).c_str(), &exists, false);
+  if (!exists) return {};
+  Vector<const uint8_t> contents(reinterpret_cast<const uint8_t*>(data.data()),
+                                 data.size());
+  size_t header_size = sizeof(uint64_t) + wire_bytes.size() + sizeof(uint64_t);
+  if (contents.size() < header_size ||
+      base::ReadUnalignedValue<uint64_t>(
+          reinterpret_cast<Address>(contents.begin())) != wire_bytes.size() ||
+      memcmp(contents.begin() + sizeof(uint64_t), wire_bytes.begin(),
+             wire_bytes.size()) != 0) {
+    return {};
+  }
+  Vector<const uint8_t> serialized_module = contents + header_size;
+  if (base::ReadUnalignedValue<uint64_t>(reinterpret_cast<Address>(
+          contents.begin() + header_size - sizeof(uint64_t))) !=
+      CodeCacheChecksum(serialized_module)) {
+    return {};
+  }
+  return OwnedVector<uint8_t>::Of(serialized_module);
+}
+
+MaybeHandle<WasmModuleObject> WasmEngine::MaybeGetCachedModule(
+    Isolate* isolate, const WasmFeatures& enabled,
+    const ModuleWireBytes& bytes) {
+  Vector<const uint8_t> wire_bytes = bytes.module_bytes();
+  if (std::shared_ptr<NativeModule> native_module =
+          GetCachedNativeModule(enabled, wire_bytes)) {
+    return ImportNativeModule(isolate, std::move(native_module));
+  }
+
+  if (FLAG_wasm_code_cache_dir == nullptr ||
+      !(enabled == WasmFeatures::FromIsolate(isolate))) {
+    return {};
+  }
+  OwnedVector<uint8_t> serialized_module = ReadCodeCacheFile(wire_bytes);
+  if (serialized_module.empty()) return {};
+  Handle<WasmModuleObject> module_object;
+  if (!DeserializeNativeModule(isolate, serialized_module.as_vector(),
+                               wire_bytes)
+           .ToHandle(&module_object)) {
+    return {};
+  }
+  UpdateNativeModuleCache(module_object->shared_native_module());
+  return module_object;
+}
+
+std::shared_ptr<NativeModule> WasmEngine::GetCachedNativeModule(
+    const WasmFeatures& enabled, Vector<const uint8_t> wire_bytes) {
+  if (!FLAG_wasm_native_module_cache) return nullptr;
+  size_t hash = base::hash_range(wire_bytes.begin(), wire_bytes.end());
+  // Modules locked below may die when their reference is dropped, which
+  // needs the {mutex_}. Hence keep them alive until after the lookup.
+  std::vector<std::shared_ptr<NativeModule>> candidates;
+  base::MutexGuard guard(&mutex_);
+  auto range = native_module_cache_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    std::shared_ptr<NativeModule> candidate = it->second.lock();
+    if (!candidate) continue;
+    candidates.push_back(candidate);
+    if (candidate->enabled_features() == enabled &&
+        candidate->wire_bytes() == wire_bytes &&
+        !candidate->compilation_state()->failed()) {
+      return candidate;
+    }
+  }
+  return nullptr;
+}
+
+void WasmEngine::UpdateNativeModuleCache(
+    const std::shared_ptr<NativeModule>& native_module) {
+  if (!FLAG_wasm_native_module_cache) return;
+  if (native_module->module()->origin != kWasmOrigin) return;
+  Vector<const uint8_t> wire_bytes = native_module->wire_bytes();
+  size_t hash = base::hash_range(wire_bytes.begin(), wire_bytes.end());
+  base::MutexGuard guard(&mutex_);
+  DCHECK_EQ(1, native_modules_.count(native_module.get()));
+  NativeModuleInfo* info = native_modules_[native_module.get()].get();
+  if (info->cached) return;
+  info->cached = true;
+  info->wire_bytes_hash = hash;
+  native_module_cache_.emplace(hash, native_module);
+}
+
 CompilationStatistics* WasmEngine::GetOrCreateTurboStatistics() {
   base::MutexGuard guard(&mutex_);
   if (compilation_stats_ == nullptr) {
@@ -681,6 +861,22 @@ std::shared_ptr<NativeModule> WasmEngine::NewNativeModule(
   std::shared_ptr<NativeModule> native_module =
       code_manager_.NewNativeModule(this, isolate, enabled, code_size_estimate,
                                     can_request_more, std::move(module));
+  // With dynamic tiering, "top tier finished" only means that baseline
+  // compilation finished, and most functions would be cached as Liftoff code.
+  // Such modules are not written to disk.
+  if (FLAG_wasm_code_cache_dir &&
+      native_module->module()->origin == kWasmOrigin &&
+      native_module->dynamic_tiering() == kNoDynamicTiering) {
+    // Only fires if the module gets compiled, not if it is deserialized.
+    std::weak_ptr<NativeModule> weak_native_module = native_module;
+    native_module->compilation_state()->AddCallback(
+        [this, weak_native_module](CompilationEvent event) {
+          if (event != CompilationEvent::kFinishedTopTierCompilation) return;
+          V8::GetCurrentPlatform()->CallOnWorkerThread(
+              NewBackgroundCompileTask<WriteCodeCacheTask>(
+                  weak_native_module));
+        });
+  }
   base::MutexGuard lock(&mutex_);
   auto pair = native_modules_.insert(std::make_pair(
       native_module.get(), std::make_unique<NativeModuleInfo>()));
@@ -730,6 +926,14 @@ void WasmEngine::FreeNativeModule(NativeModule* native_module) {
     TRACE_CODE_GC("Native module %p died, reducing dead code objects to %zu.\n",
                   native_module, current_gc_info_->dead_code.size());
   }
+  if (it->second->cached) {
+    auto range = native_module_cache_.equal_range(it->second->wire_bytes_hash);
+    for (auto entry = range.first; entry != range.second;) {
+      // The dying module's entry is already expired.
+      entry = entry->second.expired() ? native_module_cache_.erase(entry)
+                                      : std::next(entry);
+    }
+  }
   native_modules_.erase(it);
 }
 
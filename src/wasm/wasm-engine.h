@@ -6,6 +6,8 @@
 #define V8_WASM_WASM_ENGINE_H_
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "src/tasks/cancelable-task.h"
@@ -118,6 +120,35 @@ class V8_EXPORT_PRIVATE WasmEngine {
   Handle<WasmModuleObject> ImportNativeModule(
       Isolate* isolate, std::shared_ptr<NativeModule> shared_module);
 
+  // Returns a module object for already compiled code of the given wire bytes,
+  // taken from the process-wide cache (--wasm-native-module-cache) or the code
+  // cache directory (--wasm-code-cache-dir). Returns an empty handle if no
+  // such code exists and the module needs to be compiled.
+  MaybeHandle<WasmModuleObject> MaybeGetCachedModule(
+      Isolate* isolate, const WasmFeatures& enabled,
+      const ModuleWireBytes& bytes);
+
+  // Returns a live module from the process-wide cache that was compiled from
+  // the given wire bytes with the given features, or nullptr. Can be called on
+  // a background thread; the result still has to be imported into an isolate
+  // (see {ImportNativeModule}).
+  std::shared_ptr<NativeModule> GetCachedNativeModule(
+      const WasmFeatures& enabled, Vector<const uint8_t> wire_bytes);
+
+  // Returns the serialized module stored for the given wire bytes in
+  // --wasm-code-cache-dir, or an empty vector if there is no such file or it
+  // is corrupted. Can be called on a background thread.
+  static OwnedVector<uint8_t> ReadCodeCacheFile(
+      Vector<const uint8_t> wire_bytes);
+
+  // Makes a successfully compiled module available to {MaybeGetCachedModule}
+  // for as long as it is alive.
+  void UpdateNativeModuleCache(const std::shared_ptr<NativeModule>&);
+
+  // Returns the file in --wasm-code-cache-dir that holds the compiled code for
+  // the given wire bytes.
+  static std::string GetCodeCacheFileName(Vector<const uint8_t> wire_bytes);
+
   WasmCodeManager* code_manager() { return &code_manager_; }
 
   AccountingAllocator* allocator() { return &allocator_; }
@@ -267,6 +298,11 @@ class V8_EXPORT_PRIVATE WasmEngine {
   std::unordered_map<NativeModule*, std::unique_ptr<NativeModuleInfo>>
       native_modules_;
 
+  // Native modules that can be shared by {MaybeGetCachedModule}, keyed by the
+  // hash of their wire bytes. Entries are removed when the module dies.
+  std::unordered_multimap<size_t, std::weak_ptr<NativeModule>>
+      native_module_cache_;
+
   // Size of code that became dead since the last GC. If this exceeds a certain
   // threshold, a new GC is triggered.
   size_t new_potentially_dead_code_size_ = 0;
@@ -433,8 +433,21 @@ bool NativeModuleSerializer::Write(Writer* writer) {
 }
 
 WasmSerializer::WasmSerializer(NativeModule* native_module)
-    : native_module_(native_module),
-      code_table_(native_module->SnapshotCodeTable()) {}
+    : native_module_(native_module) {
+  // Functions of a lazily deserialized module that were never called only
+  // exist in serialized form. Materialize them to get a complete snapshot.
+  if (native_module->lazily_deserialized_code() != nullptr) {
+    WasmCodeRefScope wasm_code_ref_scope;
+    NativeModuleModificationScope native_module_modification_scope(
+        native_module);
+    uint32_t total_fns = native_module->num_functions();
+    uint32_t first_wasm_fn = native_module->num_imported_functions();
+    for (uint32_t i = first_wasm_fn; i < total_fns; ++i) {
+      if (!native_module->HasCode(i)) DeserializeLazyFunction(native_module, i);
+    }
+  }
+  code_table_ = native_module->SnapshotCodeTable();
+}
 
 size_t WasmSerializer::GetSerializedNativeModuleSize() const {
   NativeModuleSerializer serializer(native_module_, VectorOf(code_table_));
@@ -460,10 +473,15 @@ class V8_EXPORT_PRIVATE NativeModuleDeserializer {
   explicit NativeModuleDeserializer(NativeModule*);
 
   bool Read(Reader* reader);
+  // Like {Read}, but only records where the code of each function starts and
+  // installs lazy stubs for all functions.
+  bool ReadLazily(Reader* reader, std::vector<size_t>* offsets,
+                  size_t* num_unmaterialized);
+  // Reads the code of one function, after its code section size.
+  WasmCode* ReadCode(uint32_t fn_index, Reader* reader);
 
  private:
   bool ReadHeader(Reader* reader);
-  bool ReadCode(uint32_t fn_index, Reader* reader);
 
   NativeModule* const native_module_;
   bool read_called_;
@@ -482,7 +500,43 @@ bool NativeModuleDeserializer::Read(Reader* reader) {
   uint32_t total_fns = native_module_->num_functions();
   uint32_t first_wasm_fn = native_module_->num_imported_functions();
   for (uint32_t i = first_wasm_fn; i < total_fns; ++i) {
-    if (!ReadCode(i, reader)) return false;
+    size_t code_section_size = reader->Read<size_t>();
+    if (code_section_size == 0) {
+      DCHECK(FLAG_wasm_lazy_compilation ||
+             native_module_->enabled_features().has_compilation_hints());
+      native_module_->UseLazyStub(i);
+      continue;
+    }
+    ReadCode(i, reader);
+  }
+  return reader->current_size() == 0;
+}
+
+bool NativeModuleDeserializer::ReadLazily(Reader* reader,
+                                          std::vector<size_t>* offsets,
+                                          size_t* num_unmaterialized) {
+  DCHECK(!read_called_);
+  read_called_ = true;
+
+  if (!ReadHeader(reader)) return false;
+  uint32_t total_fns = native_module_->num_functions();
+  uint32_t first_wasm_fn = native_module_->num_imported_functions();
+  offsets->reserve(total_fns - first_wasm_fn);
+  for (uint32_t i = first_wasm_fn; i < total_fns; ++i) {
+    if (reader->current_size() < sizeof(size_t)) return false;
+    size_t code_section_size = reader->Read<size_t>();
+    if (code_section_size == 0) {
+      offsets->push_back(LazilyDeserializedCode::kNoCode);
+    } else {
+      ++*num_unmaterialized;
+      if (code_section_size < kCodeHeaderSize ||
+          code_section_size - sizeof(size_t) > reader->current_size()) {
+        return false;
+      }
+      offsets->push_back(reader->bytes_read());
+      reader->Skip(code_section_size - sizeof(size_t));
+    }
+    native_module_->UseLazyStub(i);
   }
   return reader->current_size() == 0;
 }
@@ -494,14 +548,8 @@ bool NativeModuleDeserializer::ReadHeader(Reader* reader) {
          imports == native_module_->num_imported_functions();
 }
 
-bool NativeModuleDeserializer::ReadCode(uint32_t fn_index, Reader* reader) {
-  size_t code_section_size = reader->Read<size_t>();
-  if (code_section_size == 0) {
-    DCHECK(FLAG_wasm_lazy_compilation ||
-           native_module_->enabled_features().has_compilation_hints());
-    native_module_->UseLazyStub(fn_index);
-    return true;
-  }
+WasmCode* NativeModuleDeserializer::ReadCode(uint32_t fn_index,
+                                             Reader* reader) {
   size_t constant_pool_offset = reader->Read<size_t>();
   size_t safepoint_table_offset = reader->Read<size_t>();
   size_t handler_table_offset = reader->Read<size_t>();
@@ -528,7 +576,7 @@ bool NativeModuleDeserializer::ReadCode(uint32_t fn_index, Reader* reader) {
           protected_instructions_size);
   reader->ReadVector(Vector<byte>::cast(protected_instructions.as_vector()));
 
-  WasmCode* code = native_module_->AddDeserializedCode(
+  std::unique_ptr<WasmCode> code = native_module_->AddDeserializedCode(
       fn_index, code_buffer, stack_slot_count, tagged_parameter_slots,
       safepoint_table_offset, handler_table_offset, constant_pool_offset,
       code_comment_offset, unpadded_binary_size,
@@ -585,11 +633,13 @@ bool NativeModuleDeserializer::ReadCode(uint32_t fn_index, Reader* reader) {
   code->MaybePrint();
   code->Validate();
 
-  // Finally, flush the icache for that code.
+  // Flush the icache for that code.
   FlushInstructionCache(code->instructions().begin(),
                         code->instructions().size());
 
-  return true;
+  // Finally, make the fully relocated code callable. Before this, other
+  // threads still call the lazy stub of a lazily deserialized function.
+  return native_module_->PublishCode(std::move(code));
 }
 
 bool IsSupportedVersion(Vector<const byte> version) {
@@ -635,11 +685,7 @@ MaybeHandle<WasmModuleObject> DeserializeNativeModule(
       isolate, std::move(shared_native_module), script, export_wrappers);
   NativeModule* native_module = module_object->native_module();
 
-  NativeModuleDeserializer deserializer(native_module);
-  WasmCodeRefScope wasm_code_ref_scope;
-
-  Reader reader(data + kVersionSize);
-  if (!deserializer.Read(&reader)) return {};
+  if (!DeserializeNativeModuleCode(native_module, data)) return {};
 
   // Log the code within the generated module for profiling.
   native_module->LogWasmCodes(isolate);
@@ -649,6 +695,57 @@ MaybeHandle<WasmModuleObject> DeserializeNativeModule(
   return module_object;
 }
 
+bool DeserializeNativeModuleCode(NativeModule* native_module,
+                                 Vector<const byte> data) {
+  DCHECK(IsSupportedVersion(data));
+  NativeModuleDeserializer deserializer(native_module);
+  WasmCodeRefScope wasm_code_ref_scope;
+
+  if (FLAG_wasm_lazy_deserialization) {
+    // Keep a copy of the serialized code instead of relocating every function
+    // now; {CompileLazy} materializes each function on its first call.
+    auto lazy_code = std::make_unique<LazilyDeserializedCode>();
+    lazy_code->data = OwnedVector<byte>::Of(data + kVersionSize);
+    Reader reader(lazy_code->data.as_vector());
+    if (!deserializer.ReadLazily(&reader, &lazy_code->offsets,
+                                 &lazy_code->num_unmaterialized)) {
+      return false;
+    }
+    native_module->SetLazilyDeserializedCode(std::move(lazy_code));
+    return true;
+  }
+  Reader reader(data + kVersionSize);
+  return deserializer.Read(&reader);
+}
+
+WasmCode* DeserializeLazyFunction(NativeModule* native_module,
+                                  uint32_t func_index) {
+  LazilyDeserializedCode* lazy_code = native_module->lazily_deserialized_code();
+  if (lazy_code == nullptr) return nullptr;
+  DCHECK_LE(native_module->num_imported_functions(), func_index);
+  // Several threads can ask for the same function: isolates sharing the
+  // module, and a {WasmSerializer}. Only the first one copies the code, the
+  // others get the code it published.
+  base::MutexGuard guard(&lazy_code->mutex);
+  size_t& offset =
+      lazy_code->offsets[func_index - native_module->num_imported_functions()];
+  if (offset == LazilyDeserializedCode::kMaterialized) {
+    return native_module->GetCode(func_index);
+  }
+  if (offset == LazilyDeserializedCode::kNoCode) return nullptr;
+
+  NativeModuleDeserializer deserializer(native_module);
+  Reader reader(lazy_code->data.as_vector() + offset);
+  WasmCode* code = deserializer.ReadCode(func_index, &reader);
+  offset = LazilyDeserializedCode::kMaterialized;
+  // Release the serialized data once every function was copied out of it.
+  DCHECK_LT(0, lazy_code->num_unmaterialized);
+  if (--lazy_code->num_unmaterialized == 0) {
+    lazy_code->data = OwnedVector<byte>();
+  }
+  return code;
+}
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8
@@ -5,6 +5,10 @@
 #ifndef V8_WASM_WASM_SERIALIZATION_H_
 #define V8_WASM_WASM_SERIALIZATION_H_
 
+#include <limits>
+#include <vector>
+
+#include "src/base/platform/mutex.h"
 #include "src/wasm/wasm-objects.h"
 
 namespace v8 {
@@ -16,6 +20,14 @@ namespace wasm {
 // the module after that won't affect the serialized result.
 class V8_EXPORT_PRIVATE WasmSerializer {
  public:
+  // If {native_module} was deserialized lazily, this materializes all functions
+  // that were not called yet, and thus modifies the module. That is safe on
+  // any thread and concurrently with {CompileLazy} in every isolate sharing the
+  // module, because each function is materialized at most once, under
+  // {LazilyDeserializedCode::mutex}. With {--wasm-write-protect-code-memory}
+  // the serializer must be created on a thread that does not race with other
+  // modifications of the module, since modification scopes are not
+  // thread-safe yet (v8:7424).
   explicit WasmSerializer(NativeModule* native_module);
 
   // Measure the required buffer size needed for serialization.
@@ -30,6 +42,27 @@ class V8_EXPORT_PRIVATE WasmSerializer {
   std::vector<WasmCode*> code_table_;
 };
 
+// The serialized code of a module that was deserialized with
+// {--wasm-lazy-deserialization}. Deserialization only installs lazy stubs; the
+// code of each function is copied into the code space and relocated when the
+// function is first called (see {DeserializeLazyFunction}).
+struct LazilyDeserializedCode {
+  static constexpr size_t kNoCode = std::numeric_limits<size_t>::max();
+  static constexpr size_t kMaterialized = kNoCode - 1;
+
+  // Protects all fields below, and serializes materialization of functions.
+  base::Mutex mutex;
+  // The serialized module, without the version header. Released once all
+  // functions were materialized.
+  OwnedVector<byte> data;
+  // Offset of the serialized code of each declared function into {data},
+  // {kNoCode} if the function was serialized without code, or {kMaterialized}
+  // if its code was already copied out of {data}.
+  std::vector<size_t> offsets;
+  // Number of functions whose code is still only in {data}.
+  size_t num_unmaterialized = 0;
+};
+
 // Support for deserializing WebAssembly {NativeModule} objects.
 // Checks the version header of the data against the current version.
 bool IsSupportedVersion(Vector<const byte> data);
@@ -38,6 +71,21 @@ bool IsSupportedVersion(Vector<const byte> data);
 MaybeHandle<WasmModuleObject> DeserializeNativeModule(
     Isolate* isolate, Vector<const byte> data, Vector<const byte> wire_bytes);
 
+// Copies the serialized code in {data} into {native_module}, which has to be
+// freshly created for the same wire bytes. Returns false if {data} is
+// malformed, in which case {native_module} must not be used. Does not touch
+// the heap and can thus be called on a background thread.
+bool DeserializeNativeModuleCode(NativeModule* native_module,
+                                 Vector<const byte> data);
+
+// Copies the serialized code of {func_index} of a lazily deserialized module
+// into the code space, relocates it and then publishes it. Returns the code
+// published earlier if another thread already did so, and nullptr if there is
+// no serialized code for that function, which then needs to be compiled. Can
+// be called on any thread.
+WasmCode* DeserializeLazyFunction(NativeModule* native_module,
+                                  uint32_t func_index);
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8
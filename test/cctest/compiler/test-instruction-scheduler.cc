@@ -51,7 +51,10 @@ class InstructionSchedulerTester {
              successors.end());
   }
 
+  int GetLatency(Instruction* instr) { return GetNode(instr)->latency(); }
+
   Zone* zone() { return scope_.main_zone(); }
+  InstructionSequence* sequence() { return &sequence_; }
 
  private:
   InstructionScheduler::ScheduleGraphNode* GetNode(Instruction* instr) {
@@ -108,6 +111,44 @@ TEST(DeoptInMiddleOfBasicBlock) {
   tester.EndBlock();
 }
 
+#if V8_TARGET_ARCH_X64
+TEST(MemoryLoadsAreNotCheaperThanRegisterMoves) {
+  InstructionSchedulerTester tester;
+  Zone* zone = tester.zone();
+  InstructionSequence* sequence = tester.sequence();
+
+  auto NewOperand = [&]() {
+    return UnallocatedOperand(UnallocatedOperand::MUST_HAVE_REGISTER,
+                              sequence->NextVirtualRegister());
+  };
+
+  tester.StartBlock();
+  InstructionOperand base = NewOperand();
+  InstructionOperand loaded = NewOperand();
+  Instruction* load_inst = Instruction::New(
+      zone, kX64Movq | AddressingModeField::encode(kMode_MR), 1, &loaded, 1,
+      &base, 0, nullptr);
+  tester.AddInstruction(load_inst);
+  InstructionOperand moved = NewOperand();
+  Instruction* move_inst =
+      Instruction::New(zone, kX64Movq, 1, &moved, 1, &loaded, 0, nullptr);
+  tester.AddInstruction(move_inst);
+  InstructionOperand quotient = NewOperand();
+  Instruction* div_inst =
+      Instruction::New(zone, kX64Idiv, 1, &quotient, 1, &moved, 0, nullptr);
+  tester.AddInstruction(div_inst);
+  tester.AddTerminator(Instruction::New(zone, kArchRet));
+
+  CHECK_EQ(1, tester.GetLatency(move_inst));
+  CHECK_LE(tester.GetLatency(move_inst), tester.GetLatency(load_inst));
+  CHECK_LT(tester.GetLatency(load_inst), tester.GetLatency(div_inst));
+  tester.CheckInSuccessors(load_inst, move_inst);
+  tester.CheckInSuccessors(move_inst, div_inst);
+
+  tester.EndBlock();
+}
+#endif  // V8_TARGET_ARCH_X64
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
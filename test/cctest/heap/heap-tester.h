@@ -16,8 +16,11 @@
   V(CompactionPartiallyAbortedPageIntraAbortedPointers)     \
   V(CompactionPartiallyAbortedPageWithInvalidatedSlots)     \
   V(CompactionPartiallyAbortedPageWithRememberedSetEntries) \
+  V(CompactionPostponedByPauseBudget)                       \
   V(CompactionSpaceDivideMultiplePages)                     \
   V(CompactionSpaceDivideSinglePage)                        \
+  V(ConcurrentLargeObjectSweeping)                          \
+  V(EvacuationPauseBudgetFromResourceConstraints)           \
   V(InvalidatedSlotsAfterTrimming)                          \
   V(InvalidatedSlotsAllInvalidatedRanges)                   \
   V(InvalidatedSlotsCleanupEachObject)                      \
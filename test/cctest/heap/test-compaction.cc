@@ -4,6 +4,7 @@
 
 #include "src/execution/isolate.h"
 #include "src/heap/factory.h"
+#include "src/heap/gc-tracer.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/mark-compact.h"
 #include "src/heap/remembered-set.h"
@@ -85,6 +86,66 @@ HEAP_TEST(CompactionFullAbortedPage) {
   }
 }
 
+HEAP_TEST(CompactionPostponedByPauseBudget) {
+  if (FLAG_never_compact) return;
+  // Test the scenario where an evacuation candidate does not fit into the
+  // evacuation pause budget and stays in place.
+
+  ManualGCScope manual_gc_scope;
+  FLAG_manual_evacuation_candidates_selection = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  {
+    HandleScope scope1(isolate);
+
+    heap::SealCurrentObjects(heap);
+
+    {
+      HandleScope scope2(isolate);
+      CHECK(heap->old_space()->Expand());
+      auto compaction_page_handles = heap::CreatePadding(
+          heap,
+          static_cast<int>(MemoryChunkLayout::AllocatableMemoryInDataPage()),
+          AllocationType::kOld);
+      Page* to_be_postponed_page =
+          Page::FromHeapObject(*compaction_page_handles.front());
+      to_be_postponed_page->SetFlag(
+          MemoryChunk::FORCE_EVACUATION_CANDIDATE_FOR_TESTING);
+      CheckAllObjectsOnPage(compaction_page_handles, to_be_postponed_page);
+
+      // A compaction speed of 1KB/ms allows to evacuate less than a page
+      // within 1ms. Overwrite all previously recorded samples.
+      for (int i = 0; i < 2 * base::RingBuffer<BytesAndDuration>::kSize; i++) {
+        heap->tracer()->AddCompactionEvent(1, KB);
+      }
+      CcTest::isolate()->SetEvacuationPauseBudget(1);
+      CcTest::CollectAllGarbage();
+      heap->mark_compact_collector()->EnsureSweepingCompleted();
+      CcTest::isolate()->SetEvacuationPauseBudget(0);
+
+      for (Handle<FixedArray> object : compaction_page_handles) {
+        CHECK_EQ(to_be_postponed_page, Page::FromHeapObject(*object));
+      }
+      CheckInvariantsOfAbortedPage(to_be_postponed_page);
+    }
+  }
+}
+
+HEAP_TEST(EvacuationPauseBudgetFromResourceConstraints) {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  create_params.constraints.set_evacuation_pause_budget_in_ms(5);
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    Heap* heap = reinterpret_cast<Isolate*>(isolate)->heap();
+    CHECK_EQ(5, heap->evacuation_pause_budget_ms());
+    isolate->SetEvacuationPauseBudget(0);
+    CHECK_EQ(0, heap->evacuation_pause_budget_ms());
+  }
+  isolate->Dispose();
+}
+
 namespace {
 
 int GetObjectSize(int objects_per_page) {
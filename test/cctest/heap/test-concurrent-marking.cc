@@ -11,6 +11,7 @@
 #include "src/heap/heap.h"
 #include "src/heap/mark-compact.h"
 #include "src/heap/worklist.h"
+#include "src/objects/heap-number-inl.h"
 #include "test/cctest/cctest.h"
 #include "test/cctest/heap/heap-utils.h"
 
@@ -144,6 +145,83 @@ UNINITIALIZED_TEST(ConcurrentMarkingStoppedOnTeardown) {
   isolate->Dispose();
 }
 
+#ifdef ENABLE_MINOR_MC
+UNINITIALIZED_TEST(MinorMCConcurrentMarkingWriteBarrier) {
+  FLAG_minor_mc = true;
+  FLAG_minor_mc_concurrent_marking = true;
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+
+  {
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+    Factory* factory = i_isolate->factory();
+    Heap* heap = i_isolate->heap();
+
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::New(isolate)->Enter();
+
+    Handle<FixedArray> array = factory->NewFixedArray(1);
+    CHECK(Heap::InYoungGeneration(*array));
+    MinorMarkCompactCollector* collector = heap->minor_mark_compact_collector();
+    if (!collector->IsConcurrentMarking()) {
+      collector->StartConcurrentMarking();
+    }
+    CHECK(heap->IsMinorMCConcurrentMarking());
+    {
+      // The number is only reachable through the write into the array that
+      // may already have been visited by a concurrent marker.
+      HandleScope inner_scope(i_isolate);
+      Handle<HeapNumber> number = factory->NewHeapNumber(42.0);
+      CHECK(Heap::InYoungGeneration(*number));
+      array->set(0, *number);
+    }
+    heap->CollectGarbage(NEW_SPACE, GarbageCollectionReason::kTesting);
+    CHECK(!heap->IsMinorMCConcurrentMarking());
+    CHECK_EQ(42.0, HeapNumber::cast(array->get(0)).value());
+  }
+
+  isolate->Dispose();
+}
+
+UNINITIALIZED_TEST(MinorMCConcurrentMarkingAbortedByFullGC) {
+  FLAG_minor_mc = true;
+  FLAG_minor_mc_concurrent_marking = true;
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+
+  {
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+    Factory* factory = i_isolate->factory();
+    Heap* heap = i_isolate->heap();
+
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::New(isolate)->Enter();
+
+    Handle<FixedArray> array = factory->NewFixedArray(16);
+    MinorMarkCompactCollector* collector = heap->minor_mark_compact_collector();
+    if (!collector->IsConcurrentMarking()) {
+      collector->StartConcurrentMarking();
+    }
+    CHECK(heap->IsMinorMCConcurrentMarking());
+    heap->CollectAllGarbage(Heap::kNoGCFlags,
+                            GarbageCollectionReason::kTesting);
+    CHECK(!heap->IsMinorMCConcurrentMarking());
+    CHECK_EQ(16, array->length());
+    // The next minor mark-compact starts from scratch.
+    heap->CollectGarbage(NEW_SPACE, GarbageCollectionReason::kTesting);
+    CHECK_EQ(16, array->length());
+  }
+
+  isolate->Dispose();
+}
+#endif  // ENABLE_MINOR_MC
+
 }  // namespace heap
 }  // namespace internal
 }  // namespace v8
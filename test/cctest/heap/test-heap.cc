@@ -39,6 +39,7 @@
 #include "src/heap/combined-heap.h"
 #include "src/heap/factory.h"
 #include "src/heap/gc-tracer.h"
+#include "src/heap/heap-budget.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/incremental-marking.h"
 #include "src/heap/mark-compact.h"
@@ -6037,6 +6038,49 @@ TEST(UncommitUnusedLargeObjectMemory) {
   CHECK_EQ(shrinked_size, chunk->CommittedPhysicalMemory());
 }
 
+HEAP_TEST(ConcurrentLargeObjectSweeping) {
+  if (!FLAG_concurrent_sweeping) return;
+  FLAG_concurrent_large_object_sweeping = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Heap* heap = CcTest::heap();
+  Isolate* isolate = heap->isolate();
+  MarkCompactCollector* collector = heap->mark_compact_collector();
+
+  CcTest::CollectAllGarbage();
+  collector->EnsureSweepingCompleted();
+  const int page_count_before = heap->lo_space()->PageCount();
+  const size_t size_before = heap->lo_space()->Size();
+
+  const int kArrays = 8;
+  {
+    HandleScope inner_scope(isolate);
+    for (int i = 0; i < kArrays; i++) {
+      Handle<FixedArray> array =
+          isolate->factory()->NewFixedArray(200000, AllocationType::kOld);
+      CHECK(heap->lo_space()->Contains(*array));
+    }
+  }
+  CHECK_EQ(page_count_before + kArrays, heap->lo_space()->PageCount());
+  const size_t allocated_before_gc = heap->memory_allocator()->Size();
+
+  // Keep the dead pages on the sweeper until sweeping is completed on the
+  // main thread.
+  heap->delay_sweeper_tasks_for_testing_ = true;
+  CcTest::CollectAllGarbage();
+  // The dead pages are unlinked and unaccounted in the atomic pause.
+  CHECK_EQ(page_count_before, heap->lo_space()->PageCount());
+  CHECK_EQ(size_before, heap->lo_space()->Size());
+  CHECK_LT(heap->memory_allocator()->Size(),
+           allocated_before_gc - kArrays * FixedArray::SizeFor(200000) / 2);
+  heap->delay_sweeper_tasks_for_testing_ = false;
+
+  collector->EnsureSweepingCompleted();
+  CHECK(!collector->sweeping_in_progress());
+  heap->memory_allocator()->unmapper()->EnsureUnmappingCompleted();
+  CHECK_EQ(0, heap->memory_allocator()->unmapper()->NumberOfChunks());
+}
+
 template <RememberedSetType direction>
 static size_t GetRememberedSetSize(HeapObject obj) {
   size_t count = 0;
@@ -6840,6 +6884,32 @@ TEST(CodeObjectRegistry) {
   CHECK(MemoryChunk::FromAddress(code2_address)->Contains(code2_address));
 }
 
+UNINITIALIZED_TEST(HeapBudgetSharedByIsolates) {
+  std::unique_ptr<v8::HeapBudget> budget = v8::HeapBudget::New(512 * MB);
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  create_params.heap_budget = budget.get();
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+
+  for (v8::Isolate* isolate : {isolate1, isolate2}) {
+    v8::Isolate::Scope isolate_scope(isolate);
+    Heap* heap = reinterpret_cast<Isolate*>(isolate)->heap();
+    CHECK_EQ(HeapBudget::From(budget.get()), heap->heap_budget());
+    // The usage is reported after every GC.
+    heap->CollectAllGarbage(Heap::kNoGCFlags,
+                            GarbageCollectionReason::kTesting);
+    CHECK_LT(0, budget->used_bytes(isolate));
+  }
+  CHECK_EQ(budget->used_bytes(),
+           budget->used_bytes(isolate1) + budget->used_bytes(isolate2));
+
+  isolate1->Dispose();
+  CHECK_EQ(budget->used_bytes(), budget->used_bytes(isolate2));
+  isolate2->Dispose();
+  CHECK_EQ(0, budget->used_bytes());
+}
+
 }  // namespace heap
 }  // namespace internal
 }  // namespace v8
@@ -92,6 +92,30 @@ class TestCodePageAllocatorScope {
   DISALLOW_COPY_AND_ASSIGN(TestCodePageAllocatorScope);
 };
 
+// Temporarily sets a given data page allocator in an isolate.
+class TestDataPageAllocatorScope {
+ public:
+  TestDataPageAllocatorScope(Isolate* isolate,
+                             v8::PageAllocator* data_page_allocator)
+      : isolate_(isolate),
+        old_data_page_allocator_(
+            isolate->heap()->memory_allocator()->data_page_allocator()) {
+    isolate->heap()->memory_allocator()->data_page_allocator_ =
+        data_page_allocator;
+  }
+
+  ~TestDataPageAllocatorScope() {
+    isolate_->heap()->memory_allocator()->data_page_allocator_ =
+        old_data_page_allocator_;
+  }
+
+ private:
+  Isolate* isolate_;
+  v8::PageAllocator* old_data_page_allocator_;
+
+  DISALLOW_COPY_AND_ASSIGN(TestDataPageAllocatorScope);
+};
+
 static void VerifyMemoryChunk(Isolate* isolate, Heap* heap,
                               v8::PageAllocator* code_page_allocator,
                               size_t reserve_area_size, size_t commit_area_size,
@@ -212,6 +236,55 @@ TEST(MemoryAllocator) {
   // OldSpace's destructor will tear down the space and free up all pages.
 }
 
+TEST(HugePageGroups) {
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  bool saved_transparent_huge_pages = FLAG_transparent_huge_pages;
+  FLAG_transparent_huge_pages = true;
+  {
+    // Use a fresh reservation, so that whole huge page blocks are available.
+    v8::PageAllocator* page_allocator = GetPlatformPageAllocator();
+    const size_t reservation_size = 32 * MB;
+    VirtualMemory reservation(page_allocator, reservation_size, nullptr,
+                              MemoryChunk::kAlignment);
+    CHECK(reservation.IsReserved());
+    base::BoundedPageAllocator data_page_allocator(
+        page_allocator, reservation.address(), reservation.size(),
+        MemoryChunk::kAlignment);
+    data_page_allocator.set_honor_address_hints(true);
+
+    TestMemoryAllocatorScope test_allocator_scope(isolate, heap->MaxReserved(),
+                                                  0);
+    MemoryAllocator* memory_allocator = test_allocator_scope.allocator();
+    TestDataPageAllocatorScope test_data_page_allocator_scope(
+        isolate, &data_page_allocator);
+
+    OldSpace faked_space(heap);
+    const int kPagesPerHugePage =
+        static_cast<int>(base::OS::kHugePageSize / MemoryChunk::kPageSize);
+    Page* previous_page = nullptr;
+    for (int i = 0; i <= kPagesPerHugePage; i++) {
+      Page* page = memory_allocator->AllocatePage(
+          faked_space.AreaSize(), static_cast<PagedSpace*>(&faked_space),
+          NOT_EXECUTABLE);
+      CHECK_NOT_NULL(page);
+      faked_space.memory_chunk_list().PushBack(page);
+      if (i % kPagesPerHugePage == 0) {
+        // Every block starts at a huge page boundary.
+        CHECK(IsAligned(page->address(), base::OS::kHugePageSize));
+      } else {
+        // The remaining pages of a block follow each other.
+        CHECK_EQ(previous_page->address() + MemoryChunk::kPageSize,
+                 page->address());
+      }
+      previous_page = page;
+    }
+
+    // OldSpace's destructor will tear down the space and free up all pages.
+  }
+  FLAG_transparent_huge_pages = saved_transparent_huge_pages;
+}
+
 TEST(ComputeDiscardMemoryAreas) {
   base::AddressRegion memory_area;
   size_t page_size = MemoryAllocator::GetCommitPageSize();
@@ -273,6 +346,27 @@ TEST(NewSpace) {
   memory_allocator->unmapper()->EnsureUnmappingCompleted();
 }
 
+TEST(NewSpaceGrowByWithoutGrowth) {
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  TestMemoryAllocatorScope test_allocator_scope(isolate, heap->MaxReserved(),
+                                                0);
+  MemoryAllocator* memory_allocator = test_allocator_scope.allocator();
+
+  NewSpace new_space(heap, memory_allocator->data_page_allocator(),
+                     Page::kPageSize, 4 * Page::kPageSize);
+  const size_t initial_capacity = new_space.TotalCapacity();
+  new_space.GrowBy(1.0);
+  CHECK_EQ(initial_capacity, new_space.TotalCapacity());
+  new_space.GrowBy(0.5);
+  CHECK_EQ(initial_capacity, new_space.TotalCapacity());
+  new_space.GrowBy(2.0);
+  CHECK_EQ(2 * initial_capacity, new_space.TotalCapacity());
+
+  new_space.TearDown();
+  memory_allocator->unmapper()->EnsureUnmappingCompleted();
+}
+
 
 TEST(OldSpace) {
   Isolate* isolate = CcTest::i_isolate();
@@ -802,6 +802,39 @@ TEST(InvocationCount) {
   CHECK_EQ(4, foo->feedback_vector().invocation_count());
 }
 
+TEST(TurbopropMidTierTierUp) {
+  if (FLAG_always_opt || !FLAG_opt || FLAG_lite_mode || FLAG_turboprop) return;
+  FLAG_allow_natives_syntax = true;
+  FLAG_turboprop_mid_tier = true;
+  FLAG_concurrent_recompilation = false;
+  FLAG_use_osr = false;
+  CcTest::InitializeVM();
+  if (!CcTest::i_isolate()->use_optimizer()) return;
+  v8::HandleScope scope(CcTest::isolate());
+
+  CompileRun(
+      "function f(n) {"
+      "  let sum = 0;"
+      "  for (let i = 0; i < n; i++) sum = (sum + i) | 0;"
+      "  return sum;"
+      "};"
+      "%PrepareFunctionForOptimization(f);"
+      "f(10);"
+      "%OptimizeFunctionOnNextCall(f);"
+      "f(10);");
+  Handle<JSFunction> f = Handle<JSFunction>::cast(GetGlobalProperty("f"));
+  CHECK(f->IsOptimized());
+  CHECK_EQ(OptimizationTier::kMidTier,
+           f->feedback_vector().optimization_tier());
+
+  // The mid-tier code keeps exhausting the interrupt budget, which eventually
+  // sends the function back through the trampoline and on to TurboFan.
+  CompileRun("for (let i = 0; i < 100; i++) f(10000);");
+  CHECK(f->IsOptimized());
+  CHECK_EQ(OptimizationTier::kTopTier,
+           f->feedback_vector().optimization_tier());
+}
+
 TEST(SafeToSkipArgumentsAdaptor) {
   CcTest::InitializeVM();
   v8::HandleScope scope(CcTest::isolate());
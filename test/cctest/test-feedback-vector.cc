@@ -6,9 +6,12 @@
 #include "test/cctest/cctest.h"
 
 #include "src/api/api-inl.h"
+#include "src/codegen/compilation-cache.h"
 #include "src/codegen/macro-assembler.h"
+#include "src/debug/debug-interface.h"
 #include "src/debug/debug.h"
 #include "src/execution/execution.h"
+#include "src/execution/feedback-profile.h"
 #include "src/handles/global-handles.h"
 #include "src/heap/factory.h"
 #include "src/objects/feedback-cell-inl.h"
@@ -771,6 +774,113 @@ TEST(StoreOwnIC) {
   CHECK_EQ(MONOMORPHIC, nexus.ic_state());
 }
 
+TEST(FeedbackProfileSeedsBinaryOpFeedback) {
+  if (!i::FLAG_use_ic) return;
+  if (i::FLAG_always_opt) return;
+  FLAG_allow_natives_syntax = true;
+
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  isolate->compilation_cache()->DisableScriptAndEval();
+
+  std::vector<uint8_t> profile;
+  {
+    LocalContext context;
+    v8::HandleScope scope(context->GetIsolate());
+    CompileRunWithOrigin(
+        "function f(a, b) {"
+        "  return a + b;"
+        "};"
+        "%EnsureFeedbackVectorForFunction(f);"
+        "f(1.5, 2.5);",
+        "profile.js");
+    profile = v8::debug::CollectFeedbackProfile(CcTest::isolate());
+  }
+
+  // Truncated profiles are rejected.
+  CHECK(!v8::debug::SetFeedbackProfile(CcTest::isolate(), profile.data(),
+                                       profile.size() - 1));
+  CHECK_NULL(isolate->feedback_profile());
+  CHECK(v8::debug::SetFeedbackProfile(CcTest::isolate(), profile.data(),
+                                      profile.size()));
+
+  {
+    // Same script, but {f} is never called.
+    LocalContext context;
+    v8::HandleScope scope(context->GetIsolate());
+    CompileRunWithOrigin(
+        "function f(a, b) {"
+        "  return a + b;"
+        "};"
+        "%EnsureFeedbackVectorForFunction(f);",
+        "profile.js");
+    Handle<JSFunction> f = GetFunction("f");
+    Handle<FeedbackVector> feedback_vector(f->feedback_vector(), isolate);
+    FeedbackVectorHelper helper(feedback_vector);
+    CHECK_EQ(1, helper.slot_count());
+    CHECK_SLOT_KIND(helper, 0, FeedbackSlotKind::kBinaryOp);
+    FeedbackNexus nexus(feedback_vector, helper.slot(0));
+    CHECK_EQ(BinaryOperationHint::kNumber,
+             nexus.GetBinaryOperationFeedback());
+  }
+
+  isolate->set_feedback_profile(nullptr);
+}
+
+TEST(FeedbackProfileSeedsCallFeedback) {
+  if (!i::FLAG_use_ic) return;
+  if (i::FLAG_always_opt) return;
+  FLAG_allow_natives_syntax = true;
+
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  isolate->compilation_cache()->DisableScriptAndEval();
+
+  const char* source =
+      "function g(a) {"
+      "  return a;"
+      "};"
+      "function f(a) {"
+      "  return g(a);"
+      "};"
+      "%EnsureFeedbackVectorForFunction(f);"
+      "%EnsureFeedbackVectorForFunction(g);";
+
+  std::vector<uint8_t> profile;
+  {
+    LocalContext context;
+    v8::HandleScope scope(context->GetIsolate());
+    CompileRunWithOrigin(
+        (std::string(source) + "f(1); f(2); f(3);").c_str(), "profile.js");
+    profile = v8::debug::CollectFeedbackProfile(CcTest::isolate());
+  }
+  CHECK(v8::debug::SetFeedbackProfile(CcTest::isolate(), profile.data(),
+                                      profile.size()));
+
+  {
+    // Same script, but neither function is called. {f} gets its feedback
+    // vector before its call target {g} does.
+    LocalContext context;
+    v8::HandleScope scope(context->GetIsolate());
+    CompileRunWithOrigin(source, "profile.js");
+    Handle<JSFunction> f = GetFunction("f");
+    Handle<JSFunction> g = GetFunction("g");
+    Handle<FeedbackVector> feedback_vector(f->feedback_vector(), isolate);
+    CHECK_EQ(3, feedback_vector->invocation_count());
+    FeedbackVectorHelper helper(feedback_vector);
+    CHECK_EQ(1, helper.slot_count());
+    CHECK_SLOT_KIND(helper, 0, FeedbackSlotKind::kCall);
+    FeedbackNexus nexus(feedback_vector, helper.slot(0));
+    CHECK_EQ(MONOMORPHIC, nexus.ic_state());
+    CHECK_EQ(3, nexus.GetCallCount());
+    HeapObject target;
+    CHECK(nexus.GetFeedback()->GetHeapObjectIfWeak(&target));
+    CHECK_EQ(*g, target);
+  }
+
+  isolate->set_feedback_profile(nullptr);
+}
+
 }  // namespace
 
 }  // namespace internal
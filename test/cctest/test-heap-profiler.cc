@@ -29,7 +29,9 @@
 
 #include <ctype.h>
 
+#include <algorithm>
 #include <memory>
+#include <string>
 
 #include "src/init/v8.h"
 
@@ -1197,6 +1199,186 @@ TEST(HeapSnapshotJSONSerializationAborting) {
   CHECK_EQ(0, stream.eos_signaled());
 }
 
+TEST(HeapSnapshotJSONSerializationParallel) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  // Make sure that nodes and edges span several shards.
+  CompileRun(
+      "var objects = [];\n"
+      "for (var i = 0; i < 50000; i++) objects.push({id: i, name: 'o' + i});");
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+
+  i::FLAG_parallel_heap_snapshot_serialization = false;
+  TestJSONStream sequential_stream;
+  snapshot->Serialize(&sequential_stream, v8::HeapSnapshot::kJSON);
+  CHECK_EQ(1, sequential_stream.eos_signaled());
+
+  i::FLAG_parallel_heap_snapshot_serialization = true;
+  TestJSONStream parallel_stream;
+  snapshot->Serialize(&parallel_stream, v8::HeapSnapshot::kJSON);
+  CHECK_EQ(1, parallel_stream.eos_signaled());
+
+  CHECK_EQ(sequential_stream.size(), parallel_stream.size());
+  i::ScopedVector<char> sequential_json(sequential_stream.size());
+  sequential_stream.WriteTo(sequential_json);
+  i::ScopedVector<char> parallel_json(parallel_stream.size());
+  parallel_stream.WriteTo(parallel_json);
+  CHECK_EQ(0, memcmp(sequential_json.begin(), parallel_json.begin(),
+                     sequential_json.length()));
+
+  TestJSONStream aborted_stream(5);
+  snapshot->Serialize(&aborted_stream, v8::HeapSnapshot::kJSON);
+  CHECK_GT(aborted_stream.size(), 0);
+  CHECK_EQ(0, aborted_stream.eos_signaled());
+}
+
+namespace {
+
+class BinarySnapshotReader {
+ public:
+  explicit BinarySnapshotReader(i::Vector<char> data) : data_(data), pos_(0) {}
+
+  uint64_t ReadVarint() {
+    uint64_t result = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+      CHECK_LT(pos_, data_.length());
+      byte = static_cast<uint8_t>(data_[pos_++]);
+      result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+    return result;
+  }
+
+  std::string ReadBytes(size_t length) {
+    CHECK_LE(pos_ + length, data_.length());
+    std::string result(data_.begin() + pos_, length);
+    pos_ += length;
+    return result;
+  }
+
+  bool AtEnd() const { return pos_ == data_.length(); }
+
+ private:
+  i::Vector<char> data_;
+  size_t pos_;
+};
+
+}  // namespace
+
+TEST(HeapSnapshotBinarySerialization) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  CompileRun(
+      "function A(s) { this.s = s; }\n"
+      "var a = new A('binary snapshot string');");
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+  const i::HeapSnapshot* heap_snapshot =
+      reinterpret_cast<const i::HeapSnapshot*>(snapshot);
+
+  TestJSONStream json_stream;
+  snapshot->Serialize(&json_stream, v8::HeapSnapshot::kJSON);
+  TestJSONStream stream;
+  snapshot->Serialize(&stream, v8::HeapSnapshot::kBinary);
+  CHECK_EQ(1, stream.eos_signaled());
+  CHECK_LT(stream.size(), json_stream.size());
+  i::ScopedVector<char> data(stream.size());
+  stream.WriteTo(data);
+
+  BinarySnapshotReader reader(data);
+  CHECK_EQ(0, memcmp("V8HS", reader.ReadBytes(4).data(), 4));
+  CHECK_EQ(uint64_t{i::HeapSnapshotBinarySerializer::kVersion},
+           reader.ReadVarint());
+  uint64_t node_count = reader.ReadVarint();
+  uint64_t edge_count = reader.ReadVarint();
+  CHECK_EQ(static_cast<uint64_t>(snapshot->GetNodesCount()), node_count);
+  CHECK_EQ(const_cast<i::HeapSnapshot*>(heap_snapshot)->edges().size(),
+           edge_count);
+  CHECK_EQ(0u, reader.ReadVarint());  // No allocation tracking.
+
+  uint64_t max_string_id = 0;
+  uint64_t total_edge_count = 0;
+  for (uint64_t i = 0; i < node_count; i++) {
+    uint64_t type = reader.ReadVarint();
+    if (i == 0) CHECK_EQ(v8::HeapGraphNode::kSynthetic, type);
+    max_string_id = std::max(max_string_id, reader.ReadVarint());
+    reader.ReadVarint();  // id
+    reader.ReadVarint();  // self_size
+    total_edge_count += reader.ReadVarint();
+    reader.ReadVarint();  // trace_node_id
+  }
+  CHECK_EQ(edge_count, total_edge_count);
+  for (uint64_t i = 0; i < edge_count; i++) {
+    uint64_t type = reader.ReadVarint();
+    uint64_t name_or_index = reader.ReadVarint();
+    if (type != v8::HeapGraphEdge::kElement &&
+        type != v8::HeapGraphEdge::kHidden) {
+      max_string_id = std::max(max_string_id, name_or_index);
+    }
+    CHECK_LT(reader.ReadVarint(), node_count);
+  }
+  CHECK_EQ(0u, reader.ReadVarint());  // No trace tree.
+  uint64_t sample_count = reader.ReadVarint();
+  for (uint64_t i = 0; i < 2 * sample_count; i++) reader.ReadVarint();
+  uint64_t location_count = reader.ReadVarint();
+  CHECK_EQ(heap_snapshot->locations().size(), location_count);
+  for (uint64_t i = 0; i < location_count; i++) {
+    CHECK_LT(reader.ReadVarint(), node_count);
+    reader.ReadVarint();  // script_id
+    reader.ReadVarint();  // line
+    reader.ReadVarint();  // column
+  }
+  uint64_t string_count = reader.ReadVarint();
+  CHECK_LE(max_string_id, string_count);
+  bool found_string = false;
+  for (uint64_t i = 0; i < string_count; i++) {
+    std::string string = reader.ReadBytes(reader.ReadVarint());
+    if (string == "binary snapshot string") found_string = true;
+  }
+  CHECK(found_string);
+  CHECK(reader.AtEnd());
+}
+
+// The raw string and its JSON literal are also checked against
+// tools/heap-snapshot-to-json.py in tools/unittests, so that converting the
+// binary format yields the same bytes as serializing to JSON.
+TEST(HeapSnapshotSerializationStringEscaping) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+
+  CompileRun(
+      "var s = 'ctl\\x01\\x1f\\x7f \\xe9 \\u0800 \\ud83d\\ude00 "
+      "\\ufffd';");
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+
+  const char kRaw[] =
+      "ctl\x01\x1f\x7f \xC3\xA9 \xE0\xA0\x80 \xF0\x9F\x98\x80 "
+      "\xEF\xBF\xBD";
+  const char kLiteral[] =
+      "\"ctl\\u0001\\u001F\x7f \\u00E9 \\u0800 \\uF600 ???\"";
+
+  TestJSONStream json_stream;
+  snapshot->Serialize(&json_stream, v8::HeapSnapshot::kJSON);
+  i::ScopedVector<char> json(json_stream.size() + 1);
+  json_stream.WriteTo(json);
+  json[json_stream.size()] = '\0';
+  CHECK_NOT_NULL(strstr(json.begin(), kLiteral));
+
+  TestJSONStream binary_stream;
+  snapshot->Serialize(&binary_stream, v8::HeapSnapshot::kBinary);
+  i::ScopedVector<char> data(binary_stream.size());
+  binary_stream.WriteTo(data);
+  std::string binary(data.begin(), data.length());
+  CHECK_NE(std::string::npos, binary.find(kRaw));
+}
+
 namespace {
 
 class TestStatsStream : public v8::OutputStream {
@@ -1642,6 +1642,49 @@ TEST(CodeSerializerOnePlusOne4K) {
   TestCodeSerializerOnePlusOneImpl();
 }
 
+TEST(CodeSerializerOptimizationHints) {
+  LocalContext context;
+  Isolate* isolate = CcTest::i_isolate();
+  isolate->compilation_cache()
+      ->DisableScriptAndEval();  // Disable same-isolate code cache.
+
+  v8::HandleScope scope(CcTest::isolate());
+
+  const char* source = "1 + 1";
+
+  Handle<String> orig_source = isolate->factory()
+                                   ->NewStringFromUtf8(CStrVector(source))
+                                   .ToHandleChecked();
+  Handle<String> copy_source = isolate->factory()
+                                   ->NewStringFromUtf8(CStrVector(source))
+                                   .ToHandleChecked();
+
+  Handle<SharedFunctionInfo> orig =
+      CompileScript(isolate, orig_source, Handle<String>(), nullptr,
+                    v8::ScriptCompiler::kNoCompileOptions);
+  CHECK(!orig->GetBytecodeArray().was_optimized());
+  // Pretend that TurboFan code was installed for the script.
+  orig->GetBytecodeArray().set_was_optimized(true);
+
+  std::unique_ptr<ScriptCompiler::CachedData> cached_data(
+      ScriptCompiler::CreateCodeCache(ToApiHandle<UnboundScript>(orig)));
+  uint8_t* buffer = NewArray<uint8_t>(cached_data->length);
+  MemCopy(buffer, cached_data->data, cached_data->length);
+  ScriptData* cache = new i::ScriptData(buffer, cached_data->length);
+  cache->AcquireDataOwnership();
+
+  Handle<SharedFunctionInfo> copy;
+  {
+    DisallowCompilation no_compile_expected(isolate);
+    copy = CompileScript(isolate, copy_source, Handle<String>(), cache,
+                         v8::ScriptCompiler::kConsumeCodeCache);
+  }
+  CHECK_NE(*orig, *copy);
+  CHECK(copy->GetBytecodeArray().was_optimized());
+
+  delete cache;
+}
+
 TEST(CodeSerializerPromotedToCompilationCache) {
   LocalContext context;
   Isolate* isolate = CcTest::i_isolate();
@@ -2424,6 +2467,110 @@ TEST(CodeSerializerAfterExecute) {
   FLAG_always_opt = prev_always_opt_value;
 }
 
+static Handle<JSFunction> GetGlobalFunction(v8::Local<v8::Context> context,
+                                             const char* name) {
+  return Handle<JSFunction>::cast(v8::Utils::OpenHandle(
+      *context->Global()->Get(context, v8_str(name)).ToLocalChecked()));
+}
+
+TEST(CodeSerializerOptimizationHintsAfterWarmUp) {
+  FLAG_always_opt = false;
+  FLAG_allow_natives_syntax = true;
+  FLAG_concurrent_recompilation = false;
+  FLAG_lazy_feedback_allocation = false;
+  if (!FLAG_opt || FLAG_lite_mode) return;
+
+  // f and g are identical and too large to be optimized as small functions.
+  // Only f gets optimized before the cache is created.
+  const char* source =
+      "function f(a) {"
+      "  let x = a;"
+      "  x = x * 2 + 1; x = x * 2 + 1; x = x * 2 + 1; x = x * 2 + 1;"
+      "  x = x * 2 + 1; x = x * 2 + 1; x = x * 2 + 1; x = x * 2 + 1;"
+      "  x = x * 2 + 1; x = x * 2 + 1; x = x * 2 + 1; x = x * 2 + 1;"
+      "  return x;"
+      "}"
+      "function g(a) {"
+      "  let x = a;"
+      "  x = x * 2 + 1; x = x * 2 + 1; x = x * 2 + 1; x = x * 2 + 1;"
+      "  x = x * 2 + 1; x = x * 2 + 1; x = x * 2 + 1; x = x * 2 + 1;"
+      "  x = x * 2 + 1; x = x * 2 + 1; x = x * 2 + 1; x = x * 2 + 1;"
+      "  return x;"
+      "}"
+      "f(1) + g(1)";
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+
+  v8::ScriptCompiler::CachedData* cache;
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source_with_origin(v8_str(source), origin);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(isolate1, &source_with_origin)
+            .ToLocalChecked();
+    script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CompileRun(
+        "%PrepareFunctionForOptimization(f);"
+        "f(1);"
+        "%OptimizeFunctionOnNextCall(f);"
+        "f(1);");
+    CHECK(GetGlobalFunction(context, "f")->HasOptimizedCode());
+    CHECK(!GetGlobalFunction(context, "g")->HasOptimizedCode());
+
+    cache = ScriptCompiler::CreateCodeCache(script);
+  }
+  isolate1->Dispose();
+
+  // Every return from a function ticks the runtime profiler in the new
+  // isolate, so that the number of calls determines the number of ticks.
+  FLAG_code_cache_optimization_hints = true;
+  FLAG_interrupt_budget = 1;
+
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source_with_origin(v8_str(source), origin,
+                                                  cache);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate2, &source_with_origin,
+            v8::ScriptCompiler::kConsumeCodeCache)
+            .ToLocalChecked();
+    CHECK(!cache->rejected);
+    script->BindToCurrentContext()->Run(context).ToLocalChecked();
+
+    Handle<JSFunction> f = GetGlobalFunction(context, "f");
+    Handle<JSFunction> g = GetGlobalFunction(context, "g");
+    CHECK(f->shared().GetBytecodeArray().was_optimized());
+    CHECK(!g->shared().GetBytecodeArray().was_optimized());
+
+    // f needs fewer ticks than the regular heuristics require for g.
+    for (int i = 0; i < 4 && !f->IsMarkedForOptimization(); i++) {
+      CompileRun("f(1) + g(1)");
+    }
+    CHECK(f->IsMarkedForOptimization());
+    CHECK(!g->IsMarkedForOptimization());
+    CHECK(!g->HasOptimizedCode());
+
+    CHECK_EQ(8191, CompileRun("f(1)")->Int32Value(context).FromJust());
+    CHECK(f->HasOptimizedCode());
+  }
+  isolate2->Dispose();
+  delete cache;
+}
+
 TEST(CodeSerializerFlagChange) {
   const char* source = "function f() { return 'abc'; }; f() + 'def'";
   v8::ScriptCompiler::CachedData* cache = CompileRunAndProduceCache(source);
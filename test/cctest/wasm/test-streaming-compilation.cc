@@ -19,6 +19,7 @@
 
 #include "test/cctest/cctest.h"
 
+#include "test/common/wasm/flag-utils.h"
 #include "test/common/wasm/test-signatures.h"
 #include "test/common/wasm/wasm-macro-gen.h"
 
@@ -43,6 +44,7 @@ class MockPlatform final : public TestPlatform {
   }
 
   void CallOnWorkerThread(std::unique_ptr<v8::Task> task) override {
+    ++num_worker_tasks_;
     task_runner_->PostTask(std::move(task));
   }
 
@@ -50,6 +52,8 @@ class MockPlatform final : public TestPlatform {
 
   void ExecuteTasks() { task_runner_->ExecuteTasks(); }
 
+  int num_worker_tasks() const { return num_worker_tasks_; }
+
  private:
   class MockTaskRunner final : public TaskRunner {
    public:
@@ -82,6 +86,7 @@ class MockPlatform final : public TestPlatform {
   };
 
   std::shared_ptr<MockTaskRunner> task_runner_;
+  int num_worker_tasks_ = 0;
 };
 
 namespace {
@@ -1221,6 +1226,48 @@ STREAM_TEST(TestCompileErrorFunctionName) {
 
 #undef STREAM_TEST
 
+// Test that synchronous compilation rejects a module with an invalid lazy
+// function before it schedules any compilation.
+TEST(TestSyncCompileInvalidLazyFunction) {
+  MockPlatform platform;
+  CcTest::InitializeVM();
+  FlagScope<bool> lazy_compilation(&FLAG_wasm_lazy_compilation, true);
+  FlagScope<bool> no_lazy_validation(&FLAG_wasm_lazy_validation, false);
+  // Validate on the main thread only, such that any worker task would be a
+  // compile task.
+  FlagScope<int> num_compilation_tasks(&FLAG_wasm_num_compilation_tasks, 0);
+  i::Isolate* isolate = CcTest::i_isolate();
+  HandleScope scope(isolate);
+  AccountingAllocator allocator;
+  Zone zone(&allocator, ZONE_NAME);
+  ZoneBuffer buffer(&zone);
+  TestSignatures sigs;
+  WasmModuleBuilder builder(&zone);
+  {
+    // The export needs a wrapper, which would be compiled eagerly.
+    WasmFunctionBuilder* f = builder.AddFunction(sigs.i_v());
+    f->builder()->AddExport(CStrVector("main"), f);
+    uint8_t code[] = {WASM_I32V_1(23), kExprEnd};
+    f->EmitCode(code, arraysize(code));
+  }
+  {
+    WasmFunctionBuilder* f = builder.AddFunction(sigs.i_v());
+    uint8_t code[] = {kExprNop, kExprEnd};
+    f->EmitCode(code, arraysize(code));
+  }
+  builder.WriteTo(&buffer);
+
+  int num_worker_tasks = platform.num_worker_tasks();
+  ErrorThrower thrower(isolate, "TestSyncCompileInvalidLazyFunction");
+  CHECK(isolate->wasm_engine()
+            ->SyncCompile(isolate, WasmFeatures::All(), &thrower,
+                          ModuleWireBytes(buffer.begin(), buffer.end()))
+            .is_null());
+  CHECK(thrower.error());
+  thrower.Reset();
+  CHECK_EQ(num_worker_tasks, platform.num_worker_tasks());
+}
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8
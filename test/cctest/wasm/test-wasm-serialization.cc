@@ -15,6 +15,7 @@
 #include "src/wasm/wasm-module.h"
 #include "src/wasm/wasm-objects-inl.h"
 #include "src/wasm/wasm-opcodes.h"
+#include "src/wasm/wasm-serialization.h"
 
 #include "test/cctest/cctest.h"
 #include "test/common/wasm/flag-utils.h"
@@ -92,7 +93,6 @@ class WasmSerializationTest {
   }
 
   void DeserializeAndRun() {
-    ErrorThrower thrower(current_isolate(), "");
     v8::Local<v8::WasmModuleObject> deserialized_module;
     CHECK(Deserialize().ToLocal(&deserialized_module));
     Handle<WasmModuleObject> module_object = Handle<WasmModuleObject>::cast(
@@ -106,6 +106,11 @@ class WasmSerializationTest {
                       wire_bytes_.data(), wire_bytes_.size()),
                0);
     }
+    Run(module_object);
+  }
+
+  void Run(Handle<WasmModuleObject> module_object) {
+    ErrorThrower thrower(current_isolate(), "");
     Handle<WasmInstanceObject> instance =
         current_isolate()
             ->wasm_engine()
@@ -210,6 +215,82 @@ TEST(DeserializeValidModule) {
   Cleanup();
 }
 
+TEST(DeserializeLazily) {
+  FlagScope<bool> lazy_deserialization(&FLAG_wasm_lazy_deserialization, true);
+  WasmSerializationTest test;
+  {
+    HandleScope scope(test.current_isolate());
+    v8::Local<v8::WasmModuleObject> deserialized_module;
+    CHECK(test.Deserialize().ToLocal(&deserialized_module));
+    Handle<WasmModuleObject> module_object = Handle<WasmModuleObject>::cast(
+        v8::Utils::OpenHandle(*deserialized_module));
+    NativeModule* native_module = module_object->native_module();
+    CHECK_NOT_NULL(native_module->lazily_deserialized_code());
+    // The function is only materialized when it is first called.
+    CHECK(!native_module->HasCode(0));
+    test.Run(module_object);
+    CHECK(native_module->HasCode(0));
+  }
+  Cleanup(test.current_isolate());
+  Cleanup();
+}
+
+namespace {
+class SerializerThread : public base::Thread {
+ public:
+  explicit SerializerThread(NativeModule* native_module)
+      : Thread(Options("SerializerThread")), native_module_(native_module) {}
+
+  void Run() override {
+    WasmSerializer serializer(native_module_);
+    bytes_ = OwnedVector<byte>::New(serializer.GetSerializedNativeModuleSize());
+    CHECK(serializer.SerializeNativeModule(bytes_.as_vector()));
+  }
+
+  Vector<const byte> bytes() const { return bytes_.as_vector(); }
+
+ private:
+  NativeModule* const native_module_;
+  OwnedVector<byte> bytes_;
+};
+}  // namespace
+
+TEST(SerializeLazilyDeserializedModuleConcurrently) {
+  FlagScope<bool> lazy_deserialization(&FLAG_wasm_lazy_deserialization, true);
+  WasmSerializationTest test;
+  {
+    HandleScope scope(test.current_isolate());
+    v8::Local<v8::WasmModuleObject> deserialized_module;
+    CHECK(test.Deserialize().ToLocal(&deserialized_module));
+    Handle<WasmModuleObject> module_object = Handle<WasmModuleObject>::cast(
+        v8::Utils::OpenHandle(*deserialized_module));
+    NativeModule* native_module = module_object->native_module();
+    CHECK(!native_module->HasCode(0));
+
+    // The serializer materializes the function on a background thread while
+    // the main thread calls it for the first time.
+    SerializerThread thread(native_module);
+    CHECK(thread.Start());
+    test.Run(module_object);
+    thread.Join();
+    CHECK(native_module->HasCode(0));
+    // Materializing the last function released the serialized data.
+    CHECK(native_module->lazily_deserialized_code()->data.empty());
+
+    // The snapshot taken by the serializer is complete.
+    FlagScope<bool> eager_deserialization(&FLAG_wasm_lazy_deserialization,
+                                          false);
+    Handle<WasmModuleObject> reserialized_module =
+        DeserializeNativeModule(test.current_isolate(), thread.bytes(),
+                                native_module->wire_bytes())
+            .ToHandleChecked();
+    CHECK(reserialized_module->native_module()->HasCode(0));
+    test.Run(reserialized_module);
+  }
+  Cleanup(test.current_isolate());
+  Cleanup();
+}
+
 TEST(DeserializeMismatchingVersion) {
   WasmSerializationTest test;
   {
@@ -2,7 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstdio>
 #include <memory>
+#include <string>
 
 #include "src/execution/microtask-queue.h"
 #include "src/objects/objects-inl.h"
@@ -13,6 +15,7 @@
 #include "src/wasm/wasm-objects-inl.h"
 
 #include "test/cctest/cctest.h"
+#include "test/common/wasm/flag-utils.h"
 #include "test/common/wasm/test-signatures.h"
 #include "test/common/wasm/wasm-macro-gen.h"
 #include "test/common/wasm/wasm-module-runner.h"
@@ -129,6 +132,13 @@ class SharedEngineThread : public v8::base::Thread {
 
 namespace {
 
+void OverwriteFile(const std::string& file_name, const std::string& contents) {
+  FILE* file = base::OS::FOpen(file_name.c_str(), "wb");
+  CHECK_NOT_NULL(file);
+  CHECK_EQ(contents.size(), fwrite(contents.data(), 1, contents.size(), file));
+  fclose(file);
+}
+
 ZoneBuffer* BuildReturnConstantModule(Zone* zone, int constant) {
   TestSignatures sigs;
   ZoneBuffer* buffer = new (zone) ZoneBuffer(zone);
@@ -199,6 +209,32 @@ Handle<WasmInstanceObject> CompileAndInstantiateAsync(
   return instance;
 }
 
+// Compiles a module returning {constant} with a fresh engine and waits until
+// it was written to --wasm-code-cache-dir. Returns the name and contents of
+// the cache file.
+std::string CompileIntoCodeCacheDir(int constant, std::string* file_name) {
+  SharedEngine engine;
+  SharedEngineIsolate isolate(&engine);
+  HandleScope scope(isolate.isolate());
+  ZoneBuffer* buffer = BuildReturnConstantModule(isolate.zone(), constant);
+  *file_name = WasmEngine::GetCodeCacheFileName(
+      VectorOf(buffer->begin(), buffer->size()));
+  std::remove(file_name->c_str());
+  Handle<WasmInstanceObject> instance = isolate.CompileAndInstantiate(buffer);
+  CHECK_EQ(constant, isolate.Run(instance));
+
+  // The cache file is written on a background thread once compilation
+  // finished.
+  std::string contents;
+  bool exists = false;
+  for (int i = 0; i < 1000 && !exists; ++i) {
+    contents = ReadFile(file_name->c_str(), &exists, false);
+    if (!exists) base::OS::Sleep(base::TimeDelta::FromMilliseconds(10));
+  }
+  CHECK(exists);
+  return contents;
+}
+
 }  // namespace
 
 TEST(SharedEngineUseCount) {
@@ -255,6 +291,106 @@ TEST(SharedEngineRunImported) {
   }
 }
 
+TEST(SharedEngineCachedModule) {
+  FlagScope<bool> native_module_cache(&FLAG_wasm_native_module_cache, true);
+  SharedEngine engine;
+  SharedModule module;
+  {
+    SharedEngineIsolate isolate(&engine);
+    HandleScope scope(isolate.isolate());
+    ZoneBuffer* buffer = BuildReturnConstantModule(isolate.zone(), 23);
+    Handle<WasmInstanceObject> instance = isolate.CompileAndInstantiate(buffer);
+    module = isolate.ExportInstance(instance);
+    CHECK_EQ(23, isolate.Run(instance));
+  }
+  {
+    // Compiling the same bytes again reuses the module.
+    SharedEngineIsolate isolate(&engine);
+    HandleScope scope(isolate.isolate());
+    ZoneBuffer* buffer = BuildReturnConstantModule(isolate.zone(), 23);
+    Handle<WasmInstanceObject> instance = isolate.CompileAndInstantiate(buffer);
+    CHECK_EQ(module.get(), isolate.ExportInstance(instance).get());
+    CHECK_EQ(23, isolate.Run(instance));
+
+    // Different bytes result in a different module.
+    buffer = BuildReturnConstantModule(isolate.zone(), 42);
+    instance = isolate.CompileAndInstantiate(buffer);
+    CHECK_NE(module.get(), isolate.ExportInstance(instance).get());
+    CHECK_EQ(42, isolate.Run(instance));
+  }
+}
+
+TEST(SharedEngineCodeCacheDir) {
+  FlagScope<const char*> code_cache_dir(&FLAG_wasm_code_cache_dir, ".");
+  FlagScope<bool> no_dynamic_tiering(&FLAG_wasm_dynamic_tiering, false);
+  std::string file_name;
+  std::string contents = CompileIntoCodeCacheDir(23, &file_name);
+  {
+    // A fresh engine and isolate load the module from the file.
+    SharedEngine engine;
+    SharedEngineIsolate isolate(&engine);
+    HandleScope scope(isolate.isolate());
+    ZoneBuffer* buffer = BuildReturnConstantModule(isolate.zone(), 23);
+    ModuleWireBytes wire_bytes(buffer->begin(), buffer->end());
+    WasmFeatures enabled = WasmFeatures::FromIsolate(isolate.isolate());
+    Handle<WasmModuleObject> module_object =
+        engine.engine()
+            ->MaybeGetCachedModule(isolate.isolate(), enabled, wire_bytes)
+            .ToHandleChecked();
+    Handle<WasmInstanceObject> instance =
+        isolate.ImportInstance(module_object->shared_native_module());
+    CHECK_EQ(23, isolate.Run(instance));
+
+    // A file whose serialized code does not match its checksum is rejected.
+    std::string tampered = contents;
+    tampered[tampered.size() - 1] ^= 0xFF;
+    OverwriteFile(file_name, tampered);
+    CHECK(engine.engine()
+              ->MaybeGetCachedModule(isolate.isolate(), enabled, wire_bytes)
+              .is_null());
+
+    // So is a file that holds different wire bytes.
+    tampered = contents;
+    tampered[sizeof(uint64_t)] ^= 0xFF;
+    OverwriteFile(file_name, tampered);
+    CHECK(engine.engine()
+              ->MaybeGetCachedModule(isolate.isolate(), enabled, wire_bytes)
+              .is_null());
+  }
+  std::remove(file_name.c_str());
+}
+
+TEST(SharedEngineCodeCacheDirAsync) {
+  FlagScope<const char*> code_cache_dir(&FLAG_wasm_code_cache_dir, ".");
+  FlagScope<bool> no_dynamic_tiering(&FLAG_wasm_dynamic_tiering, false);
+  // Only modules loaded from the cache have lazily deserialized code.
+  FlagScope<bool> lazy_deserialization(&FLAG_wasm_lazy_deserialization, true);
+  std::string file_name;
+  std::string contents = CompileIntoCodeCacheDir(23, &file_name);
+  for (bool streaming : {false, true}) {
+    FlagScope<bool> test_streaming(&FLAG_wasm_test_streaming, streaming);
+    OverwriteFile(file_name, contents);
+    SharedEngine engine;
+    SharedEngineIsolate isolate(&engine);
+    HandleScope scope(isolate.isolate());
+    ZoneBuffer* buffer = BuildReturnConstantModule(isolate.zone(), 23);
+    Handle<WasmInstanceObject> instance =
+        CompileAndInstantiateAsync(&isolate, buffer);
+    CHECK_NOT_NULL(
+        isolate.ExportInstance(instance)->lazily_deserialized_code());
+    CHECK_EQ(23, isolate.Run(instance));
+
+    // With a corrupted file, the module is compiled instead.
+    std::string tampered = contents;
+    tampered[tampered.size() - 1] ^= 0xFF;
+    OverwriteFile(file_name, tampered);
+    instance = CompileAndInstantiateAsync(&isolate, buffer);
+    CHECK_NULL(isolate.ExportInstance(instance)->lazily_deserialized_code());
+    CHECK_EQ(23, isolate.Run(instance));
+  }
+  std::remove(file_name.c_str());
+}
+
 TEST(SharedEngineRunThreadedBuildingSync) {
   SharedEngine engine;
   SharedEngineThread thread1(&engine, [](SharedEngineIsolate* isolate) {
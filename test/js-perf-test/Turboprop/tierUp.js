@@ -0,0 +1,46 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Every run compiles fresh kernels, so the scores reflect how quickly code
+// moves from the interpreter to optimized code rather than the peak
+// performance of the optimized code.
+
+let kernelId = 0;
+
+function NewKernel() {
+  // The unique comment defeats the compilation cache.
+  return new Function('n', `// kernel ${kernelId++}
+    let sum = 0;
+    for (let i = 0; i < n; i++) {
+      sum = (sum + ((i * 3) ^ (sum >>> 1))) | 0;
+    }
+    return sum;`);
+}
+
+function ShortRunning() {
+  const kernel = NewKernel();
+  let result = 0;
+  for (let i = 0; i < 200; i++) result ^= kernel(100);
+  return result;
+}
+
+function LongRunning() {
+  const kernel = NewKernel();
+  let result = 0;
+  for (let i = 0; i < 2000; i++) result ^= kernel(1000);
+  return result;
+}
+
+function ManyFunctions() {
+  let result = 0;
+  for (let k = 0; k < 20; k++) {
+    const kernel = NewKernel();
+    for (let i = 0; i < 50; i++) result ^= kernel(100);
+  }
+  return result;
+}
+
+createSuite('ShortRunning', 1000, ShortRunning);
+createSuite('LongRunning', 1000, LongRunning);
+createSuite('ManyFunctions', 1000, ManyFunctions);
@@ -0,0 +1,35 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --expose-gc --no-always-opt
+// Flags: --concurrent-recompilation --block-concurrent-recompilation
+// Flags: --turbo-direct-heap-access --stress-compaction
+
+if (!%IsConcurrentRecompilationSupported()) {
+  print("Concurrent recompilation is disabled. Skipping this test.");
+  quit();
+}
+
+// Literal boilerplates and the closure's ScopeInfo are read directly from
+// the heap by the background thread, while the GCs below move objects.
+function f(x) {
+  const o = {a: x, b: [1, 2, 3]};
+  const g = () => o.a + o.b[1];
+  return g();
+}
+
+%PrepareFunctionForOptimization(f);
+assertEquals(3, f(1));
+assertEquals(4, f(2));
+
+%OptimizeFunctionOnNextCall(f, "concurrent");
+assertEquals(5, f(3));
+assertUnoptimized(f, "no sync");
+
+%UnblockConcurrentRecompilation();
+// GCs have to stop the compiler thread in a safepoint or run while it is
+// parked in register allocation.
+for (let i = 0; i < 10; i++) gc();
+assertOptimized(f, "sync");
+assertEquals(6, f(4));
@@ -0,0 +1,81 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-loop-bounds-check-elimination
+
+// The bounds check is guarded by the loop condition.
+(function() {
+  function sum(a) {
+    let result = 0;
+    for (let i = 0; i < a.length; i++) result += a[i];
+    return result;
+  }
+
+  const a = new Int32Array([1, 2, 3, 4]);
+  %PrepareFunctionForOptimization(sum);
+  assertEquals(10, sum(a));
+  assertEquals(10, sum(a));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(10, sum(a));
+  assertEquals(0, sum(new Int32Array(0)));
+  assertEquals(6, sum(new Int32Array([6])));
+})();
+
+// A non-strict comparison does not prove the last access in bounds.
+(function() {
+  function count(a) {
+    let result = 0;
+    for (let i = 0; i <= a.length; i++) {
+      if (a[i] === undefined) result++;
+    }
+    return result;
+  }
+
+  const a = new Float64Array(3);
+  %PrepareFunctionForOptimization(count);
+  assertEquals(1, count(a));
+  assertEquals(1, count(a));
+  %OptimizeFunctionOnNextCall(count);
+  assertEquals(1, count(a));
+})();
+
+// A bound on another array does not prove the access in bounds.
+(function() {
+  function copy(a, b) {
+    let result = 0;
+    for (let i = 0; i < a.length; i++) {
+      if (b[i] === undefined) result++;
+    }
+    return result;
+  }
+
+  const a = new Uint8Array(8);
+  const b = new Uint8Array(4);
+  %PrepareFunctionForOptimization(copy);
+  assertEquals(0, copy(b, a));
+  assertEquals(4, copy(a, b));
+  %OptimizeFunctionOnNextCall(copy);
+  assertEquals(4, copy(a, b));
+})();
+
+// Detaching the buffer in the loop shrinks the length seen by the condition.
+(function() {
+  function sum(a, detach) {
+    let result = 0;
+    for (let i = 0; i < a.length; i++) {
+      if (i === 2) detach(a);
+      result += a[i] | 0;
+    }
+    return result;
+  }
+
+  function nop() {}
+  function detach(a) { %ArrayBufferDetach(a.buffer); }
+
+  %PrepareFunctionForOptimization(sum);
+  assertEquals(10, sum(new Int32Array([1, 2, 3, 4]), nop));
+  assertEquals(10, sum(new Int32Array([1, 2, 3, 4]), nop));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(3, sum(new Int32Array([1, 2, 3, 4]), detach));
+})();
@@ -149,3 +149,26 @@ for (let constructor of constructorsWithArrays) {
   assertArrayLikeEquals(array, constructor.array.reverse(), constructor.ctor);
   assertEquals(array.length, constructor.array.length);
 }
+
+// Integer arrays long enough to be sorted without comparisons. Include the
+// extreme values of each type and values that only differ in their upper
+// bytes.
+for (let constructor of constructorsWithArrays) {
+  if (constructor.ctor === Float32Array || constructor.ctor === Float64Array ||
+      constructor.ctor === BigInt64Array ||
+      constructor.ctor === BigUint64Array) {
+    continue;
+  }
+  const kSize = 1000;
+  let values = [];
+  for (let i = 0; i < kSize; ++i) {
+    values.push(constructor.array[i % constructor.array.length]);
+    values.push((i * 0x9E3779B1) | 0);
+    values.push(i << 20);
+  }
+  let array = new constructor.ctor(values);
+  let expected = Array.from(array).sort(cmpfn);
+
+  assertEquals(array.sort(), array);
+  assertArrayLikeEquals(array, expected, constructor.ctor);
+}
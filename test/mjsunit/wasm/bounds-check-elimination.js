@@ -0,0 +1,87 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --no-wasm-trap-handler
+// Flags: --wasm-bounds-check-elimination --liftoff --no-wasm-tier-up
+
+load("test/mjsunit/wasm/wasm-module-builder.js");
+
+const kMemSize = 0x10000;
+
+const builder = new WasmModuleBuilder();
+builder.addMemory(1, undefined, false);
+// The check of the first load covers the two following ones.
+builder.addFunction('largest_first', kSig_i_i)
+    .addBody([
+      kExprLocalGet, 0,
+      kExprI32LoadMem, 0, 8,
+      kExprLocalGet, 0,
+      kExprI32LoadMem, 0, 0,
+      kExprI32Add,
+      kExprLocalGet, 0,
+      kExprI32LoadMem, 0, 4,
+      kExprI32Add])
+    .exportFunc();
+// The check of the first load does not cover the second one.
+builder.addFunction('smallest_first', kSig_i_i)
+    .addBody([
+      kExprLocalGet, 0,
+      kExprI32LoadMem, 0, 0,
+      kExprLocalGet, 0,
+      kExprI32LoadMem, 0, 8,
+      kExprI32Add])
+    .exportFunc();
+// A check in a conditional block does not cover the code after it.
+builder.addFunction('conditional', kSig_i_ii)
+    .addBody([
+      kExprLocalGet, 1,
+      kExprIf, kWasmStmt,
+        kExprLocalGet, 0,
+        kExprI32LoadMem, 0, 8,
+        kExprDrop,
+      kExprEnd,
+      kExprLocalGet, 0,
+      kExprI32LoadMem, 0, 4])
+    .exportFunc();
+
+// Writing the checked local invalidates its check.
+builder.addFunction('reassigned', kSig_i_ii)
+    .addBody([
+      kExprLocalGet, 0,
+      kExprI32LoadMem, 0, 8,
+      kExprDrop,
+      kExprLocalGet, 1,
+      kExprLocalSet, 0,
+      kExprLocalGet, 0,
+      kExprI32LoadMem, 0, 4])
+    .exportFunc();
+
+const instance = builder.instantiate();
+const exports = instance.exports;
+
+function checkAll() {
+  assertEquals(0, exports.largest_first(kMemSize - 12));
+  assertTraps(kTrapMemOutOfBounds, () => exports.largest_first(kMemSize - 11));
+  assertTraps(kTrapMemOutOfBounds, () => exports.largest_first(-1));
+
+  assertEquals(0, exports.smallest_first(kMemSize - 12));
+  assertTraps(
+      kTrapMemOutOfBounds, () => exports.smallest_first(kMemSize - 11));
+  assertTraps(kTrapMemOutOfBounds, () => exports.smallest_first(kMemSize - 4));
+
+  assertEquals(0, exports.conditional(kMemSize - 12, 1));
+  assertEquals(0, exports.conditional(kMemSize - 8, 0));
+  assertTraps(kTrapMemOutOfBounds, () => exports.conditional(kMemSize - 8, 1));
+  assertTraps(kTrapMemOutOfBounds, () => exports.conditional(kMemSize - 4, 0));
+
+  assertEquals(0, exports.reassigned(kMemSize - 12, kMemSize - 8));
+  assertTraps(
+      kTrapMemOutOfBounds,
+      () => exports.reassigned(kMemSize - 12, kMemSize - 4));
+}
+
+// Liftoff code first, then TurboFan code.
+checkAll();
+for (let i = 0; i < 4; ++i) %WasmTierUpFunction(instance, i);
+checkAll();
@@ -0,0 +1,77 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --liftoff --wasm-tier-up
+// Flags: --wasm-dynamic-tiering --wasm-tiering-budget=100
+// Flags: --experimental-wasm-compilation-hints
+
+load('test/mjsunit/wasm/wasm-module-builder.js');
+
+function create_instance() {
+  const builder = new WasmModuleBuilder();
+  // Sums up the numbers from 1 to the parameter.
+  builder.addFunction('sum', kSig_i_i)
+      .addLocals({i32_count: 1})
+      .addBody([
+        kExprLoop, kWasmStmt,
+          kExprLocalGet, 1, kExprLocalGet, 0, kExprI32Add, kExprLocalSet, 1,
+          kExprLocalGet, 0, kExprI32Const, 1, kExprI32Sub, kExprLocalTee, 0,
+          kExprBrIf, 0,
+        kExprEnd,
+        kExprLocalGet, 1
+      ])
+      .exportFunc();
+  builder.addFunction('cold', kSig_i_v)
+      .addBody(wasmI32Const(23))
+      .exportFunc();
+  return builder.instantiate();
+}
+
+async function waitForTierUp(fn) {
+  while (%IsLiftoffFunction(fn)) {
+    await new Promise(resolve => setTimeout(resolve, 0));
+  }
+}
+
+(function testColdFunctionsStayInLiftoff() {
+  print(arguments.callee.name);
+  const instance = create_instance();
+  assertEquals(23, instance.exports.cold());
+  assertEquals(15, instance.exports.sum(5));
+  assertTrue(%IsLiftoffFunction(instance.exports.cold));
+  assertTrue(%IsLiftoffFunction(instance.exports.sum));
+})();
+
+async function testHotLoopTriggersTierUp() {
+  print(arguments.callee.name);
+  const instance = create_instance();
+  assertEquals(5050, instance.exports.sum(100));
+  assertEquals(5050, instance.exports.sum(100));
+  await waitForTierUp(instance.exports.sum);
+  assertEquals(5050, instance.exports.sum(100));
+  assertTrue(%IsLiftoffFunction(instance.exports.cold));
+}
+
+assertPromiseResult(testHotLoopTriggersTierUp());
+
+async function testEagerTopTierHintIsDelayed() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  builder.addFunction('id', kSig_i_i)
+      .addBody([kExprLocalGet, 0])
+      .setCompilationHint(kCompilationHintStrategyLazyBaselineEagerTopTier,
+                          kCompilationHintTierBaseline,
+                          kCompilationHintTierOptimized)
+      .exportFunc();
+  const instance = builder.instantiate();
+  assertEquals(42, instance.exports.id(42));
+  // No top tier unit is queued upfront, so the cold function stays in Liftoff
+  // even after the background compile tasks had time to run.
+  for (let i = 0; i < 10; i++) {
+    await new Promise(resolve => setTimeout(resolve, 0));
+  }
+  assertTrue(%IsLiftoffFunction(instance.exports.id));
+}
+
+assertPromiseResult(testEagerTopTierHintIsDelayed());
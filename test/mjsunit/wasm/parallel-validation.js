@@ -0,0 +1,61 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --wasm-lazy-compilation --wasm-num-compilation-tasks=4
+
+load('test/mjsunit/wasm/wasm-module-builder.js');
+
+// Function bodies are validated by several tasks before lazy compilation;
+// the reported error must still be the one of the first invalid function.
+function buildModule(bad_functions) {
+  const builder = new WasmModuleBuilder();
+  const sig = builder.addType(kSig_i_v);
+  for (let i = 0; i < 500; ++i) {
+    if (bad_functions.includes(i)) {
+      builder.addFunction('bad' + i, sig).addBody([]);
+    } else {
+      builder.addFunction('f' + i, sig).addBody([kExprI32Const, 42])
+          .exportFunc();
+    }
+  }
+  return builder.toBuffer();
+}
+
+(function testValidModule() {
+  print(arguments.callee.name);
+  const instance = new WebAssembly.Instance(
+      new WebAssembly.Module(buildModule([])));
+  assertEquals(42, instance.exports.f0());
+  assertEquals(42, instance.exports.f499());
+})();
+
+(function testFirstErrorIsReported() {
+  print(arguments.callee.name);
+  const buffer = buildModule([499, 300, 100]);
+  for (let i = 0; i < 5; ++i) {
+    assertThrows(
+        () => new WebAssembly.Module(buffer), WebAssembly.CompileError,
+        /Compiling function #100:"bad100" failed/);
+  }
+})();
+
+function compileError(buffer) {
+  return WebAssembly.compile(buffer).then(
+      () => assertUnreachable(), error => {
+        assertInstanceof(error, WebAssembly.CompileError);
+        return error.message;
+      });
+}
+
+(function testFirstErrorIsReportedAsync() {
+  print(arguments.callee.name);
+  // Function #100 starts at the same offset in both modules, so all compiles
+  // report the same error if its error is the one that is kept.
+  const promises = [compileError(buildModule([100]))];
+  const buffer = buildModule([499, 300, 100]);
+  for (let i = 0; i < 5; ++i) promises.push(compileError(buffer));
+  assertPromiseResult(Promise.all(promises), messages => {
+    for (const message of messages) assertEquals(messages[0], message);
+  });
+})();
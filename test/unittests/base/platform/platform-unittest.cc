@@ -20,6 +20,16 @@ TEST(OS, GetCurrentProcessId) {
 #endif
 }
 
+TEST(OS, GetCurrentNumaNode) {
+  int node = OS::GetCurrentNumaNode();
+  EXPECT_TRUE(node == OS::kNoNumaNode || node >= 0);
+}
+
+TEST(OS, SetNumaPreferredNodeRejectsInvalidNode) {
+  char buffer[16];
+  EXPECT_FALSE(OS::SetNumaPreferredNode(buffer, sizeof(buffer), -1));
+}
+
 
 namespace {
 
@@ -123,6 +123,42 @@ TEST_P(RegionAllocatorTest, AllocateRegionRandom) {
   CHECK_EQ(ra.AllocateRegion(kPageSize), RegionAllocator::kAllocationFailure);
 }
 
+TEST(RegionAllocatorTest, AllocateAlignedRegion) {
+  const size_t kPageSize = 4 * KB;
+  const size_t kAlignment = 8 * kPageSize;
+  const size_t kPageCount = 64;
+  const size_t kSize = kPageSize * kPageCount;
+  // Deliberately misaligned start of the whole region.
+  const Address kBegin = static_cast<Address>(kAlignment * 153 + kPageSize);
+
+  RegionAllocator ra(kBegin, kSize, kPageSize);
+
+  // The region is carved out at the first aligned address.
+  Address first = ra.AllocateAlignedRegion(kPageSize, kAlignment);
+  CHECK_EQ(first, RoundUp(kBegin, kAlignment));
+  CHECK_EQ(ra.free_size(), kSize - kPageSize);
+
+  // The pages in front of the aligned region remain available.
+  CHECK_EQ(ra.AllocateRegion(kPageSize), kBegin);
+
+  // Allocate the remaining aligned regions.
+  size_t aligned_count = 1;
+  for (;;) {
+    Address address = ra.AllocateAlignedRegion(kPageSize, kAlignment);
+    if (address == RegionAllocator::kAllocationFailure) break;
+    CHECK(IsAligned(address, kAlignment));
+    aligned_count++;
+  }
+  CHECK_EQ(aligned_count, kPageCount * kPageSize / kAlignment);
+
+  // Unaligned pages can still be allocated.
+  CHECK_NE(ra.AllocateRegion(kPageSize), RegionAllocator::kAllocationFailure);
+
+  // A region that is bigger than any free region cannot be allocated.
+  CHECK_EQ(ra.AllocateAlignedRegion(kAlignment, kAlignment),
+           RegionAllocator::kAllocationFailure);
+}
+
 TEST(RegionAllocatorTest, AllocateBigRegions) {
   const size_t kPageSize = 4 * KB;
   const size_t kPageCountLog = 10;
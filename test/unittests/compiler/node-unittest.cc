@@ -257,6 +257,33 @@ TEST_F(NodeTest, BigNodes) {
   }
 }
 
+
+TEST_F(NodeTest, AppendInputToBigFixedNode) {
+  static const int kSize = 20;
+  Node* inputs[kSize];
+
+  Node* n0 = Node::New(zone(), 0, &kOp0, 0, nullptr, false);
+  Node* n1 = Node::New(zone(), 1, &kOp1, 1, &n0, false);
+  for (int i = 0; i < kSize; i++) {
+    inputs[i] = i & 1 ? n0 : n1;
+  }
+
+  Node* node = Node::New(zone(), 12345, &kOp0, kSize, inputs, false);
+  EXPECT_THAT(node->inputs(), ElementsAreArray(inputs, kSize));
+
+  node->AppendInput(zone(), n1);
+  EXPECT_EQ(kSize + 1, node->InputCount());
+  EXPECT_EQ(n1, node->InputAt(kSize));
+  node->InsertInput(zone(), 0, n0);
+  EXPECT_EQ(kSize + 2, node->InputCount());
+  EXPECT_EQ(n0, node->InputAt(0));
+  EXPECT_EQ(n1, node->InputAt(kSize + 1));
+  for (Edge edge : node->input_edges()) {
+    EXPECT_EQ(node, edge.from());
+  }
+  EXPECT_EQ(kSize / 2 + 1, n0->UseCount() - 1);
+}
+
 }  // namespace node_unittest
 }  // namespace compiler
 }  // namespace internal
@@ -4,6 +4,7 @@
 
 #include "src/codegen/assembler-inl.h"
 #include "src/compiler/pipeline.h"
+#include "test/common/wasm/flag-utils.h"
 #include "test/unittests/compiler/backend/instruction-sequence-unittest.h"
 
 namespace v8 {
@@ -76,9 +77,10 @@ bool IsParallelMovePresent(int instr_index, Instruction::GapPosition gap_pos,
 
 class RegisterAllocatorTest : public InstructionSequenceTest {
  public:
-  void Allocate() {
+  void Allocate(bool* fp_allocated_on_worker = nullptr) {
     WireBlocks();
-    Pipeline::AllocateRegistersForTesting(config(), sequence(), true);
+    Pipeline::AllocateRegistersForTesting(config(), sequence(), true,
+                                          fp_allocated_on_worker);
   }
 };
 
@@ -107,6 +109,33 @@ TEST_F(RegisterAllocatorTest, CanAllocateFPRegisters) {
   Allocate();
 }
 
+TEST_F(RegisterAllocatorTest, CanAllocateGeneralAndFPRegistersInParallel) {
+  FlagScope<bool> parallel(&FLAG_turbo_parallel_register_allocation, true);
+  FlagScope<int> min_instructions(
+      &FLAG_turbo_parallel_register_allocation_min_instructions, 0);
+  FlagScope<bool> stress(&FLAG_stress_parallel_register_allocation, true);
+
+  // Keep more values of either kind alive than there are registers, so that
+  // both allocators have to split and spill.
+  const int kNumValues = 2 * Register::kNumRegisters;
+  StartBlock();
+  VReg values[kNumValues];
+  VReg fp_values[kNumValues];
+  for (int i = 0; i < kNumValues; ++i) {
+    values[i] = Parameter();
+    fp_values[i] = FPParameter(kFloat64);
+  }
+  for (int i = kNumValues - 1; i >= 0; --i) {
+    EmitI(Reg(values[i]), Reg(fp_values[i]));
+  }
+  Return(values[0]);
+  EndBlock(Last());
+
+  bool fp_allocated_on_worker = false;
+  Allocate(&fp_allocated_on_worker);
+  EXPECT_TRUE(fp_allocated_on_worker);
+}
+
 TEST_F(RegisterAllocatorTest, SimpleLoop) {
   // i = K;
   // while(true) { i++ }
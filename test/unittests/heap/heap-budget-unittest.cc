@@ -0,0 +1,55 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/heap-budget.h"
+
+#include "src/execution/isolate.h"
+#include "src/heap/heap.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+using HeapBudgetTest = TestWithIsolate;
+
+TEST_F(HeapBudgetTest, ReportsUsagePerIsolate) {
+  Heap* heap = i_isolate()->heap();
+  v8::Isolate* v8_isolate = reinterpret_cast<v8::Isolate*>(i_isolate());
+  HeapBudget budget(100 * MB);
+  budget.AddHeap(heap);
+
+  budget.ReportUsage(heap, 40 * MB, 10 * MB);
+  EXPECT_EQ(40 * MB, budget.used_bytes());
+  EXPECT_EQ(40 * MB, budget.used_bytes(v8_isolate));
+
+  // Reporting replaces the previous usage of the heap.
+  budget.ReportUsage(heap, 30 * MB, 0);
+  EXPECT_EQ(30 * MB, budget.used_bytes());
+  EXPECT_EQ(30 * MB, budget.used_bytes(v8_isolate));
+  EXPECT_FALSE(heap->HighMemoryPressure());
+
+  budget.RemoveHeap(heap);
+  EXPECT_EQ(0u, budget.used_bytes());
+}
+
+TEST_F(HeapBudgetTest, RequestsGCNearBudget) {
+  Heap* heap = i_isolate()->heap();
+  HeapBudget budget(100 * MB);
+  budget.AddHeap(heap);
+
+  // Nothing is reclaimable, so no GC is requested.
+  budget.ReportUsage(heap, 95 * MB, 0);
+  EXPECT_FALSE(heap->HighMemoryPressure());
+
+  budget.ReportUsage(heap, 95 * MB, 20 * MB);
+  EXPECT_TRUE(heap->HighMemoryPressure());
+
+  // Reset the pending request without triggering a GC.
+  heap->MemoryPressureNotification(MemoryPressureLevel::kNone, true);
+  budget.RemoveHeap(heap);
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -108,5 +108,68 @@ TEST_F(MemoryControllerTest, OldGenerationAllocationLimit) {
           new_space_capacity, factor, Heap::HeapGrowingMode::kMinimal));
 }
 
+TEST_F(MemoryControllerTest, AdaptiveLimitSharesRemainingMemory) {
+  AdaptiveHeapController controller;
+  const size_t kStep = 2 * MB;
+
+  // Without registered heaps the limit is not bounded.
+  EXPECT_EQ(512 * MB,
+            controller.BoundAllocationLimit(64 * MB, 512 * MB, kStep));
+
+  controller.AddHeap(256 * MB);
+  controller.AddHeap(512 * MB);
+  EXPECT_EQ(256 * MB, controller.memory_cap());
+
+  controller.ReportSize(0, 64 * MB);
+  controller.ReportSize(0, 96 * MB);
+  EXPECT_EQ(160 * MB, controller.total_size());
+
+  // 96 MB are left under the cap, so each heap may grow by 48 MB.
+  EXPECT_EQ(112 * MB,
+            controller.BoundAllocationLimit(64 * MB, 512 * MB, kStep));
+  EXPECT_EQ(100 * MB,
+            controller.BoundAllocationLimit(64 * MB, 100 * MB, kStep));
+
+  // At the cap, heaps still grow by the minimum step.
+  controller.ReportSize(96 * MB, 192 * MB);
+  EXPECT_EQ(66 * MB,
+            controller.BoundAllocationLimit(64 * MB, 512 * MB, kStep));
+
+  controller.RemoveHeap(192 * MB);
+  controller.RemoveHeap(64 * MB);
+  EXPECT_EQ(0u, controller.total_size());
+  EXPECT_EQ(0u, controller.memory_cap());
+}
+
+TEST_F(MemoryControllerTest, PauseBoundedGrowingFactor) {
+  // 100 MB at 10 MB/ms take 10 ms, so a 20 ms budget allows a factor of 2.
+  CheckEqualRounded(2.0, AdaptiveHeapController::PauseBoundedGrowingFactor(
+                             4.0, 100 * MB, 10 * MB, 20));
+  // The factor is not increased if the budget is generous.
+  CheckEqualRounded(1.5, AdaptiveHeapController::PauseBoundedGrowingFactor(
+                             1.5, 100 * MB, 10 * MB, 20));
+  // The factor does not drop below the minimum.
+  CheckEqualRounded(V8HeapTrait::kMinGrowingFactor,
+                    AdaptiveHeapController::PauseBoundedGrowingFactor(
+                        4.0, 100 * MB, 10 * MB, 5));
+  // Without a budget or measurements the factor is unchanged.
+  CheckEqualRounded(4.0, AdaptiveHeapController::PauseBoundedGrowingFactor(
+                             4.0, 100 * MB, 10 * MB, 0));
+  CheckEqualRounded(4.0, AdaptiveHeapController::PauseBoundedGrowingFactor(
+                             4.0, 100 * MB, 0, 20));
+}
+
+TEST_F(MemoryControllerTest, NewSpaceGrowingFactor) {
+  // 1 MB survived at 1 MB/ms, so the last scavenge took about 1 ms.
+  CheckEqualRounded(2.0, AdaptiveHeapController::NewSpaceGrowingFactor(
+                             2.0, 1 * MB, 1 * MB, 4));
+  CheckEqualRounded(1.5, AdaptiveHeapController::NewSpaceGrowingFactor(
+                             2.0, 1 * MB, 1 * MB, 1.5));
+  CheckEqualRounded(1.0, AdaptiveHeapController::NewSpaceGrowingFactor(
+                             2.0, 1 * MB, 1 * MB, 0.5));
+  CheckEqualRounded(2.0, AdaptiveHeapController::NewSpaceGrowingFactor(
+                             2.0, 1 * MB, 1 * MB, 0));
+}
+
 }  // namespace internal
 }  // namespace v8
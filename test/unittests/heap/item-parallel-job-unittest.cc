@@ -4,7 +4,10 @@
 
 #include "src/heap/item-parallel-job.h"
 
+#include <vector>
+
 #include "src/execution/isolate.h"
+#include "src/flags/flags.h"
 #include "test/unittests/test-utils.h"
 
 namespace v8 {
@@ -301,5 +304,61 @@ TEST_F(ItemParallelJobTest, DifferentItems) {
   EXPECT_TRUE(item_b);
 }
 
+namespace {
+
+// Records the NUMA node tags of the items in processing order.
+class NumaRecordingTask : public ItemParallelJob::Task {
+ public:
+  NumaRecordingTask(Isolate* isolate, std::vector<int>* processed_nodes)
+      : ItemParallelJob::Task(isolate), processed_nodes_(processed_nodes) {}
+
+  void RunInParallel(Runner runner) override {
+    ItemParallelJob::Item* item = nullptr;
+    while ((item = GetItem<ItemParallelJob::Item>()) != nullptr) {
+      processed_nodes_->push_back(item->numa_node());
+      item->MarkFinished();
+    }
+  }
+
+ private:
+  std::vector<int>* processed_nodes_;
+};
+
+}  // namespace
+
+TEST_F(ItemParallelJobTest, NumaLocalItemsFirst) {
+  const bool saved_numa_aware_heap = FLAG_numa_aware_heap;
+  FLAG_numa_aware_heap = true;
+  const int current_node = base::OS::GetCurrentNumaNode();
+  const int other_node = current_node + 1;
+  const int kItems = 30;
+  std::vector<int> processed_nodes;
+  ItemParallelJob job(i_isolate()->cancelable_task_manager(),
+                      parallel_job_semaphore());
+  job.AddTask(new NumaRecordingTask(i_isolate(), &processed_nodes));
+  int local_items = 0;
+  for (int i = 0; i < kItems; i++) {
+    ItemParallelJob::Item* item = new SimpleItem();
+    if (i % 3 == 0) {
+      item->set_numa_node(current_node);
+      local_items++;
+    } else if (i % 3 == 1) {
+      item->set_numa_node(other_node);
+    }
+    job.AddItem(item);
+  }
+  job.Run();
+  FLAG_numa_aware_heap = saved_numa_aware_heap;
+  ASSERT_EQ(static_cast<size_t>(kItems), processed_nodes.size());
+  if (current_node == base::OS::kNoNumaNode) return;
+  // Items on the task's own node are processed before all other items.
+  for (int i = 0; i < local_items; i++) {
+    EXPECT_EQ(current_node, processed_nodes[i]);
+  }
+  for (int i = local_items; i < kItems; i++) {
+    EXPECT_NE(current_node, processed_nodes[i]);
+  }
+}
+
 }  // namespace internal
 }  // namespace v8
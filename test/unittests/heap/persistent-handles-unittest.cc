@@ -0,0 +1,162 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/handles/persistent-handles.h"
+
+#include <atomic>
+#include <memory>
+
+#include "src/base/platform/platform.h"
+#include "src/base/platform/semaphore.h"
+#include "src/heap/factory.h"
+#include "src/heap/heap.h"
+#include "src/heap/local-heap.h"
+#include "src/heap/safepoint.h"
+#include "src/objects/fixed-array-inl.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+using PersistentHandlesTest = TestWithIsolate;
+
+TEST_F(PersistentHandlesTest, NumberOfHandles) {
+  PersistentHandles persistent_handles(i_isolate());
+  CHECK_EQ(0, persistent_handles.NumberOfHandles());
+
+  const int kHandles = 1000;
+  for (int i = 0; i < kHandles; i++) {
+    Handle<Smi> handle = persistent_handles.NewHandle(Smi::FromInt(i));
+    CHECK_EQ(i, handle->value());
+  }
+  CHECK_EQ(kHandles, persistent_handles.NumberOfHandles());
+}
+
+TEST_F(PersistentHandlesTest, HandlesAreUpdatedByGC) {
+  const int kLength = 10;
+  PersistentHandles persistent_handles(i_isolate());
+  Handle<FixedArray> persistent;
+  {
+    HandleScope scope(i_isolate());
+    Handle<FixedArray> array = i_isolate()->factory()->NewFixedArray(kLength);
+    CHECK(Heap::InYoungGeneration(*array));
+    persistent = persistent_handles.NewHandle(*array);
+  }
+
+  // The array is only reachable through the persistent handle, so it has to
+  // survive the scavenges and the handle has to follow it.
+  Heap* heap = i_isolate()->heap();
+  heap->CollectGarbage(NEW_SPACE, GarbageCollectionReason::kTesting);
+  heap->CollectGarbage(NEW_SPACE, GarbageCollectionReason::kTesting);
+  CHECK(!Heap::InYoungGeneration(*persistent));
+  CHECK_EQ(kLength, persistent->length());
+
+  heap->CollectAllGarbage(Heap::kNoGCFlags, GarbageCollectionReason::kTesting);
+  CHECK_EQ(kLength, persistent->length());
+}
+
+TEST_F(PersistentHandlesTest, RemovedFromIsolateOnDestruction) {
+  {
+    PersistentHandles persistent_handles(i_isolate());
+    persistent_handles.NewHandle(ReadOnlyRoots(i_isolate()).undefined_value());
+  }
+  // Iterating the roots must not visit the destroyed container.
+  i_isolate()->heap()->CollectAllGarbage(Heap::kNoGCFlags,
+                                         GarbageCollectionReason::kTesting);
+}
+
+namespace {
+
+const int kArrayLength = 10;
+
+class PersistentHandlesThread final : public v8::base::Thread {
+ public:
+  PersistentHandlesThread(Heap* heap, PersistentHandles* persistent_handles,
+                          Handle<FixedArray> array,
+                          base::Semaphore* sema_started,
+                          std::atomic<bool>* gc_done)
+      : v8::base::Thread(base::Thread::Options("ThreadWithLocalHeap")),
+        heap_(heap),
+        persistent_handles_(persistent_handles),
+        array_(array),
+        sema_started_(sema_started),
+        gc_done_(gc_done) {}
+
+  void Run() override {
+    LocalHeap local_heap(heap_);
+    persistent_ = persistent_handles_->NewHandle(*array_);
+    sema_started_->Signal();
+
+    // Keep the LocalHeap running, so that the main thread has to stop this
+    // thread in a safepoint for each of its garbage collections.
+    while (!gc_done_->load()) local_heap.Safepoint();
+
+    CHECK(!Heap::InYoungGeneration(*persistent_));
+    CHECK_EQ(kArrayLength, persistent_->length());
+  }
+
+  Handle<FixedArray> persistent() const { return persistent_; }
+
+ private:
+  Heap* heap_;
+  PersistentHandles* persistent_handles_;
+  Handle<FixedArray> array_;
+  Handle<FixedArray> persistent_;
+  base::Semaphore* sema_started_;
+  std::atomic<bool>* gc_done_;
+};
+
+}  // namespace
+
+class PersistentHandlesWithLocalHeapsTest : public TestWithIsolate {
+ public:
+  PersistentHandlesWithLocalHeapsTest()
+      : saved_local_heaps_(FLAG_local_heaps) {
+    FLAG_local_heaps = true;
+  }
+  ~PersistentHandlesWithLocalHeapsTest() override {
+    FLAG_local_heaps = saved_local_heaps_;
+  }
+
+ private:
+  bool saved_local_heaps_;
+};
+
+TEST_F(PersistentHandlesWithLocalHeapsTest, HandlesAreUpdatedByGC) {
+  Heap* heap = i_isolate()->heap();
+  PersistentHandles persistent_handles(i_isolate());
+  base::Semaphore sema_started(0);
+  std::atomic<bool> gc_done(false);
+  std::unique_ptr<PersistentHandlesThread> thread;
+
+  {
+    HandleScope scope(i_isolate());
+    Handle<FixedArray> array =
+        i_isolate()->factory()->NewFixedArray(kArrayLength);
+    CHECK(Heap::InYoungGeneration(*array));
+    thread.reset(new PersistentHandlesThread(heap, &persistent_handles, array,
+                                             &sema_started, &gc_done));
+    CHECK(thread->Start());
+    sema_started.Wait();
+  }
+
+  // The array is now only reachable through the handle that the background
+  // thread created. Every GC enters a safepoint, which is the only time the
+  // persistent handles are visited while local heaps are enabled.
+  heap->CollectGarbage(NEW_SPACE, GarbageCollectionReason::kTesting);
+  heap->CollectGarbage(NEW_SPACE, GarbageCollectionReason::kTesting);
+  heap->CollectAllGarbage(Heap::kNoGCFlags, GarbageCollectionReason::kTesting);
+  CHECK(!heap->safepoint()->IsActive());
+
+  gc_done.store(true);
+  thread->Join();
+
+  Handle<FixedArray> persistent = thread->persistent();
+  CHECK(!Heap::InYoungGeneration(*persistent));
+  CHECK_EQ(kArrayLength, persistent->length());
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,229 @@
+// Copyright 2019 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/safepoint.h"
+
+#include <atomic>
+#include <vector>
+
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
+#include "src/heap/heap.h"
+#include "src/heap/local-heap.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+class SafepointTest : public TestWithIsolate {
+ public:
+  SafepointTest() : saved_local_heaps_(FLAG_local_heaps) {
+    FLAG_local_heaps = true;
+  }
+  ~SafepointTest() override { FLAG_local_heaps = saved_local_heaps_; }
+
+ private:
+  bool saved_local_heaps_;
+};
+
+TEST_F(SafepointTest, ReachSafepointWithoutLocalHeaps) {
+  Heap* heap = i_isolate()->heap();
+  bool run = false;
+  {
+    SafepointScope scope(heap);
+    run = true;
+  }
+  CHECK(run);
+}
+
+TEST_F(SafepointTest, NestedSafepointScopes) {
+  Heap* heap = i_isolate()->heap();
+  {
+    SafepointScope outer(heap);
+    CHECK(heap->safepoint()->IsActive());
+    {
+      SafepointScope inner(heap);
+      CHECK(heap->safepoint()->IsActive());
+    }
+    CHECK(heap->safepoint()->IsActive());
+  }
+  CHECK(!heap->safepoint()->IsActive());
+}
+
+namespace {
+
+class ParkedThread final : public v8::base::Thread {
+ public:
+  ParkedThread(Heap* heap, base::Mutex* mutex)
+      : v8::base::Thread(base::Thread::Options("ThreadWithLocalHeap")),
+        heap_(heap),
+        mutex_(mutex) {}
+
+  void Run() override {
+    LocalHeap local_heap(heap_);
+
+    if (mutex_) {
+      ParkedScope scope(&local_heap);
+      base::MutexGuard guard(mutex_);
+    }
+  }
+
+  Heap* heap_;
+  base::Mutex* mutex_;
+};
+
+}  // namespace
+
+TEST_F(SafepointTest, StopParkedThreads) {
+  Heap* heap = i_isolate()->heap();
+
+  int safepoints = 0;
+
+  const int kThreads = 10;
+  const int kRuns = 5;
+
+  for (int run = 0; run < kRuns; run++) {
+    base::Mutex mutex;
+    std::vector<ParkedThread*> threads;
+
+    mutex.Lock();
+
+    for (int i = 0; i < kThreads; i++) {
+      ParkedThread* thread =
+          new ParkedThread(heap, i % 2 == 0 ? &mutex : nullptr);
+      CHECK(thread->Start());
+      threads.push_back(thread);
+    }
+
+    {
+      SafepointScope scope(heap);
+      safepoints++;
+    }
+    mutex.Unlock();
+
+    for (ParkedThread* thread : threads) {
+      thread->Join();
+      delete thread;
+    }
+  }
+
+  CHECK_EQ(safepoints, kRuns);
+}
+
+namespace {
+
+const int kIterations = 10000;
+
+class RunningThread final : public v8::base::Thread {
+ public:
+  RunningThread(Heap* heap, std::atomic<int>* counter)
+      : v8::base::Thread(base::Thread::Options("ThreadWithLocalHeap")),
+        heap_(heap),
+        counter_(counter) {}
+
+  void Run() override {
+    LocalHeap local_heap(heap_);
+
+    for (int i = 0; i < kIterations; i++) {
+      counter_->fetch_add(1);
+      if (i % 100 == 0) local_heap.Safepoint();
+    }
+  }
+
+  Heap* heap_;
+  std::atomic<int>* counter_;
+};
+
+}  // namespace
+
+TEST_F(SafepointTest, StopRunningThreads) {
+  Heap* heap = i_isolate()->heap();
+
+  const int kThreads = 10;
+  const int kRuns = 5;
+  const int kSafepoints = 3;
+  int safepoint_count = 0;
+
+  for (int run = 0; run < kRuns; run++) {
+    std::atomic<int> counter(0);
+    std::vector<RunningThread*> threads;
+
+    for (int i = 0; i < kThreads; i++) {
+      RunningThread* thread = new RunningThread(heap, &counter);
+      CHECK(thread->Start());
+      threads.push_back(thread);
+    }
+
+    for (int i = 0; i < kSafepoints; i++) {
+      SafepointScope scope(heap);
+      safepoint_count++;
+    }
+
+    for (RunningThread* thread : threads) {
+      thread->Join();
+      delete thread;
+    }
+  }
+
+  CHECK_EQ(safepoint_count, kRuns * kSafepoints);
+}
+
+namespace {
+
+class AllocatingThread final : public v8::base::Thread {
+ public:
+  static const int kObjectSize = 10 * kTaggedSize;
+  static const int kNumIterations = 2000;
+
+  explicit AllocatingThread(Heap* heap)
+      : v8::base::Thread(base::Thread::Options("ThreadWithLocalHeap")),
+        heap_(heap) {}
+
+  void Run() override {
+    LocalHeap local_heap(heap_);
+
+    for (int i = 0; i < kNumIterations; i++) {
+      AllocationResult result = local_heap.AllocateRaw(kObjectSize);
+      // Stop when the old generation limit is reached, the main thread is
+      // responsible for collecting garbage.
+      if (result.IsRetry()) break;
+      Address address = result.ToObjectChecked().address();
+      heap_->CreateFillerObjectAt(address, kObjectSize,
+                                  ClearRecordedSlots::kNo);
+    }
+  }
+
+  Heap* heap_;
+};
+
+}  // namespace
+
+TEST_F(SafepointTest, ConcurrentAllocationInOldSpace) {
+  Heap* heap = i_isolate()->heap();
+
+  const int kThreads = 4;
+  std::vector<AllocatingThread*> threads;
+
+  for (int i = 0; i < kThreads; i++) {
+    AllocatingThread* thread = new AllocatingThread(heap);
+    CHECK(thread->Start());
+    threads.push_back(thread);
+  }
+
+  // Garbage collections stop the allocating threads in a safepoint and
+  // retire their linear allocation areas.
+  heap->CollectAllGarbage(Heap::kNoGCFlags, GarbageCollectionReason::kTesting);
+  heap->CollectGarbage(NEW_SPACE, GarbageCollectionReason::kTesting);
+
+  for (AllocatingThread* thread : threads) {
+    thread->Join();
+    delete thread;
+  }
+
+  heap->CollectAllGarbage(Heap::kNoGCFlags, GarbageCollectionReason::kTesting);
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,241 @@
+#!/usr/bin/env python
+#
+# Copyright 2019 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+#
+# Converts a heap snapshot written in the binary format (see
+# v8::HeapSnapshot::Serialize with v8::HeapSnapshot::kBinary) into the JSON
+# format understood by DevTools. The output is identical to what V8 writes
+# when serializing the same snapshot to JSON directly.
+#
+# Usage: heap-snapshot-to-json.py <binary-snapshot> [<json-output>]
+#
+
+
+# for py2/py3 compatibility
+from __future__ import print_function
+
+import sys
+
+
+MAGIC = b'V8HS'
+VERSION = 1
+
+NODE_FIELDS_COUNT = 6
+
+META = (
+    '{"node_fields":["type","name","id","self_size","edge_count",'
+    '"trace_node_id"],'
+    '"node_types":[["hidden","array","string","object","code","closure",'
+    '"regexp","number","native","synthetic","concatenated string",'
+    '"sliced string","symbol","bigint"],'
+    '"string","number","number","number","number","number"],'
+    '"edge_fields":["type","name_or_index","to_node"],'
+    '"edge_types":[["context","element","property","internal","hidden",'
+    '"shortcut","weak"],"string_or_number","node"],'
+    '"trace_function_info_fields":["function_id","name","script_name",'
+    '"script_id","line","column"],'
+    '"trace_node_fields":["id","function_info_index","count","size",'
+    '"children"],'
+    '"sample_fields":["timestamp_us","last_assigned_id"],'
+    '"location_fields":["object_index","script_id","line","column"]}')
+
+
+class Reader(object):
+  def __init__(self, stream):
+    self.stream = stream
+    self.buffer = bytearray()
+    self.pos = 0
+
+  def _fill(self, size):
+    if len(self.buffer) - self.pos >= size:
+      return
+    chunk = self.stream.read(max(size, 1 << 20))
+    self.buffer = self.buffer[self.pos:] + bytearray(chunk)
+    self.pos = 0
+    if len(self.buffer) < size:
+      raise ValueError('Unexpected end of snapshot')
+
+  def read_bytes(self, size):
+    self._fill(size)
+    result = self.buffer[self.pos:self.pos + size]
+    self.pos += size
+    return result
+
+  def read_varint(self):
+    result = 0
+    shift = 0
+    while True:
+      self._fill(1)
+      byte = self.buffer[self.pos]
+      self.pos += 1
+      result |= (byte & 0x7F) << shift
+      if not byte & 0x80:
+        return result
+      shift += 7
+
+
+# Valid ranges of the second byte of a UTF-8 sequence, keyed by the lead
+# byte. Like V8's UTF-8 decoder, this rejects overlong encodings, surrogates
+# and code points above U+10FFFF. Python's own decoder cannot be used, as
+# Python 2 accepts encoded surrogates.
+def second_byte_range(lead):
+  if lead == 0xE0:
+    return (0xA0, 0xBF)
+  if lead == 0xED:
+    return (0x80, 0x9F)
+  if lead == 0xF0:
+    return (0x90, 0xBF)
+  if lead == 0xF4:
+    return (0x80, 0x8F)
+  return (0x80, 0xBF)
+
+
+def decode_utf8(data, i):
+  # Returns the code point and size of the UTF-8 sequence at data[i], or
+  # None if the sequence is invalid or truncated.
+  lead = data[i]
+  if 0xC2 <= lead <= 0xDF:
+    size, code_point = 2, lead & 0x1F
+  elif 0xE0 <= lead <= 0xEF:
+    size, code_point = 3, lead & 0x0F
+  elif 0xF0 <= lead <= 0xF4:
+    size, code_point = 4, lead & 0x07
+  else:
+    return None
+  if i + size > len(data):
+    return None
+  low, high = second_byte_range(lead)
+  for k in range(1, size):
+    byte = data[i + k]
+    if k == 1 and not low <= byte <= high:
+      return None
+    if not 0x80 <= byte <= 0xBF:
+      return None
+    code_point = (code_point << 6) | (byte & 0x3F)
+  return code_point, size
+
+
+def escape_string(data):
+  # Mirrors HeapSnapshotJSONSerializer::SerializeString.
+  out = []
+  i = 0
+  length = len(data)
+  while i < length:
+    c = data[i]
+    if c == 0x08:
+      out.append('\\b')
+    elif c == 0x0C:
+      out.append('\\f')
+    elif c == 0x0A:
+      out.append('\\n')
+    elif c == 0x0D:
+      out.append('\\r')
+    elif c == 0x09:
+      out.append('\\t')
+    elif c == 0x22 or c == 0x5C:
+      out.append('\\' + chr(c))
+    elif 31 < c < 128:
+      out.append(chr(c))
+    elif c <= 31:
+      out.append('\\u%04X' % c)
+    else:
+      decoded = decode_utf8(data, i)
+      # V8 reports invalid sequences as U+FFFD, so an encoded U+FFFD is
+      # written as '?' as well and the following bytes are escaped
+      # separately.
+      if decoded is None or decoded[0] == 0xFFFD:
+        out.append('?')
+      else:
+        code_point, size = decoded
+        # V8 only writes the lower 16 bits of the code point.
+        out.append('\\u%04X' % (code_point & 0xFFFF))
+        i += size - 1
+    i += 1
+  return ''.join(out)
+
+
+def convert_trace_node(reader, out):
+  node_id = reader.read_varint()
+  function_info_index = reader.read_varint()
+  count = reader.read_varint()
+  size = reader.read_varint()
+  children = reader.read_varint()
+  out.write('%d,%d,%d,%d,[' % (node_id, function_info_index, count, size))
+  for i in range(children):
+    if i > 0:
+      out.write(',')
+    convert_trace_node(reader, out)
+  out.write(']')
+
+
+def convert(reader, out):
+  if bytes(reader.read_bytes(len(MAGIC))) != MAGIC:
+    raise ValueError('Not a binary heap snapshot')
+  version = reader.read_varint()
+  if version != VERSION:
+    raise ValueError('Unsupported binary heap snapshot version %d' % version)
+  node_count = reader.read_varint()
+  edge_count = reader.read_varint()
+  trace_function_count = reader.read_varint()
+
+  out.write('{"snapshot":{"meta":')
+  out.write(META)
+  out.write(',"node_count":%d,"edge_count":%d,"trace_function_count":%d' %
+            (node_count, edge_count, trace_function_count))
+  out.write('},\n"nodes":[')
+  for i in range(node_count):
+    fields = tuple(reader.read_varint() for _ in range(NODE_FIELDS_COUNT))
+    out.write('%s%d,%d,%d,%d,%d,%d\n' % (((',' if i else ''),) + fields))
+  out.write('],\n"edges":[')
+  for i in range(edge_count):
+    edge_type = reader.read_varint()
+    name_or_index = reader.read_varint()
+    to_node = reader.read_varint() * NODE_FIELDS_COUNT
+    out.write('%s%d,%d,%d\n' % ((',' if i else ''), edge_type,
+                                name_or_index, to_node))
+  out.write('],\n"trace_function_infos":[')
+  for i in range(trace_function_count):
+    fields = tuple(reader.read_varint() for _ in range(6))
+    out.write('%s%d,%d,%d,%d,%d,%d\n' % (((',' if i else ''),) + fields))
+  out.write('],\n"trace_tree":[')
+  if reader.read_varint():
+    convert_trace_node(reader, out)
+  out.write('],\n"samples":[')
+  for i in range(reader.read_varint()):
+    timestamp = reader.read_varint()
+    last_assigned_id = reader.read_varint()
+    out.write('%s%d,%d\n' % ((',' if i else ''), timestamp, last_assigned_id))
+  out.write('],\n"locations":[')
+  for i in range(reader.read_varint()):
+    node_index = reader.read_varint() * NODE_FIELDS_COUNT
+    script_id = reader.read_varint()
+    line = reader.read_varint()
+    column = reader.read_varint()
+    out.write('%s%d,%d,%d,%d\n' % ((',' if i else ''), node_index, script_id,
+                                   line, column))
+  out.write('],\n"strings":["<dummy>"')
+  for _ in range(reader.read_varint()):
+    length = reader.read_varint()
+    out.write(',\n"%s"' % escape_string(reader.read_bytes(length)))
+  out.write(']}')
+
+
+def main(argv):
+  if len(argv) not in (2, 3):
+    print('Usage: %s <binary-snapshot> [<json-output>]' % argv[0],
+          file=sys.stderr)
+    return 1
+  with open(argv[1], 'rb') as f:
+    if len(argv) == 3:
+      with open(argv[2], 'w') as out:
+        convert(Reader(f), out)
+    else:
+      convert(Reader(f), sys.stdout)
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main(sys.argv))
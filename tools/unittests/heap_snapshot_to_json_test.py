@@ -0,0 +1,85 @@
+#!/usr/bin/env python
+# Copyright 2019 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+import imp
+import io
+import os
+import unittest
+
+TOOLS_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+heap_snapshot_to_json = imp.load_source(
+    'heap_snapshot_to_json',
+    os.path.join(TOOLS_DIR, 'heap-snapshot-to-json.py'))
+
+# Strings as stored in the binary format and their JSON literals as written
+# by HeapSnapshotJSONSerializer. The first entry is also checked against V8 in
+# the HeapSnapshotSerializationStringEscaping cctest.
+STRINGS = [
+  (b'ctl\x01\x1f\x7f \xc3\xa9 \xe0\xa0\x80 \xf0\x9f\x98\x80 \xef\xbf\xbd',
+   'ctl\\u0001\\u001F\x7f \\u00E9 \\u0800 \\uF600 ???'),
+  (b'\x08\x0c\n\r\t"\\', '\\b\\f\\n\\r\\t\\"\\\\'),
+  # Encoded surrogates, as written for lone surrogates in JS strings.
+  (b'\xed\xa0\x80', '???'),
+  # Overlong encoding.
+  (b'\xc0\x80', '??'),
+  # Truncated sequence.
+  (b'a\xe2\x82', 'a??'),
+  # Invalid continuation byte.
+  (b'a\xc3b', 'a?b'),
+  # Code point above U+10FFFF.
+  (b'\xf4\x90\x80\x80', '????'),
+  (b'\xff', '?'),
+  (b'\xf4\x8f\xbf\xbf', '\\uFFFF'),
+]
+
+
+def varint(value):
+  result = bytearray()
+  while True:
+    byte = value & 0x7F
+    value >>= 7
+    if value:
+      result.append(byte | 0x80)
+    else:
+      result.append(byte)
+      return bytes(result)
+
+
+def binary_snapshot(strings):
+  # One synthetic root node, no edges, no allocation tracking, samples or
+  # locations.
+  data = heap_snapshot_to_json.MAGIC
+  data += varint(heap_snapshot_to_json.VERSION)
+  data += varint(1) + varint(0) + varint(0)
+  data += varint(9) + varint(1) + varint(1) + varint(0) + varint(0)
+  data += varint(0)
+  data += varint(0) + varint(0) + varint(0)
+  data += varint(len(strings))
+  for string in strings:
+    data += varint(len(string)) + string
+  return data
+
+
+class HeapSnapshotToJsonTest(unittest.TestCase):
+  def testEscapeString(self):
+    for raw, literal in STRINGS:
+      self.assertEqual(
+          literal, heap_snapshot_to_json.escape_string(bytearray(raw)))
+
+  def testConvert(self):
+    reader = heap_snapshot_to_json.Reader(
+        io.BytesIO(binary_snapshot([raw for raw, _ in STRINGS])))
+    out = io.StringIO() if bytes is not str else io.BytesIO()
+    heap_snapshot_to_json.convert(reader, out)
+    json = out.getvalue()
+    expected_strings = ''.join(',\n"%s"' % literal for _, literal in STRINGS)
+    self.assertTrue(json.startswith('{"snapshot":{"meta":'))
+    self.assertTrue(json.endswith(
+        '"strings":["<dummy>"' + expected_strings + ']}'))
+
+
+if __name__ == '__main__':
+  unittest.main()